@@ -0,0 +1,137 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file BenchUtil.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Implementation file for the helpers of BenchUtil.h
+ *
+ */
+//</editor-fold>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "BenchUtil.h"
+
+namespace Bench {
+
+    namespace {
+        const char* const words[] = {
+                "alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel",
+                "india", "juliet", "kilo", "lima", "mike", "november", "oscar", "papa"
+        };
+
+        const size_t word_count = sizeof(words) / sizeof(words[0]);
+
+        const char* const needle = "needle";
+
+        /// Small linear congruential generator, so the inputs are the same on every run
+        struct Random {
+            uint64_t state;
+
+            Random() : state(0x2545F4914F6CDD1DULL) {}
+
+            uint32_t next() {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                return static_cast<uint32_t>(state >> 33);
+            }
+        };
+
+        Automata::NFA symbol(char c) {
+            Automata::NFA result("0");
+            result.addState("1", true);
+            result.addTransition("0", "1", c);
+            return result;
+        }
+
+    }
+
+    Automata::NFA literal(std::string const& s) {
+        Automata::NFA result = symbol(s[0]);
+        for (size_t i = 1; i < s.size(); i++)
+            result = result.concatenate(symbol(s[i]));
+        return result;
+    }
+
+    std::string pattern(Family family) {
+        switch (family)
+        {
+            case FAMILY_LITERAL:
+                return needle;
+            case FAMILY_ALTERNATION:
+            {
+                std::string result = "(";
+                for (size_t i = 0; i < word_count; i++)
+                    result += (i ? "|" : "") + std::string(words[i]);
+                return result + ")*";
+            }
+            case FAMILY_NESTED_STAR:
+                return "(a*)*b";
+            case FAMILY_PATHOLOGICAL:
+                return "(a|aa)*b";
+        }
+        throw std::invalid_argument("unknown family");
+    }
+
+    std::string input(Family family, size_t size) {
+        std::string result;
+        result.reserve(size + 16);
+        Random random;
+
+        switch (family)
+        {
+            case FAMILY_LITERAL:
+                while (result.size() + 6 < size)
+                    result += static_cast<char>('a' + random.next() % 26);
+                result += needle;
+                break;
+            case FAMILY_ALTERNATION:
+                while (result.size() < size)
+                    result += words[random.next() % word_count];
+                break;
+            case FAMILY_NESTED_STAR:
+            case FAMILY_PATHOLOGICAL:
+                result.assign(size > 1 ? size - 1 : 0, 'a');
+                result += 'b';
+                break;
+        }
+        return result;
+    }
+
+    Automata::NFA nfa(Family family) {
+        switch (family)
+        {
+            case FAMILY_ALTERNATION:
+            {
+                Automata::NFA result = literal(words[0]);
+                for (size_t i = 1; i < word_count; i++)
+                    result = result.alternate(literal(words[i]));
+                return result.kleene();
+            }
+            case FAMILY_PATHOLOGICAL:
+                return symbol('a').alternate(literal("aa")).kleene().concatenate(symbol('b'));
+            default:
+                throw std::invalid_argument("no NFA for this family");
+        }
+    }
+}
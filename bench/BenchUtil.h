@@ -0,0 +1,116 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file BenchUtil.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Helpers shared by the benchmarks of regex_bench
+ *
+ * # Description
+ * The pattern families which are benchmarked, the inputs each of them matches, and the counter of heap
+ * allocations which is reported as `allocs` by the benchmarks, per iteration.
+ *
+ * Inputs go from 16 bytes up to MYREGEX_BENCH_MAX_INPUT bytes (1 GB by default, see CMakeLists.txt).
+ */
+//</editor-fold>
+#ifndef MYREGEX_BENCHUTIL_H
+#define MYREGEX_BENCHUTIL_H
+
+#include <cstddef>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "src/Automata/NFA.h"
+
+#ifndef MYREGEX_BENCH_MAX_INPUT
+#define MYREGEX_BENCH_MAX_INPUT (1 << 30)
+#endif
+
+namespace Bench {
+
+    /// Size of the smallest input
+    const size_t min_input = 16;
+
+    /// Size of the largest input
+    const size_t max_input = static_cast<size_t>(MYREGEX_BENCH_MAX_INPUT);
+
+    /// Size of the largest input given to NFA::match, which matches a few KB per second
+    const size_t max_nfa_input = 1 << 12;
+
+    /// Families of patterns
+    enum Family {
+        /// A literal string searched in random text
+        FAMILY_LITERAL,
+
+        /// A star over a long alternation of words
+        FAMILY_ALTERNATION,
+
+        /// Stars nested in stars, `(a*)*b`
+        FAMILY_NESTED_STAR,
+
+        /// `(a|aa)*b`, which makes a backtracking engine take exponential time
+        FAMILY_PATHOLOGICAL
+    };
+
+    /// Returns the number of heap allocations made by the process so far
+    size_t allocation_count();
+
+    /// Returns the pattern of a family
+    std::string pattern(Family family);
+
+    /// Returns an input of about size bytes which the pattern of the family matches
+    /**
+     * For FAMILY_LITERAL the literal is only at the end of the input, which is lowercase random text.
+     */
+    std::string input(Family family, size_t size);
+
+    /// Returns the NFA of the pattern of a family, built with the NFA combinators
+    /**
+     * There is none for FAMILY_LITERAL, which is searched for rather than matched, nor for
+     * FAMILY_NESTED_STAR, whose epsilon cycles NFA::match doesn't support.
+     *
+     * @throws std::invalid_argument for these families
+     */
+    Automata::NFA nfa(Family family);
+
+    /// Returns the NFA which accepts only the string s, which must not be empty
+    Automata::NFA literal(std::string const& s);
+
+    /// Counts the allocations made between its construction and report()
+    class AllocationCounter {
+        size_t start_;
+
+    public:
+        AllocationCounter()
+                : start_(allocation_count())
+        {}
+
+        /// Reports the allocations as the `allocs` counter, averaged over the iterations
+        void report(benchmark::State& state) const {
+            state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocation_count() - start_),
+                                                          benchmark::Counter::kAvgIterations);
+        }
+    };
+}
+
+#endif //MYREGEX_BENCHUTIL_H
@@ -0,0 +1,151 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file CompileBench.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Benchmarks of the compilation of a pattern: lexing, parsing and the NFA combinators
+ *
+ */
+//</editor-fold>
+#include "BenchUtil.h"
+
+#include "src/Regex/Lexer.h"
+#include "src/Regex/Parser.h"
+#include "src/Regex/TokenDecls.h"
+
+namespace {
+
+    /// Returns a pattern of about size bytes, made of copies of a small pattern
+    std::string long_pattern(size_t size) {
+        std::string result;
+        while (result.size() < size)
+            result += "(ab|[c-e]\\d)*x";
+        return result;
+    }
+
+    void BM_Lexer(benchmark::State& state) {
+        std::string pattern = long_pattern(static_cast<size_t>(state.range(0)));
+        size_t tokens = 0;
+
+        Bench::AllocationCounter allocations;
+        for (auto _ : state)
+        {
+            Regex::Lexer lexer(pattern);
+            while (lexer.nextToken().tag() != Regex::TAG_EOF)
+                tokens++;
+        }
+        allocations.report(state);
+
+        benchmark::DoNotOptimize(tokens);
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * pattern.size()));
+    }
+    BENCHMARK(BM_Lexer)->RangeMultiplier(4)->Range(16, 16 << 10);
+
+    void BM_Parse(benchmark::State& state) {
+        std::string pattern = long_pattern(static_cast<size_t>(state.range(0)));
+        Regex::Parser parser;
+
+        Bench::AllocationCounter allocations;
+        for (auto _ : state)
+        {
+            parser.parse(pattern);
+            benchmark::DoNotOptimize(parser.getProgram());
+        }
+        allocations.report(state);
+
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * pattern.size()));
+    }
+    BENCHMARK(BM_Parse)->RangeMultiplier(4)->Range(16, 16 << 10);
+
+    template <Bench::Family family>
+    void BM_ParseFamily(benchmark::State& state) {
+        std::string pattern = Bench::pattern(family);
+        Regex::Parser parser;
+
+        Bench::AllocationCounter allocations;
+        for (auto _ : state)
+        {
+            parser.parse(pattern);
+            benchmark::DoNotOptimize(parser.getProgram());
+        }
+        allocations.report(state);
+    }
+    BENCHMARK_TEMPLATE(BM_ParseFamily, Bench::FAMILY_LITERAL);
+    BENCHMARK_TEMPLATE(BM_ParseFamily, Bench::FAMILY_ALTERNATION);
+    BENCHMARK_TEMPLATE(BM_ParseFamily, Bench::FAMILY_NESTED_STAR);
+    BENCHMARK_TEMPLATE(BM_ParseFamily, Bench::FAMILY_PATHOLOGICAL);
+
+    // The operands of the combinators are chains of range(0) symbols
+
+    void BM_NFAConcatenate(benchmark::State& state) {
+        Automata::NFA a = Bench::literal(std::string(static_cast<size_t>(state.range(0)), 'a'));
+        Automata::NFA b = Bench::literal(std::string(static_cast<size_t>(state.range(0)), 'b'));
+
+        Bench::AllocationCounter allocations;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(a.concatenate(b));
+        allocations.report(state);
+    }
+    BENCHMARK(BM_NFAConcatenate)->RangeMultiplier(4)->Range(4, 1 << 10);
+
+    void BM_NFAAlternate(benchmark::State& state) {
+        Automata::NFA a = Bench::literal(std::string(static_cast<size_t>(state.range(0)), 'a'));
+        Automata::NFA b = Bench::literal(std::string(static_cast<size_t>(state.range(0)), 'b'));
+
+        Bench::AllocationCounter allocations;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(a.alternate(b));
+        allocations.report(state);
+    }
+    BENCHMARK(BM_NFAAlternate)->RangeMultiplier(4)->Range(4, 1 << 10);
+
+    void BM_NFAKleene(benchmark::State& state) {
+        Automata::NFA a = Bench::literal(std::string(static_cast<size_t>(state.range(0)), 'a'));
+
+        Bench::AllocationCounter allocations;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(a.kleene());
+        allocations.report(state);
+    }
+    BENCHMARK(BM_NFAKleene)->RangeMultiplier(4)->Range(4, 1 << 10);
+
+    void BM_NFAKleenePlus(benchmark::State& state) {
+        Automata::NFA a = Bench::literal(std::string(static_cast<size_t>(state.range(0)), 'a'));
+
+        Bench::AllocationCounter allocations;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(a.kleene_plus());
+        allocations.report(state);
+    }
+    BENCHMARK(BM_NFAKleenePlus)->RangeMultiplier(4)->Range(4, 1 << 10);
+
+    void BM_NFAOptional(benchmark::State& state) {
+        Automata::NFA a = Bench::literal(std::string(static_cast<size_t>(state.range(0)), 'a'));
+
+        Bench::AllocationCounter allocations;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(a.optional());
+        allocations.report(state);
+    }
+    BENCHMARK(BM_NFAOptional)->RangeMultiplier(4)->Range(4, 1 << 10);
+}
@@ -0,0 +1,90 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file MatchBench.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Benchmarks of matching with each engine and with NFA::match
+ *
+ */
+//</editor-fold>
+#include "BenchUtil.h"
+
+#include "src/Regex/Regex.h"
+
+namespace {
+
+    template <Bench::Family family, Regex::Engine engine>
+    void BM_Match(benchmark::State& state) {
+        std::string text = Bench::input(family, static_cast<size_t>(state.range(0)));
+        Regex::Regex regex(Bench::pattern(family));
+        regex.setEngine(engine);
+
+        Regex::Match match;
+        Bench::AllocationCounter allocations;
+        for (auto _ : state)
+        {
+            if (family == Bench::FAMILY_LITERAL)
+                benchmark::DoNotOptimize(regex.search(text, match));
+            else
+                benchmark::DoNotOptimize(regex.match(text));
+        }
+        allocations.report(state);
+
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+    }
+
+    template <Bench::Family family>
+    void BM_MatchNFA(benchmark::State& state) {
+        std::string text = Bench::input(family, static_cast<size_t>(state.range(0)));
+        Automata::NFA nfa = Bench::nfa(family);
+
+        Bench::AllocationCounter allocations;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(nfa.match(text));
+        allocations.report(state);
+
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+    }
+
+#define MYREGEX_BENCH_ENGINES(family) \
+    BENCHMARK_TEMPLATE(BM_Match, family, Regex::ENGINE_LAZY_DFA) \
+            ->RangeMultiplier(16)->Range(Bench::min_input, Bench::max_input); \
+    BENCHMARK_TEMPLATE(BM_Match, family, Regex::ENGINE_DENSE_DFA) \
+            ->RangeMultiplier(16)->Range(Bench::min_input, Bench::max_input); \
+    BENCHMARK_TEMPLATE(BM_Match, family, Regex::ENGINE_PIKE_VM) \
+            ->RangeMultiplier(16)->Range(Bench::min_input, Bench::max_input); \
+    BENCHMARK_TEMPLATE(BM_Match, family, Regex::ENGINE_BIT_PARALLEL) \
+            ->RangeMultiplier(16)->Range(Bench::min_input, Bench::max_input)
+
+    MYREGEX_BENCH_ENGINES(Bench::FAMILY_LITERAL);
+    MYREGEX_BENCH_ENGINES(Bench::FAMILY_ALTERNATION);
+    MYREGEX_BENCH_ENGINES(Bench::FAMILY_NESTED_STAR);
+    MYREGEX_BENCH_ENGINES(Bench::FAMILY_PATHOLOGICAL);
+
+#undef MYREGEX_BENCH_ENGINES
+
+    BENCHMARK_TEMPLATE(BM_MatchNFA, Bench::FAMILY_ALTERNATION)
+            ->RangeMultiplier(16)->Range(Bench::min_input, Bench::max_nfa_input);
+    BENCHMARK_TEMPLATE(BM_MatchNFA, Bench::FAMILY_PATHOLOGICAL)
+            ->RangeMultiplier(16)->Range(Bench::min_input, Bench::max_nfa_input);
+}
@@ -113,6 +113,42 @@ namespace Automata {
         }
     };
 
+    class InvalidImageError : public std::exception {
+        std::string message_;
+
+    public:
+        InvalidImageError(std::string reason) {
+            message_ = "Invalid binary image: " + reason;
+        }
+
+        ~InvalidImageError() throw() {
+
+        }
+
+        virtual const char *what() const throw() {
+
+            return message_.c_str();
+        }
+    };
+
+    class TooManyStatesError : public std::exception {
+        std::string message_;
+
+    public:
+        TooManyStatesError(size_t max_states) {
+            message_ = "Automata has more than " + std::to_string(max_states) + " states.";
+        }
+
+        ~TooManyStatesError() throw() {
+
+        }
+
+        virtual const char *what() const throw() {
+
+            return message_.c_str();
+        }
+    };
+
 }
 
 
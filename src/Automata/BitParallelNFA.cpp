@@ -0,0 +1,398 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file BitParallelNFA.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26
+ *
+ * # Description
+ * This is the .cpp file which contains the implementation for all the methods declared in the header file BitParallelNFA.h
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#include <algorithm>
+#include <map>
+
+#include "BitParallelNFA.h"
+#include "AutomataErrors.h"
+#include "../Set/StateBitset.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MYREGEX_X86_SIMD 1
+#include <immintrin.h>
+#define MYREGEX_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace Automata {
+
+    namespace {
+        /// A position of the Glushkov automaton: a destination and the ranges of the transitions of a state to it
+        struct Position {
+            /// Destination
+            Program::state_id state;
+
+            /// Ranges, as first and last byte of each one
+            std::vector<uint32_t> ranges;
+        };
+
+        /**
+         * @brief Numbers the positions of an epsilon free program. Position 0 is the initial state.
+         *
+         * The transitions of a state to the same destination make a single position, so that `.`, which is
+         * two ranges, is a single position too.
+         *
+         * @param program Program without epsilon transitions
+         * @param positions Set to the positions
+         * @param edge_position Set to the position of each transition, in the order they are laid out
+         */
+        void number_positions(Program const& program, std::vector<Position> &positions,
+                              std::vector<uint32_t> &edge_position) {
+            positions.assign(1, Position());
+            positions[0].state = program.start();
+            edge_position.assign(program.edge_count(), 0);
+            if (program.state_count() == 0)
+                return;
+
+            // a position is keyed by its destination followed by its ranges
+            std::map<std::vector<uint32_t>, uint32_t> index;
+            std::vector<std::vector<uint32_t> > keys;
+            Program::Edge const* edges = program.edges_begin(0);
+            for (Program::state_id s = 0; s < program.state_count(); s++)
+            {
+                keys.clear();
+                for (Program::Edge const* e = program.edges_begin(s); e != program.edges_end(s); e++)
+                {
+                    size_t k = 0;
+                    while (k < keys.size() && keys[k][0] != e->target)
+                        k++;
+                    if (k == keys.size())
+                        keys.push_back(std::vector<uint32_t>(1, e->target));
+                    keys[k].push_back(e->first);
+                    keys[k].push_back(e->last);
+                }
+
+                for (size_t k = 0; k < keys.size(); k++)
+                {
+                    std::pair<std::map<std::vector<uint32_t>, uint32_t>::iterator, bool> inserted =
+                            index.insert(std::make_pair(keys[k], static_cast<uint32_t>(positions.size())));
+                    if (inserted.second)
+                    {
+                        Position p;
+                        p.state = keys[k][0];
+                        p.ranges.assign(keys[k].begin() + 1, keys[k].end());
+                        positions.push_back(p);
+                    }
+
+                    for (Program::Edge const* e = program.edges_begin(s); e != program.edges_end(s); e++)
+                        if (e->target == keys[k][0])
+                            edge_position[e - edges] = inserted.first->second;
+                }
+            }
+        }
+
+        inline void set_bit(uint64_t* set, size_t bit) {
+            set[bit / BitParallelNFA::word_bits] |= uint64_t(1) << (bit % BitParallelNFA::word_bits);
+        }
+    }
+
+    const size_t BitParallelNFA::word_bits;
+    const size_t BitParallelNFA::max_positions;
+
+    BitParallelNFA::BitParallelNFA()
+            : positions_(0),
+              words_(0),
+              method_(METHOD_SCALAR),
+              streamAlive_(false)
+    {}
+
+    BitParallelNFA::BitParallelNFA(Program const &program)
+            : method_(METHOD_SCALAR)
+    {
+        Program flat;
+        if (program.epsilon_count() > 0)
+        {
+            flat = program.epsilon_free(max_positions * max_positions);
+            if (flat.epsilon_count() > 0)
+                throw TooManyStatesError(max_positions);
+        }
+        Program const& p = program.epsilon_count() > 0 ? flat : program;
+
+        std::vector<Position> positions;
+        std::vector<uint32_t> edge_position;
+        number_positions(p, positions, edge_position);
+        if (positions.size() > max_positions)
+            throw TooManyStatesError(max_positions);
+
+        positions_ = p.state_count() > 0 ? positions.size() : 0;
+        words_ = positions_ <= word_bits ? 1 : positions_ <= 2 * word_bits ? 2 : 4;
+
+        symbols_.assign(Program::alphabet_size * words_, 0);
+        shift_.assign(words_, 0);
+        finals_.assign(words_, 0);
+        stream_.assign(words_, 0);
+
+        // the follow set of a position is made of the transitions out of its state. The next position is
+        // left to the shift, and the chunks of positions which follow nothing else need no table.
+        std::vector<uint64_t> follows(positions_ * words_, 0);
+        std::vector<uint8_t> tabled((positions_ + 7) / 8, 0);
+        for (size_t i = 0; i < positions_; i++)
+        {
+            Position const& pos = positions[i];
+            size_t first_edge = static_cast<size_t>(p.edges_begin(pos.state) - p.edges_begin(0));
+            size_t last_edge = static_cast<size_t>(p.edges_end(pos.state) - p.edges_begin(0));
+            for (size_t e = first_edge; e < last_edge; e++)
+            {
+                if (edge_position[e] == i + 1)
+                    set_bit(shift_.data(), i);
+                else
+                {
+                    set_bit(&follows[i * words_], edge_position[e]);
+                    tabled[i / 8] = 1;
+                }
+            }
+
+            // the initial position is never entered again
+            for (size_t r = 0; r < pos.ranges.size(); r += 2)
+                for (uint32_t c = pos.ranges[r]; c <= pos.ranges[r + 1]; c++)
+                    set_bit(&symbols_[c * words_], i);
+
+            if (p.isEnd(pos.state))
+                set_bit(finals_.data(), i);
+        }
+
+        for (size_t k = 0; k < tabled.size(); k++)
+            if (tabled[k])
+                chunks_.push_back(static_cast<uint32_t>(k));
+
+        // a subset of the positions of a chunk follows its lowest position and the subset without it
+        follow_.assign(chunks_.size() * 256 * words_, 0);
+        for (size_t t = 0; t < chunks_.size(); t++)
+            for (unsigned int v = 1; v < 256; v++)
+            {
+                size_t low = chunks_[t] * 8 + StateBitset::lowest_bit(v);
+                uint64_t* row = &follow_[(t * 256 + v) * words_];
+                uint64_t const* rest = &follow_[(t * 256 + (v & (v - 1))) * words_];
+                for (size_t w = 0; w < words_; w++)
+                    row[w] = rest[w] | (low < positions_ ? follows[low * words_ + w] : 0);
+            }
+
+#ifdef MYREGEX_X86_SIMD
+        __builtin_cpu_init();
+        if (words_ == 4 && __builtin_cpu_supports("avx2"))
+            method_ = METHOD_AVX2;
+#endif
+        reset();
+    }
+
+    size_t BitParallelNFA::position_count(Program const &program) {
+        std::vector<Position> positions;
+        std::vector<uint32_t> edge_position;
+        if (program.epsilon_count() == 0)
+        {
+            number_positions(program, positions, edge_position);
+            return positions.size();
+        }
+
+        Program flat = program.epsilon_free(max_positions * max_positions);
+        if (flat.epsilon_count() > 0)
+            return max_positions + 1;
+
+        number_positions(flat, positions, edge_position);
+        return positions.size();
+    }
+
+    bool BitParallelNFA::match(std::string_view x) {
+        return match(x.data(), x.data() + x.size());
+    }
+
+    bool BitParallelNFA::match(const char *first, const char *last) {
+        if (positions_ == 0)
+            return false;
+
+        uint64_t set[4];
+        loadStart(set);
+        return run(set, first, last) && accepts(set);
+    }
+
+    void BitParallelNFA::reset() {
+        if (positions_ > 0)
+            loadStart(stream_.data());
+        streamAlive_ = positions_ > 0;
+    }
+
+    bool BitParallelNFA::feed(const char *data, size_t size) {
+        if (streamAlive_)
+            streamAlive_ = run(stream_.data(), data, data + size);
+        return streamAlive_;
+    }
+
+    bool BitParallelNFA::finish() {
+        bool accepted = streamAlive_ && accepts(stream_.data());
+        reset();
+        return accepted;
+    }
+
+    size_t BitParallelNFA::position_count() const {
+        return positions_;
+    }
+
+    size_t BitParallelNFA::word_count() const {
+        return words_;
+    }
+
+    size_t BitParallelNFA::memory_size() const {
+        return (symbols_.size() + follow_.size() + finals_.size() + stream_.size()) * sizeof(uint64_t);
+    }
+
+    MatchStats const& BitParallelNFA::stats() const {
+        return stats_;
+    }
+
+    void BitParallelNFA::resetStats() {
+        stats_ = MatchStats();
+    }
+
+    bool BitParallelNFA::run(uint64_t *set, const char *first, const char *last) {
+        const unsigned char* it = reinterpret_cast<const unsigned char*>(first);
+        const unsigned char* end = reinterpret_cast<const unsigned char*>(last);
+
+        if (method_ == METHOD_AVX2)
+            return runAVX2(set, it, end);
+
+        switch (words_)
+        {
+            case 1:
+                return runScalar<1>(set, it, end);
+            case 2:
+                return runScalar<2>(set, it, end);
+            default:
+                return runScalar<4>(set, it, end);
+        }
+    }
+
+    template <size_t W>
+    bool BitParallelNFA::runScalar(uint64_t *set, const unsigned char *first, const unsigned char *last) {
+        uint64_t d[W];
+        std::copy(set, set + W, d);
+
+        const uint32_t* chunks = chunks_.data();
+        const size_t tables = chunks_.size();
+        const uint64_t* follow = follow_.data();
+
+        for (const unsigned char* it = first; it != last; it++)
+        {
+            uint64_t f[W];
+            uint64_t carry = 0;
+            for (size_t w = 0; w < W; w++)
+            {
+                uint64_t moving = d[w] & shift_[w];
+                f[w] = moving << 1 | carry;
+                carry = moving >> (word_bits - 1);
+            }
+
+            for (size_t t = 0; t < tables; t++)
+            {
+                size_t k = chunks[t];
+                uint64_t const* row = follow + ((t << 8) | ((d[k / 8] >> (k % 8 * 8)) & 0xFF)) * W;
+                for (size_t w = 0; w < W; w++)
+                    f[w] |= row[w];
+            }
+
+            uint64_t const* on_symbol = &symbols_[*it * W];
+            uint64_t any = 0;
+            for (size_t w = 0; w < W; w++)
+            {
+                d[w] = f[w] & on_symbol[w];
+                any |= d[w];
+            }
+
+            MYREGEX_STATS(stats_.bytes++;
+                          for (size_t w = 0; w < W; w++)
+                              stats_.active_states += StateBitset::bit_count(d[w]));
+            if (!any)
+            {
+                std::copy(d, d + W, set);
+                return false;
+            }
+        }
+
+        std::copy(d, d + W, set);
+        return true;
+    }
+
+#ifdef MYREGEX_X86_SIMD
+    MYREGEX_TARGET("avx2")
+    bool BitParallelNFA::runAVX2(uint64_t *set, const unsigned char *first, const unsigned char *last) {
+        alignas(32) uint64_t d[4] = {set[0], set[1], set[2], set[3]};
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(d); // x86 is little endian
+        const uint32_t* chunks = chunks_.data();
+        const size_t tables = chunks_.size();
+        const uint64_t* follow = follow_.data();
+        const __m256i shift = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(shift_.data()));
+
+        __m256i current = _mm256_load_si256(reinterpret_cast<const __m256i*>(d));
+        bool alive = true;
+        for (const unsigned char* it = first; it != last && alive; it++)
+        {
+            // shift the 256 bits left by one: each word, then the carries into the next word
+            __m256i moving = _mm256_and_si256(current, shift);
+            __m256i carries = _mm256_permute4x64_epi64(_mm256_srli_epi64(moving, 63), _MM_SHUFFLE(2, 1, 0, 3));
+            carries = _mm256_blend_epi32(carries, _mm256_setzero_si256(), 0x03);
+            __m256i f = _mm256_or_si256(_mm256_slli_epi64(moving, 1), carries);
+
+            for (size_t t = 0; t < tables; t++)
+                f = _mm256_or_si256(f, _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i*>(follow + ((t << 8) | bytes[chunks[t]]) * 4)));
+
+            current = _mm256_and_si256(f, _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(&symbols_[*it * 4])));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(d), current);
+            alive = !_mm256_testz_si256(current, current);
+
+            MYREGEX_STATS(stats_.bytes++;
+                          for (size_t w = 0; w < 4; w++)
+                              stats_.active_states += StateBitset::bit_count(d[w]));
+        }
+
+        std::copy(d, d + 4, set);
+        return alive;
+    }
+#else
+    bool BitParallelNFA::runAVX2(uint64_t *set, const unsigned char *first, const unsigned char *last) {
+        return runScalar<4>(set, first, last);
+    }
+#endif
+
+    void BitParallelNFA::loadStart(uint64_t *set) const {
+        std::fill(set, set + words_, 0);
+        set[0] = 1;
+    }
+
+    bool BitParallelNFA::accepts(uint64_t const *set) const {
+        uint64_t any = 0;
+        for (size_t w = 0; w < words_; w++)
+            any |= set[w] & finals_[w];
+        return any != 0;
+    }
+}
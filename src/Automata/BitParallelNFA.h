@@ -0,0 +1,200 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file BitParallelNFA.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the class BitParallelNFA.
+ *
+ * # Description
+ * This file contains the declarations of a matcher which simulates the Glushkov automaton of a small
+ * Program with a few machine words per set of states.
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#ifndef MYREGEX_BITPARALLELNFA_H
+#define MYREGEX_BITPARALLELNFA_H
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "Program.h"
+#include "MatchStats.h"
+
+namespace Automata {
+
+    /** @class BitParallelNFA
+     * @author Carlos Brito (carlos.brito524@gmail.com)
+     * @date 10/14/26.
+     *
+     * @brief Simulates the Glushkov automaton of a program of at most `max_positions` positions, one
+     * bit per position
+     *
+     * # Description
+     * A position is a transition of the program, told apart by its range of bytes and its destination,
+     * plus a position for the initial state. In the Glushkov automaton every transition into a position is
+     * taken on the range of that position, so a step from the set of positions D on byte c is
+     *
+     * \f$ D' = Follow(D) \wedge B[c] \f$
+     *
+     * where \f$ B[c] \f$ is the set of positions whose range holds c, and \f$ Follow(D) \f$ the union of the
+     * positions which follow those of D: the transitions out of their destination. This is the Shift-And
+     * algorithm, generalized from strings to any automaton. The positions are numbered in the order of the
+     * program, so most positions of a concatenation are followed by the next one, and those are followed
+     * by shifting D by one bit, as in Shift-And. The rest of \f$ Follow(D) \f$ is or'ed together from one
+     * table per byte of D which holds a position with other followers, giving the union of those for each
+     * of the 256 subsets of the positions of that byte. So a step is a fixed sequence of shifts, loads and
+     * or's and a single and, with no branch besides the test for an empty set and no set of states to walk.
+     *
+     * The sets are one, two or four 64 bit words. Sets of four words are stepped with AVX2 when the
+     * processor supports it.
+     *
+     * The program may have epsilon transitions, they are removed first (see Program::epsilon_free()). The
+     * Glushkov automaton is built on construction and the program isn't kept.
+     *
+     * Please see:
+     * Gonzalo Navarro and Mathieu Raffinot, Flexible Pattern Matching in Strings (2002), chapter 5
+     */
+    class BitParallelNFA {
+    public:
+        /// Bits of a word of a set of positions
+        static const size_t word_bits = 64;
+
+        /// Largest number of positions
+        static const size_t max_positions = 256;
+
+        /// Constructs a matcher which matches nothing
+        BitParallelNFA();
+
+        /// Constructs the Glushkov automaton of a program
+        /**
+         * # Complexity
+         * \f$ O(n + p w) \f$ where \f$ n \f$ is the size of the program, \f$ p \f$ the number of positions
+         * and \f$ w \f$ the number of words of a set
+         *
+         * @param program Compiled automaton
+         * @throws TooManyStatesError if the program has more than max_positions positions
+         */
+        explicit BitParallelNFA(Program const& program);
+
+        /// Returns the number of positions of the Glushkov automaton of a program
+        /**
+         * It is more than max_positions for a program whose epsilon transitions can't be removed without
+         * making more than \f$ max\_positions^2 \f$ transitions, whatever its true number of positions.
+         * Programs which went through Program::simplified() have the fewest.
+         */
+        static size_t position_count(Program const& program);
+
+        /// Returns true if the whole string is accepted by the automaton
+        bool match(std::string_view x);
+
+        /// Returns true if the bytes in \f$ [first, last) \f$ are accepted by the automaton
+        bool match(const char* first, const char* last);
+
+        /// Starts a new stream, discarding the current one. See LazyDFA::feed().
+        void reset();
+
+        /// Matches the next chunk of the stream. Returns false if no continuation of the stream can match.
+        bool feed(const char* data, size_t size);
+
+        /// Returns true if the stream fed so far is accepted by the automaton, and starts a new stream
+        bool finish();
+
+        /// Returns the number of positions
+        size_t position_count() const;
+
+        /// Returns the number of words of a set of positions
+        size_t word_count() const;
+
+        /// Returns the number of bytes used by the tables
+        size_t memory_size() const;
+
+        /// Returns the counters of the hot path. They stay at zero unless MYREGEX_ENABLE_STATS is defined.
+        MatchStats const& stats() const;
+
+        /// Sets the counters of the hot path back to zero
+        void resetStats();
+
+    private:
+        /// Implementation of a step
+        enum Method {
+            METHOD_SCALAR,
+            METHOD_AVX2
+        };
+
+        /// Steps the set over \f$ [first, last) \f$, returns false if it becomes empty
+        bool run(uint64_t* set, const char* first, const char* last);
+
+        /// Steps a set of W words
+        template <size_t W>
+        bool runScalar(uint64_t* set, const unsigned char* first, const unsigned char* last);
+
+        /// Steps a set of four words with AVX2
+        bool runAVX2(uint64_t* set, const unsigned char* first, const unsigned char* last);
+
+        /// Sets the set to the initial position
+        void loadStart(uint64_t* set) const;
+
+        /// Returns whether any position of the set is final
+        bool accepts(uint64_t const* set) const;
+
+        /// Number of positions
+        size_t positions_;
+
+        /// Words of a set, 1, 2 or 4
+        size_t words_;
+
+        /// Bytes of a set which hold positions followed by more than the next one, one follow table each
+        std::vector<uint32_t> chunks_;
+
+        /// Implementation of a step
+        Method method_;
+
+        /// Positions whose range holds each byte, words_ words per byte
+        std::vector<uint64_t> symbols_;
+
+        /// Positions followed by the next position
+        std::vector<uint64_t> shift_;
+
+        /// Union of the follow sets, but the next positions, of each subset of the positions of a byte of
+        /// chunks_: words_ words per subset, 256 subsets per byte
+        std::vector<uint64_t> follow_;
+
+        /// Final positions
+        std::vector<uint64_t> finals_;
+
+        /// Set of positions of the stream
+        std::vector<uint64_t> stream_;
+
+        /// Whether the stream can still match
+        bool streamAlive_;
+
+        /// Counters of the hot path
+        MatchStats stats_;
+    };
+}
+
+#endif //MYREGEX_BITPARALLELNFA_H
@@ -0,0 +1,618 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file DenseDFA.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26
+ *
+ * # Description
+ * This is the .cpp file which contains the implementation for all the methods declared in the header file DenseDFA.h
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+#include "DenseDFA.h"
+#include "LazyDFA.h"
+#include "AutomataErrors.h"
+#include "../IO/Image.h"
+
+namespace Automata {
+
+    namespace {
+        const char image_magic[8] = {'M', 'Y', 'R', 'X', 'D', 'F', 'A', 0};
+        const uint32_t byte_order_mark = 0x01020304;
+
+        typedef LazyDFA::nfa_state_set_type nfa_state_set_type;
+
+        /// Computes the epsilon closure of T in place, sorted. marks must be all false and is left so.
+        void epsilon_closure(Program const& program, nfa_state_set_type &T, std::vector<uint8_t> &marks) {
+            std::vector<Program::state_id> stack(T.begin(), T.end());
+            T.clear();
+
+            while (!stack.empty())
+            {
+                Program::state_id s = stack.back();
+                stack.pop_back();
+                if (marks[s])
+                    continue;
+
+                marks[s] = 1;
+                T.push_back(s);
+                for (Program::state_id const* it = program.epsilon_begin(s); it != program.epsilon_end(s); it++)
+                    if (!marks[*it])
+                        stack.push_back(*it);
+            }
+
+            for (nfa_state_set_type::const_iterator it = T.begin(); it != T.end(); it++)
+                marks[*it] = 0;
+
+            std::sort(T.begin(), T.end());
+        }
+
+        /**
+         * @brief Partitions the states of a complete DFA into classes of equivalent states, with Hopcroft's algorithm
+         *
+         * # Complexity
+         * \f$ O(k n \log n) \f$ where \f$ n \f$ is the number of states and \f$ k \f$ the number of symbols
+         *
+         * @param table Transitions, row s holds the successors of state s on each of the k symbols
+         * @param is_end Whether each state is final
+         * @param k Number of symbols
+         * @return The class of each state, numbered from 0
+         */
+        std::vector<uint32_t> hopcroft(std::vector<uint32_t> const& table, std::vector<uint8_t> const& is_end,
+                                       size_t k) {
+            size_t n = is_end.size();
+
+            // predecessors of each state on each symbol, in compressed sparse row form
+            std::vector<uint32_t> pred_offsets(k * n + 1, 0);
+            std::vector<uint32_t> preds(k * n);
+            for (size_t s = 0; s < n; s++)
+                for (size_t c = 0; c < k; c++)
+                    pred_offsets[c * n + table[s * k + c] + 1]++;
+            for (size_t i = 1; i < pred_offsets.size(); i++)
+                pred_offsets[i] += pred_offsets[i - 1];
+
+            std::vector<uint32_t> fill(pred_offsets.begin(), pred_offsets.end() - 1);
+            for (size_t s = 0; s < n; s++)
+                for (size_t c = 0; c < k; c++)
+                    preds[fill[c * n + table[s * k + c]]++] = static_cast<uint32_t>(s);
+
+            // the states of block b are elements[first[b]] up to elements[last[b]], the marked ones first
+            std::vector<uint32_t> elements, location(n), block(n, 0), first, last, marked;
+            for (size_t s = 0; s < n; s++)
+                if (is_end[s])
+                    elements.push_back(static_cast<uint32_t>(s));
+            size_t finals = elements.size();
+            for (size_t s = 0; s < n; s++)
+                if (!is_end[s])
+                    elements.push_back(static_cast<uint32_t>(s));
+
+            first.push_back(0);
+            last.push_back(static_cast<uint32_t>(finals == 0 || finals == n ? n : finals));
+            marked.push_back(0);
+            if (finals != 0 && finals != n)
+            {
+                first.push_back(static_cast<uint32_t>(finals));
+                last.push_back(static_cast<uint32_t>(n));
+                marked.push_back(0);
+            }
+
+            for (size_t b = 0; b < first.size(); b++)
+                for (uint32_t i = first[b]; i < last[b]; i++)
+                {
+                    block[elements[i]] = static_cast<uint32_t>(b);
+                    location[elements[i]] = i;
+                }
+
+            // splitters still to process, as pairs of a block and a symbol
+            std::vector<std::pair<uint32_t, uint32_t> > pending;
+            std::vector<uint8_t> is_pending(first.size() * k, 0);
+            if (first.size() == 2)
+            {
+                uint32_t smaller = finals <= n - finals ? 0 : 1;
+                for (size_t c = 0; c < k; c++)
+                {
+                    pending.push_back(std::make_pair(smaller, static_cast<uint32_t>(c)));
+                    is_pending[smaller * k + c] = 1;
+                }
+            }
+
+            std::vector<uint32_t> splitter, touched;
+            while (!pending.empty())
+            {
+                uint32_t b = pending.back().first;
+                uint32_t c = pending.back().second;
+                pending.pop_back();
+                is_pending[b * k + c] = 0;
+
+                // the states which go into b on c, found before any block is split
+                splitter.clear();
+                for (uint32_t i = first[b]; i < last[b]; i++)
+                {
+                    size_t row = c * n + elements[i];
+                    splitter.insert(splitter.end(), preds.begin() + pred_offsets[row], preds.begin() + pred_offsets[row + 1]);
+                }
+
+                touched.clear();
+                for (size_t i = 0; i < splitter.size(); i++)
+                {
+                    uint32_t s = splitter[i];
+                    uint32_t y = block[s];
+                    uint32_t boundary = first[y] + marked[y];
+                    if (location[s] < boundary) // already marked
+                        continue;
+
+                    if (marked[y] == 0)
+                        touched.push_back(y);
+
+                    uint32_t other = elements[boundary];
+                    std::swap(elements[location[s]], elements[boundary]);
+                    location[other] = location[s];
+                    location[s] = boundary;
+                    marked[y]++;
+                }
+
+                for (size_t i = 0; i < touched.size(); i++)
+                {
+                    uint32_t y = touched[i];
+                    uint32_t size = last[y] - first[y];
+                    uint32_t split = marked[y];
+                    marked[y] = 0;
+                    if (split == size)
+                        continue;
+
+                    // the marked states become a new block
+                    uint32_t z = static_cast<uint32_t>(first.size());
+                    first.push_back(first[y]);
+                    last.push_back(first[y] + split);
+                    marked.push_back(0);
+                    first[y] += split;
+                    for (uint32_t j = first[z]; j < last[z]; j++)
+                        block[elements[j]] = z;
+
+                    is_pending.resize(first.size() * k, 0);
+                    for (size_t a = 0; a < k; a++)
+                    {
+                        uint32_t add = is_pending[y * k + a] || split <= size - split ? z : y;
+                        if (!is_pending[add * k + a])
+                        {
+                            pending.push_back(std::make_pair(add, static_cast<uint32_t>(a)));
+                            is_pending[add * k + a] = 1;
+                        }
+                    }
+                }
+            }
+
+            return block;
+        }
+    }
+
+    const size_t DenseDFA::alphabet_size;
+    const DenseDFA::state_id DenseDFA::dead_state;
+    const size_t DenseDFA::default_max_states;
+    const size_t DenseDFA::interleave;
+    const uint32_t DenseDFA::image_version;
+
+    DenseDFA::DenseDFA() {
+        bind();
+    }
+
+    DenseDFA::DenseDFA(Program const &program, size_t max_states) {
+        if (program.state_count() == 0)
+        {
+            bind();
+            return;
+        }
+
+        // Bytes which no transition tells apart behave the same, they are a single symbol. The classes are
+        // merged further once the automaton is minimal.
+        std::vector<uint8_t> symbol_of;
+        size_t k = program.byte_classes(symbol_of);
+
+        // Subset construction. State 0 is the dead state, so the automaton is complete.
+        std::vector<uint8_t> marks(program.state_count(), 0);
+        flat_hashtable<nfa_state_set_type, state_id, LazyDFA::Hasher> index;
+        std::vector<nfa_state_set_type> sets(1);
+        std::vector<uint32_t> table(k, 0);
+        std::vector<uint8_t> is_end(1, 0);
+
+        nfa_state_set_type start(1, program.start());
+        epsilon_closure(program, start, marks);
+        index.insert(start, 1);
+        sets.push_back(start);
+
+        // states are numbered in the order they are found, so sets[s] is always built before row s
+        std::vector<nfa_state_set_type> moves(k);
+        for (size_t s = 1; s < sets.size(); s++)
+        {
+            for (size_t c = 0; c < k; c++)
+                moves[c].clear();
+
+            bool end = false;
+            for (nfa_state_set_type::const_iterator it = sets[s].begin(); it != sets[s].end(); it++)
+            {
+                end = end || program.isEnd(*it);
+                for (Program::Edge const* e = program.edges_begin(*it); e != program.edges_end(*it); e++)
+                    for (size_t c = symbol_of[e->first]; c <= symbol_of[e->last]; c++)
+                        moves[c].push_back(e->target);
+            }
+            is_end.push_back(end ? 1 : 0);
+
+            for (size_t c = 0; c < k; c++)
+            {
+                if (moves[c].empty())
+                {
+                    table.push_back(0);
+                    continue;
+                }
+
+                epsilon_closure(program, moves[c], marks);
+                if (!index.contains_key(moves[c]))
+                {
+                    if (sets.size() > max_states)
+                        throw TooManyStatesError(max_states);
+
+                    index.insert(moves[c], static_cast<state_id>(sets.size()));
+                    sets.push_back(moves[c]);
+                }
+                table.push_back(index.at(moves[c]));
+            }
+        }
+        sets.clear();
+
+        // Minimize, then number the classes of states in breadth first order from the initial state.
+        // States equivalent to the dead one can't reach a final state, they become dead_state.
+        std::vector<uint32_t> block = hopcroft(table, is_end, k);
+        std::vector<uint32_t> number(block.size(), dead_state); // by block
+        std::vector<uint32_t> order; // a state of each class, by number
+
+        if (block[1] != block[0])
+        {
+            number[block[1]] = 0;
+            order.push_back(1);
+        }
+        for (size_t i = 0; i < order.size(); i++)
+            for (size_t c = 0; c < k; c++)
+            {
+                uint32_t b = block[table[order[i] * k + c]];
+                if (b != block[0] && number[b] == dead_state)
+                {
+                    number[b] = static_cast<uint32_t>(order.size());
+                    order.push_back(table[order[i] * k + c]);
+                }
+            }
+
+        // Merge the symbols whose columns are equal into classes
+        std::map<std::vector<uint32_t>, uint8_t> columns;
+        std::vector<uint8_t> class_of(k);
+        for (size_t c = 0; c < k; c++)
+        {
+            std::vector<uint32_t> column(order.size());
+            for (size_t i = 0; i < order.size(); i++)
+                column[i] = number[block[table[order[i] * k + c]]];
+
+            std::map<std::vector<uint32_t>, uint8_t>::iterator found = columns.find(column);
+            if (found == columns.end())
+                found = columns.insert(std::make_pair(column, static_cast<uint8_t>(columns.size()))).first;
+            class_of[c] = found->second;
+        }
+
+        size_t classes = columns.empty() ? 1 : columns.size();
+        classes_.resize(alphabet_size);
+        for (size_t c = 0; c < alphabet_size; c++)
+            classes_[c] = class_of[symbol_of[c]];
+
+        table_.assign(order.size() * classes, dead_state);
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            isEnd_.push_back(is_end[order[i]]);
+            for (size_t c = 0; c < k; c++)
+            {
+                uint32_t target = number[block[table[order[i] * k + c]]];
+                table_[i * classes + class_of[c]] = target == dead_state ? dead_state
+                                                                         : static_cast<state_id>(target * classes);
+            }
+        }
+
+        classCount_ = classes;
+        bind();
+    }
+
+    DenseDFA::DenseDFA(DenseDFA const &other)
+            : table_(other.table_),
+              classes_(other.classes_),
+              isEnd_(other.isEnd_),
+              inPlace_(other.inPlace_),
+              storage_(other.storage_),
+              stateCount_(other.stateCount_),
+              classCount_(other.classCount_),
+              tableData_(other.tableData_),
+              classesData_(other.classesData_),
+              isEndData_(other.isEndData_)
+    {
+        if (!inPlace_)
+            bind();
+    }
+
+    DenseDFA& DenseDFA::operator=(DenseDFA const &other) {
+        if (this != &other)
+        {
+            table_ = other.table_;
+            classes_ = other.classes_;
+            isEnd_ = other.isEnd_;
+            inPlace_ = other.inPlace_;
+            storage_ = other.storage_;
+            stateCount_ = other.stateCount_;
+            classCount_ = other.classCount_;
+            tableData_ = other.tableData_;
+            classesData_ = other.classesData_;
+            isEndData_ = other.isEndData_;
+
+            if (!inPlace_)
+                bind();
+        }
+        return *this;
+    }
+
+    DenseDFA::DenseDFA(DenseDFA &&other) {
+        take(other);
+    }
+
+    DenseDFA& DenseDFA::operator=(DenseDFA &&other) {
+        if (this != &other)
+            take(other);
+        return *this;
+    }
+
+    void DenseDFA::take(DenseDFA &other) {
+        // moving a vector keeps its buffer, so a DFA reading its own vectors still does
+        table_ = std::move(other.table_);
+        classes_ = std::move(other.classes_);
+        isEnd_ = std::move(other.isEnd_);
+        inPlace_ = other.inPlace_;
+        storage_ = std::move(other.storage_);
+        stateCount_ = other.stateCount_;
+        classCount_ = other.classCount_;
+        tableData_ = other.tableData_;
+        classesData_ = other.classesData_;
+        isEndData_ = other.isEndData_;
+
+        other.table_.clear();
+        other.classes_.clear();
+        other.isEnd_.clear();
+        other.storage_.reset();
+        other.bind();
+    }
+
+    void DenseDFA::match_many(std::string_view const *strs, size_t count, unsigned char *results) const {
+        // a lane without a string is in dead_state, with no index
+        const char* it[interleave];
+        const char* end[interleave];
+        state_id s[interleave];
+        size_t index[interleave];
+        size_t next = 0;
+        size_t busy = 0;
+
+        auto load = [&](size_t k) {
+            s[k] = dead_state;
+            index[k] = SIZE_MAX;
+            while (next < count && s[k] == dead_state)
+            {
+                std::string_view str = strs[next];
+                if (str.empty() || start() == dead_state)
+                {
+                    results[next++] = isEnd(start());
+                    continue;
+                }
+
+                it[k] = str.data();
+                end[k] = str.data() + str.size();
+                s[k] = start();
+                index[k] = next++;
+                busy++;
+            }
+        };
+
+        for (size_t k = 0; k < interleave; k++)
+            load(k);
+
+        while (busy > 0)
+        {
+            // no lane runs out of bytes before the shortest one
+            size_t steps = SIZE_MAX;
+            for (size_t k = 0; k < interleave; k++)
+                if (s[k] != dead_state)
+                    steps = std::min(steps, static_cast<size_t>(end[k] - it[k]));
+
+            for (; steps > 0; steps--)
+                for (size_t k = 0; k < interleave; k++)
+                    if (s[k] != dead_state)
+                        s[k] = tableData_[s[k] + classesData_[static_cast<unsigned char>(*it[k]++)]];
+
+            for (size_t k = 0; k < interleave; k++)
+                if (index[k] != SIZE_MAX && (s[k] == dead_state || it[k] == end[k]))
+                {
+                    results[index[k]] = isEnd(s[k]);
+                    busy--;
+                    load(k);
+                }
+        }
+    }
+
+    void DenseDFA::run_all(const char *first, const char *last, std::vector<state_id> &reached) const {
+        // the runs which are in the same state share a lane, owner[i] is the lane of the run from state i
+        std::vector<state_id> lanes(stateCount_);
+        std::vector<uint32_t> owner(stateCount_);
+        for (size_t i = 0; i < stateCount_; i++)
+        {
+            lanes[i] = state(i);
+            owner[i] = static_cast<uint32_t>(i);
+        }
+
+        std::vector<state_id> merged;
+        std::vector<uint32_t> renamed;
+        std::vector<uint32_t> slot(stateCount_ + 1, UINT32_MAX); // lane of each state, the last one is dead_state
+        size_t interval = 16; // bytes between merges, doubled every time since most runs converge early
+        const char* it = first;
+        while (it != last && lanes.size() > 1)
+        {
+            const char* stop = it + std::min(interval, static_cast<size_t>(last - it));
+            for (; it != stop; ++it)
+            {
+                unsigned char c = classesData_[static_cast<unsigned char>(*it)];
+                for (size_t l = 0; l < lanes.size(); l++)
+                    if (lanes[l] != dead_state)
+                        lanes[l] = tableData_[lanes[l] + c];
+            }
+
+            merged.clear();
+            renamed.resize(lanes.size());
+            for (size_t l = 0; l < lanes.size(); l++)
+            {
+                size_t index = lanes[l] == dead_state ? stateCount_ : state_index(lanes[l]);
+                if (slot[index] == UINT32_MAX)
+                {
+                    slot[index] = static_cast<uint32_t>(merged.size());
+                    merged.push_back(lanes[l]);
+                }
+                renamed[l] = slot[index];
+            }
+
+            for (size_t l = 0; l < merged.size(); l++)
+                slot[merged[l] == dead_state ? stateCount_ : state_index(merged[l])] = UINT32_MAX;
+            for (size_t i = 0; i < stateCount_; i++)
+                owner[i] = renamed[owner[i]];
+
+            lanes.swap(merged);
+            interval = std::min(interval * 2, static_cast<size_t>(1 << 12));
+        }
+
+        if (lanes.size() == 1)
+            lanes[0] = run(lanes[0], it, last);
+
+        reached.resize(stateCount_);
+        for (size_t i = 0; i < stateCount_; i++)
+            reached[i] = lanes[owner[i]];
+    }
+
+    size_t DenseDFA::state_count() const {
+        return stateCount_;
+    }
+
+    size_t DenseDFA::class_count() const {
+        return classCount_;
+    }
+
+    unsigned char DenseDFA::byte_class(unsigned char c) const {
+        return classesData_[c];
+    }
+
+    size_t DenseDFA::memory_size() const {
+        return sizeof(DenseDFA) + alphabet_size * sizeof(uint8_t)
+               + stateCount_ * (classCount_ * sizeof(state_id) + sizeof(uint8_t));
+    }
+
+    void DenseDFA::save(std::vector<char> &image) const {
+        ImageWriter writer(image);
+
+        writer.write(image_magic, sizeof(image_magic));
+        writer.write(image_version);
+        writer.write(byte_order_mark);
+        writer.write(static_cast<uint32_t>(stateCount_));
+        writer.write(static_cast<uint32_t>(classCount_));
+
+        writer.write_array(classesData_, alphabet_size);
+        writer.write_array(tableData_, stateCount_ * classCount_);
+        writer.write_array(isEndData_, stateCount_);
+        writer.align();
+    }
+
+    DenseDFA DenseDFA::load(const char *first, const char *last, const char *&next,
+                            std::shared_ptr<const void> const &storage) {
+        ImageReader reader(first, last);
+
+        const char* magic = reader.read(sizeof(image_magic));
+        if (!magic || std::memcmp(magic, image_magic, sizeof(image_magic)) != 0)
+            throw InvalidImageError("not a DFA");
+
+        uint32_t version, byte_order, state_count, class_count;
+        if (!reader.read_value(version) || !reader.read_value(byte_order) || !reader.read_value(state_count)
+            || !reader.read_value(class_count))
+            throw InvalidImageError("truncated DFA header");
+
+        if (version != image_version)
+            throw InvalidImageError("unsupported DFA version " + std::to_string(version));
+
+        if (byte_order != byte_order_mark)
+            throw InvalidImageError("DFA saved on an incompatible machine");
+
+        if (class_count == 0 || class_count > alphabet_size)
+            throw InvalidImageError("corrupted DFA classes");
+
+        DenseDFA dfa;
+        dfa.inPlace_ = true;
+        dfa.storage_ = storage;
+        dfa.stateCount_ = state_count;
+        dfa.classCount_ = class_count;
+        dfa.classesData_ = reader.read_array<uint8_t>(alphabet_size);
+        dfa.tableData_ = reader.read_array<state_id>(static_cast<size_t>(state_count) * class_count);
+        dfa.isEndData_ = reader.read_array<uint8_t>(state_count);
+
+        if (!dfa.classesData_ || !dfa.tableData_ || !dfa.isEndData_ || !reader.align())
+            throw InvalidImageError("truncated DFA");
+
+        for (size_t c = 0; c < alphabet_size; c++)
+            if (dfa.classesData_[c] >= class_count)
+                throw InvalidImageError("corrupted DFA classes");
+
+        // entries are offsets of rows
+        for (size_t i = 0; i < static_cast<size_t>(state_count) * class_count; i++)
+        {
+            state_id target = dfa.tableData_[i];
+            if (target != dead_state && (target % class_count != 0 || target / class_count >= state_count))
+                throw InvalidImageError("corrupted DFA transitions");
+        }
+
+        next = reader.position();
+        return dfa;
+    }
+
+    void DenseDFA::bind() {
+        inPlace_ = false;
+        if (classes_.empty())
+        {
+            classes_.assign(alphabet_size, 0);
+            classCount_ = 1;
+        }
+
+        stateCount_ = isEnd_.size();
+        tableData_ = table_.data();
+        classesData_ = classes_.data();
+        isEndData_ = isEnd_.data();
+    }
+}
@@ -0,0 +1,249 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file DenseDFA.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the class DenseDFA.
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#ifndef MYREGEX_DENSEDFA_H
+#define MYREGEX_DENSEDFA_H
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "Program.h"
+
+namespace Automata {
+
+    /** @class DenseDFA
+     * @author Carlos Brito (carlos.brito524@gmail.com)
+     * @date 10/14/26.
+     *
+     * @brief Minimal deterministic automaton built up front from a compiled NFA
+     *
+     * # Description
+     * Every state of the subset construction is built on construction, then the automaton is minimized
+     * with Hopcroft's algorithm, so no two states accept the same language. Unlike LazyDFA nothing is ever
+     * computed while matching, so a DenseDFA is read only and may be shared by any number of threads, and
+     * it can be saved into a binary image and loaded back in place like a Program. The price is that the
+     * number of states may grow exponentially with the size of the program, which is why the construction
+     * gives up past a given number of states.
+     *
+     * # Byte classes
+     * Bytes which lead every state to the same state are put in the same class, and the transition table
+     * has a column per class rather than per byte. Most patterns only use a handful of bytes, all the others
+     * fall in a single class, so the table of a typical pattern is a few KB. Matching a byte costs one
+     * lookup in the 256 entries map of classes and one in the table. The entries of the table are the
+     * offsets of the rows of their targets, so no multiplication is needed either.
+     *
+     * The initial state is start(). Only anchored matches are supported.
+     */
+    class DenseDFA {
+    public:
+        /// Identifier for a state
+        typedef uint32_t state_id;
+
+        /// Number of symbols of the alphabet, this is the width of each row of the transition table
+        static const size_t alphabet_size = 256;
+
+        /// Marks a transition to the empty set of states
+        static const state_id dead_state = 0xFFFFFFFF;
+
+        /// Default maximum number of states, the table then takes 4 MB
+        static const size_t default_max_states = 1 << 12;
+
+        /// Number of strings match_many() runs at the same time
+        static const size_t interleave = 8;
+
+        /// Version of the binary image made by save()
+        static const uint32_t image_version = 2;
+
+        /// Constructs an empty automaton which matches nothing
+        DenseDFA();
+
+        /**
+         * @brief Builds every state of the automaton
+         *
+         * # Complexity
+         * \f$ O(d \cdot (n + m)) \f$ where \f$ d \f$ is the number of states of the DFA, \f$ n \f$ the
+         * number of states and \f$ m \f$ the number of transitions of the program
+         *
+         * @param program Compiled automaton to determinize
+         * @param max_states Maximum number of states
+         * @throws TooManyStatesError if the automaton would have more than max_states states
+         */
+        explicit DenseDFA(Program const& program, size_t max_states = default_max_states);
+
+        /// Copies an automaton. The copy of a loaded automaton reads the same image.
+        DenseDFA(DenseDFA const& other);
+
+        /// Copies an automaton. The copy of a loaded automaton reads the same image.
+        DenseDFA& operator=(DenseDFA const& other);
+
+        /// Moves a DFA without copying its table. The moved from DFA is left empty.
+        DenseDFA(DenseDFA&& other);
+
+        /// Moves a DFA without copying its table. The moved from DFA is left empty.
+        DenseDFA& operator=(DenseDFA&& other);
+
+        /// Returns true if the bytes in \f$ [first, last) \f$ are accepted by the automaton
+        bool match(const char* first, const char* last) const;
+
+        /**
+         * @brief Matches many strings, `interleave` of them at a time
+         *
+         * Each byte of match() needs the state reached by the previous one, so a single string waits on
+         * every lookup in the table. Here the strings are run in lockstep, one byte of each in turn, and
+         * the lookups of different strings overlap. A string which ends or dies is replaced by the next.
+         *
+         * @param strs Strings to match
+         * @param count Number of strings
+         * @param results Set to 1 for each string which is accepted and 0 for the others, in order
+         */
+        void match_many(std::string_view const* strs, size_t count, unsigned char* results) const;
+
+        /// Returns the initial state, or dead_state if the automaton accepts nothing
+        state_id start() const;
+
+        /// Runs the automaton from state s over the bytes in \f$ [first, last) \f$ and returns the state reached
+        state_id run(state_id s, const char* first, const char* last) const;
+
+        /**
+         * @brief Runs the automaton over \f$ [first, last) \f$ from every state at once
+         *
+         * This is what lets a string be matched in parallel: each part of it is run from every state the
+         * previous parts may have ended in, and the maps of the parts are then chained from left to right.
+         * The runs from different states usually reach the same state after a few bytes, from then on they
+         * are advanced as one, so the whole costs little more than a single run.
+         *
+         * @param first Pointer to the first byte
+         * @param last Pointer past the last byte
+         * @param reached Set to the state reached from each state, by index, see state_index()
+         */
+        void run_all(const char* first, const char* last, std::vector<state_id> &reached) const;
+
+        /// Returns true if state s is final. s may be dead_state.
+        bool isEnd(state_id s) const;
+
+        /// Returns the index in \f$ [0, state\_count()) \f$ of state s, which isn't dead_state
+        size_t state_index(state_id s) const;
+
+        /// Returns the state of an index in \f$ [0, state\_count()) \f$
+        state_id state(size_t index) const;
+
+        /// Returns the number of states
+        size_t state_count() const;
+
+        /// Returns the number of byte classes, this is the width of each row of the transition table
+        size_t class_count() const;
+
+        /// Returns the class of a byte
+        unsigned char byte_class(unsigned char c) const;
+
+        /// Returns the number of bytes used by the automaton
+        size_t memory_size() const;
+
+        /// Appends the binary image of the automaton. See Program::save().
+        void save(std::vector<char> &image) const;
+
+        /**
+         * @brief Makes an automaton which reads its table from a binary image made by save()
+         *
+         * See Program::load(), the parameters are the same.
+         *
+         * @throws InvalidImageError if the image is truncated or corrupted
+         */
+        static DenseDFA load(const char* first, const char* last, const char*& next,
+                             std::shared_ptr<const void> const& storage);
+
+    private:
+        /// Points the arrays at the vectors below
+        void bind();
+
+        /// Takes the table of another DFA and leaves it empty
+        void take(DenseDFA& other);
+
+        /// Transitions, row s holds the successors of state s on each class
+        std::vector<state_id> table_;
+
+        /// Class of each byte
+        std::vector<uint8_t> classes_;
+
+        /// Whether each state is final
+        std::vector<uint8_t> isEnd_;
+
+        /// Whether the arrays point into an image instead of the vectors above
+        bool inPlace_;
+
+        /// Owner of the image the arrays point into
+        std::shared_ptr<const void> storage_;
+
+        size_t stateCount_;
+        size_t classCount_;
+        const state_id* tableData_;
+        const uint8_t* classesData_;
+        const uint8_t* isEndData_;
+    };
+
+    inline DenseDFA::state_id DenseDFA::start() const {
+        return stateCount_ == 0 ? dead_state : 0;
+    }
+
+    inline DenseDFA::state_id DenseDFA::run(state_id s, const char *first, const char *last) const {
+        if (s == dead_state)
+            return s;
+
+        for (; first != last; ++first)
+        {
+            s = tableData_[s + classesData_[static_cast<unsigned char>(*first)]];
+            if (s == dead_state)
+                break;
+        }
+        return s;
+    }
+
+    inline bool DenseDFA::isEnd(state_id s) const {
+        return s != dead_state && isEndData_[s / classCount_] != 0;
+    }
+
+    inline size_t DenseDFA::state_index(state_id s) const {
+        return s / classCount_;
+    }
+
+    inline DenseDFA::state_id DenseDFA::state(size_t index) const {
+        return static_cast<state_id>(index * classCount_);
+    }
+
+    inline bool DenseDFA::match(const char *first, const char *last) const {
+        return isEnd(run(start(), first, last));
+    }
+}
+
+#endif //MYREGEX_DENSEDFA_H
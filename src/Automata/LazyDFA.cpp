@@ -0,0 +1,663 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file LazyDFA.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26
+ *
+ * # Description
+ * This is the .cpp file which contains the implementation for all the methods declared in the header file LazyDFA.h
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#include <algorithm>
+
+#include "LazyDFA.h"
+
+namespace Automata {
+
+    const size_t LazyDFA::default_memory_budget;
+    const size_t LazyDFA::alphabet_size;
+    const LazyDFA::state_id LazyDFA::unknown_state;
+    const LazyDFA::state_id LazyDFA::dead_state;
+    const size_t LazyDFA::min_bytes_per_state;
+    const size_t LazyDFA::interleave;
+    const uint32_t LazyDFA::matched_marker;
+
+    LazyDFA::LazyDFA()
+            : mode_(MODE_ANCHORED),
+              cache_(state_cache_type(1)),
+              start_(unknown_state),
+              memoryBudget_(default_memory_budget),
+              memoryUsed_(0),
+              flushCount_(0),
+              fallbackCount_(0),
+              markGeneration_(0),
+              streamState_(dead_state),
+              streamBytesSinceFlush_(0)
+    {}
+
+    LazyDFA::LazyDFA(std::shared_ptr<const Program> program, size_t memory_budget, Mode mode)
+            : program_(program),
+              mode_(mode),
+              start_(unknown_state),
+              memoryBudget_(memory_budget),
+              memoryUsed_(0),
+              flushCount_(0),
+              fallbackCount_(0),
+              marks_(program->state_count(), 0),
+              markGeneration_(0),
+              streamState_(dead_state),
+              streamBytesSinceFlush_(0)
+    {
+        flush();
+        flushCount_ = 0; // the initial flush doesn't count
+        reset();
+    }
+
+    bool LazyDFA::match(std::string_view x) {
+        return match(x.data(), x.data() + x.size());
+    }
+
+    bool LazyDFA::match(const char *first, const char *last) {
+        if (!program_ || program_->state_count() == 0)
+            return false;
+
+        return matchFrom(startState(), first, last);
+    }
+
+    bool LazyDFA::matchFrom(state_id s, const char *first, const char *last) {
+        size_t bytes_since_flush = 0;
+        nfa_state_set_type T;
+
+        const char* it = run(s, first, last, bytes_since_flush, T);
+        if (s == unknown_state)
+        {
+            fallbackCount_++;
+            return simulate(T, it, last) && accepts(T);
+        }
+
+        return s != dead_state && states_[s].is_end;
+    }
+
+    void LazyDFA::match_many(std::string_view const *strs, size_t count, unsigned char *results) {
+        if (!program_ || program_->state_count() == 0)
+        {
+            std::fill(results, results + count, 0);
+            return;
+        }
+
+        // a lane without a string is in dead_state, with no index
+        const char* it[interleave];
+        const char* end[interleave];
+        state_id s[interleave];
+        size_t index[interleave];
+        size_t next = 0;
+        size_t busy = 0;
+
+        auto load = [&](size_t k) {
+            s[k] = dead_state;
+            index[k] = SIZE_MAX;
+            if (next == count)
+                return;
+
+            it[k] = strs[next].data();
+            end[k] = strs[next].data() + strs[next].size();
+            s[k] = startState();
+            index[k] = next++;
+            busy++;
+        };
+
+        for (size_t k = 0; k < interleave; k++)
+            load(k);
+
+        while (busy > 0)
+        {
+            // no lane runs out of bytes before the shortest one
+            size_t steps = SIZE_MAX;
+            for (size_t k = 0; k < interleave; k++)
+                if (s[k] != dead_state)
+                    steps = std::min(steps, static_cast<size_t>(end[k] - it[k]));
+
+            for (; steps > 0 && busy > 0; steps--)
+                for (size_t k = 0; k < interleave; k++)
+                {
+                    if (s[k] == dead_state)
+                        continue;
+
+                    state_id t = table_[s[k] * alphabet_size + static_cast<unsigned char>(*it[k])];
+                    if (t < dead_state)
+                    {
+                        MYREGEX_STATS(stats_.bytes++; stats_.active_states += states_[s[k]].nfa_states.size());
+                        MYREGEX_STATS(stats_.cache_hits++);
+                        s[k] = t;
+                        it[k]++;
+                        continue;
+                    }
+
+                    // the transition is dead or not cached, the rest of the string is matched on its own
+                    size_t flushes_before = flushCount_;
+                    results[index[k]] = matchFrom(s[k], it[k], end[k]);
+                    s[k] = dead_state;
+                    index[k] = SIZE_MAX;
+                    busy--;
+
+                    if (flushCount_ != flushes_before) // the states of the other lanes are gone
+                        for (size_t j = 0; j < interleave; j++)
+                            if (s[j] != dead_state)
+                            {
+                                it[j] = strs[index[j]].data();
+                                s[j] = startState();
+                            }
+                }
+
+            for (size_t k = 0; k < interleave; k++)
+                if (index[k] == SIZE_MAX || it[k] == end[k])
+                {
+                    if (index[k] != SIZE_MAX)
+                    {
+                        results[index[k]] = states_[s[k]].is_end;
+                        busy--;
+                    }
+                    load(k);
+                }
+        }
+    }
+
+    bool LazyDFA::match(const char *first, const char *last, nfa_state_set_type &finals) {
+        finals.clear();
+        if (!program_ || program_->state_count() == 0)
+            return false;
+
+        state_id s = startState();
+        size_t bytes_since_flush = 0;
+        nfa_state_set_type T;
+
+        const char* it = run(s, first, last, bytes_since_flush, T);
+        nfa_state_set_type const* reached = &T;
+        if (s == unknown_state)
+        {
+            fallbackCount_++;
+            if (!simulate(T, it, last))
+                return false;
+        } else if (s == dead_state || !states_[s].is_end)
+            return false;
+        else
+            reached = &states_[s].nfa_states;
+
+        for (nfa_state_set_type::const_iterator t_it = reached->begin(); t_it != reached->end(); t_it++)
+            if (program_->isEnd(*t_it))
+                finals.push_back(*t_it);
+
+        return !finals.empty();
+    }
+
+    void LazyDFA::reset() {
+        streamState_ = dead_state;
+        streamSet_.clear();
+        streamBytesSinceFlush_ = 0;
+
+        if (!program_ || program_->state_count() == 0)
+            return;
+
+        streamState_ = startState();
+    }
+
+    bool LazyDFA::feed(const char *data, size_t size) {
+        if (streamState_ == dead_state)
+            return false;
+
+        state_id s = streamState_;
+        streamState_ = unknown_state; // s is tracked here while running, a flush has nothing to save
+
+        if (s == unknown_state)
+            s = findOrAddState(streamSet_);
+
+        const char* last = data + size;
+        const char* it = run(s, data, last, streamBytesSinceFlush_, streamSet_);
+        if (s == unknown_state)
+        {
+            // only the rest of this chunk is simulated, the next one goes back to the DFA
+            fallbackCount_++;
+            if (!simulate(streamSet_, it, last))
+                s = dead_state;
+        }
+
+        streamState_ = s;
+        return streamState_ != dead_state;
+    }
+
+    bool LazyDFA::finish() {
+        bool accepted;
+        if (streamState_ == dead_state)
+            accepted = false;
+        else if (streamState_ == unknown_state)
+            accepted = accepts(streamSet_);
+        else
+            accepted = states_[streamState_].is_end;
+
+        reset();
+        return accepted;
+    }
+
+    const char* LazyDFA::run(state_id &s, const char *first, const char *last, size_t &bytes_since_flush,
+                             nfa_state_set_type &T) {
+        for (const char* it = first; it != last; it++)
+        {
+            unsigned char c = static_cast<unsigned char>(*it);
+            state_id next = table_[s * alphabet_size + c];
+
+            MYREGEX_STATS(stats_.bytes++; stats_.active_states += states_[s].nfa_states.size());
+            MYREGEX_STATS(next == unknown_state ? stats_.cache_misses++ : stats_.cache_hits++);
+
+            if (next == unknown_state)
+            {
+                successor(states_[s].nfa_states, c, T);
+
+                if (T.empty())
+                {
+                    next = dead_state;
+                    table_[s * alphabet_size + c] = next;
+                } else
+                {
+                    size_t states_before = states_.size();
+                    size_t flushes_before = flushCount_;
+
+                    next = findOrAddState(T);
+
+                    if (flushCount_ != flushes_before) // the source state is gone, we can't memoize
+                    {
+                        if (bytes_since_flush < min_bytes_per_state * states_before) // cache thrashes
+                        {
+                            s = unknown_state;
+                            return it + 1;
+                        }
+                        bytes_since_flush = 0;
+                    } else
+                        table_[s * alphabet_size + c] = next;
+                }
+            }
+
+            if (next == dead_state)
+            {
+                s = dead_state;
+                return last;
+            }
+
+            s = next;
+            bytes_since_flush++;
+        }
+
+        return last;
+    }
+
+    LazyDFA::Mode LazyDFA::mode() const {
+        return mode_;
+    }
+
+    bool LazyDFA::search(const char *first, const char *last, const char *&end, Prefilter const *prefix) {
+        if (!program_ || program_->state_count() == 0)
+            return false;
+
+        bool found = false;
+        state_id s = startState();
+        if (states_[s].is_end)
+        {
+            end = first;
+            found = true;
+        }
+
+        for (const char* it = first; it != last; it++)
+        {
+            if (prefix && s == start_) // no match can start before the next occurrence of the prefix
+            {
+                it = prefix->find(it, last);
+                if (!it)
+                    break;
+            }
+
+            s = step(s, static_cast<unsigned char>(*it));
+            if (s == dead_state) // every thread died, the last match is the one
+                break;
+
+            if (states_[s].is_end)
+            {
+                end = it + 1;
+                found = true;
+            }
+        }
+
+        return found;
+    }
+
+    bool LazyDFA::longest_reverse(const char *first, const char *last, const char *&begin) {
+        if (!program_ || program_->state_count() == 0)
+            return false;
+
+        bool found = false;
+        state_id s = startState();
+        if (states_[s].is_end)
+        {
+            begin = last;
+            found = true;
+        }
+
+        for (const char* it = last; it != first;)
+        {
+            --it;
+            s = step(s, static_cast<unsigned char>(*it));
+            if (s == dead_state)
+                break;
+
+            if (states_[s].is_end)
+            {
+                begin = it;
+                found = true;
+            }
+        }
+
+        return found;
+    }
+
+    LazyDFA::state_id LazyDFA::step(state_id s, unsigned char c) {
+        state_id next = table_[s * alphabet_size + c];
+
+        MYREGEX_STATS(stats_.bytes++; stats_.active_states += states_[s].nfa_states.size());
+        MYREGEX_STATS(next == unknown_state ? stats_.cache_misses++ : stats_.cache_hits++);
+
+        if (next != unknown_state)
+            return next;
+
+        nfa_state_set_type T;
+        successor(states_[s].nfa_states, c, T);
+        if (T.empty())
+        {
+            table_[s * alphabet_size + c] = dead_state;
+            return dead_state;
+        }
+
+        size_t flushes_before = flushCount_;
+        next = findOrAddState(T);
+        if (flushCount_ == flushes_before) // otherwise the source state is gone
+            table_[s * alphabet_size + c] = next;
+
+        return next;
+    }
+
+    void LazyDFA::startSet(nfa_state_set_type &T) {
+        T.clear();
+        if (mode_ == MODE_ANCHORED)
+        {
+            T.push_back(program_->start());
+            epsilon_closure(T);
+            return;
+        }
+
+        clearMarks();
+        if (addOrdered(program_->start(), T))
+            T.push_back(matched_marker);
+    }
+
+    void LazyDFA::successor(nfa_state_set_type const &T, unsigned char c, nfa_state_set_type &result) {
+        if (mode_ == MODE_ANCHORED)
+        {
+            move(T, c, result);
+            epsilon_closure(result);
+            return;
+        }
+
+        result.clear();
+        clearMarks();
+
+        bool matched = !T.empty() && T.back() == matched_marker;
+        bool found_end = false;
+        for (nfa_state_set_type::const_iterator s_it = T.begin(); s_it != T.end() && !found_end; s_it++)
+        {
+            if (*s_it == matched_marker)
+                break;
+
+            for (Program::Edge const* e_it = program_->edges_begin(*s_it); e_it != program_->edges_end(*s_it); e_it++)
+            {
+                if (e_it->contains(c))
+                {
+                    // the threads after a final state are less preferred than its match, drop them
+                    if (addOrdered(e_it->target, result))
+                    {
+                        found_end = true;
+                        break;
+                    }
+                } else if (e_it->first > c) // transitions are sorted by their first symbol
+                    break;
+            }
+        }
+
+        // a match may start at the next position too, with the lowest preference, until one is found
+        if (!matched && !found_end)
+            found_end = addOrdered(program_->start(), result);
+
+        if (!result.empty() && (matched || found_end))
+            result.push_back(matched_marker);
+    }
+
+    bool LazyDFA::addOrdered(Program::state_id s, nfa_state_set_type &T) {
+        if (marks_[s] == markGeneration_)
+            return false;
+
+        stack_.clear();
+        stack_.push_back(s);
+        while (!stack_.empty())
+        {
+            Program::state_id top = stack_.back();
+            stack_.pop_back();
+
+            if (marks_[top] == markGeneration_)
+                continue;
+
+            marks_[top] = markGeneration_;
+            T.push_back(top);
+            if (program_->isEnd(top))
+                return true;
+
+            // push in reverse so the preferred transition is followed first
+            for (Program::state_id const* it = program_->epsilon_end(top); it != program_->epsilon_begin(top);)
+            {
+                --it;
+                if (marks_[*it] != markGeneration_)
+                    stack_.push_back(*it);
+            }
+        }
+
+        return false;
+    }
+
+    void LazyDFA::clearMarks() {
+        if (++markGeneration_ == 0) // marks wrapped around, clear them
+        {
+            std::fill(marks_.begin(), marks_.end(), 0);
+            markGeneration_ = 1;
+        }
+    }
+
+    void LazyDFA::epsilon_closure(nfa_state_set_type &T) {
+        clearMarks();
+
+        stack_.clear();
+        for (nfa_state_set_type::iterator it = T.begin(); it != T.end(); it++)
+        {
+            if (marks_[*it] != markGeneration_)
+            {
+                marks_[*it] = markGeneration_;
+                stack_.push_back(*it);
+            }
+        }
+
+        T.clear();
+        while (!stack_.empty())
+        {
+            uint32_t s = stack_.back();
+            stack_.pop_back();
+            T.push_back(s);
+
+            for (Program::state_id const* it = program_->epsilon_begin(s); it != program_->epsilon_end(s); it++)
+            {
+                if (marks_[*it] != markGeneration_) // we do not need to revisit a state that is already in the set
+                {
+                    marks_[*it] = markGeneration_;
+                    stack_.push_back(*it);
+                }
+            }
+        }
+
+        std::sort(T.begin(), T.end());
+    }
+
+    void LazyDFA::move(nfa_state_set_type const &T, unsigned char c, nfa_state_set_type &result) {
+        result.clear();
+        for (nfa_state_set_type::const_iterator s_it = T.begin(); s_it != T.end(); s_it++)
+        {
+            for (Program::Edge const* e_it = program_->edges_begin(*s_it); e_it != program_->edges_end(*s_it); e_it++)
+            {
+                if (e_it->contains(c))
+                    result.push_back(e_it->target);
+                else if (e_it->first > c) // transitions are sorted by their first symbol
+                    break;
+            }
+        }
+    }
+
+    bool LazyDFA::accepts(nfa_state_set_type const &T) const {
+        for (nfa_state_set_type::const_iterator it = T.begin(); it != T.end(); it++)
+            if (*it != matched_marker && program_->isEnd(*it))
+                return true;
+
+        return false;
+    }
+
+    LazyDFA::state_id LazyDFA::findOrAddState(nfa_state_set_type const &T) {
+        state_cache_type::iterator found = cache_.find(T);
+        if (found != cache_.end())
+            return found->second;
+
+        size_t cost = stateCost(T.size());
+        if (memoryUsed_ + cost > memoryBudget_ && !states_.empty())
+            flush();
+
+        DFAState state;
+        state.nfa_states = T;
+        state.is_end = accepts(T);
+
+        state_id id = static_cast<state_id>(states_.size());
+        states_.push_back(state);
+        table_.resize(table_.size() + alphabet_size, unknown_state);
+        cache_.insert(T, id);
+        memoryUsed_ += cost;
+
+        return id;
+    }
+
+    LazyDFA::state_id LazyDFA::startState() {
+        if (start_ == unknown_state)
+        {
+            nfa_state_set_type T;
+            startSet(T);
+            start_ = findOrAddState(T);
+        }
+        return start_;
+    }
+
+    bool LazyDFA::simulate(nfa_state_set_type &T, const char *it, const char *last) {
+        nfa_state_set_type next;
+        for (; it != last; it++)
+        {
+            MYREGEX_STATS(stats_.bytes++; stats_.active_states += T.size());
+
+            move(T, static_cast<unsigned char>(*it), next);
+            epsilon_closure(next);
+
+            if (next.empty())
+            {
+                T.clear();
+                return false;
+            }
+
+            T.swap(next);
+        }
+        return true;
+    }
+
+    size_t LazyDFA::stateCost(size_t nfa_state_count) {
+        return alphabet_size * sizeof(state_id) // row of the transition table
+               + 2 * nfa_state_count * sizeof(uint32_t) // the set itself and its copy as key of the cache
+               + sizeof(DFAState);
+    }
+
+    void LazyDFA::flush() {
+        // keep the stream alive, its state is about to go away
+        if (streamState_ < states_.size())
+        {
+            streamSet_ = states_[streamState_].nfa_states;
+            streamState_ = unknown_state;
+        }
+
+        states_.clear();
+        table_.clear();
+        cache_.clear(); // keeps the slots, the cache fills up to about the same size again
+        start_ = unknown_state;
+        memoryUsed_ = 0;
+        flushCount_++;
+    }
+
+    void LazyDFA::setMemoryBudget(size_t memory_budget) {
+        memoryBudget_ = memory_budget;
+        flush();
+    }
+
+    size_t LazyDFA::memory_budget() const {
+        return memoryBudget_;
+    }
+
+    size_t LazyDFA::memory_used() const {
+        return memoryUsed_;
+    }
+
+    size_t LazyDFA::state_count() const {
+        return states_.size();
+    }
+
+    size_t LazyDFA::flush_count() const {
+        return flushCount_;
+    }
+
+    size_t LazyDFA::fallback_count() const {
+        return fallbackCount_;
+    }
+
+    MatchStats const& LazyDFA::stats() const {
+        return stats_;
+    }
+
+    void LazyDFA::resetStats() {
+        stats_ = MatchStats();
+    }
+}
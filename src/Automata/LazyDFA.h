@@ -0,0 +1,386 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file LazyDFA.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the class LazyDFA.
+ *
+ * # Description
+ * This file contains the declarations of a deterministic automaton which is built on demand from a compiled
+ * NFA (see Program.h) by the subset construction. Only the states which are actually visited while matching
+ * are ever built.
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#ifndef MYREGEX_LAZYDFA_H
+#define MYREGEX_LAZYDFA_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Program.h"
+#include "Prefilter.h"
+#include "MatchStats.h"
+#include "../Hashtable/FlatHashtable.h"
+
+namespace Automata {
+
+    /** @class LazyDFA
+     * @author Carlos Brito (carlos.brito524@gmail.com)
+     * @date 10/14/26.
+     *
+     * @brief Deterministic automaton built lazily from a compiled NFA
+     *
+     * # Description
+     * Each state of the DFA stands for a set of states of the NFA, exactly as in the subset construction
+     * of the dragon book. Instead of building every state up front, a state is only created the first time
+     * the matcher steps into it, and every transition is memoized in a dense table of 256 entries per state.
+     * Once the cache is warm, matching a string costs a single table lookup per byte.
+     *
+     * The cache is bounded by a memory budget. When adding a state would exceed the budget, the whole
+     * cache is flushed and rebuilt on demand. If flushes happen so often that the cache does no useful
+     * work (it thrashes), the automaton gives up on caching for the rest of the string and simulates the
+     * NFA directly.
+     *
+     * The Program given to the constructor is shared, not copied, so any number of automata may be built
+     * on the same one.
+     *
+     * A string may also be matched as a stream, one chunk at a time, with feed() and finish(). Only the
+     * current state is carried from one chunk to the next, no byte is copied or kept, so the memory used
+     * doesn't depend on the length of the stream. A stream may be interleaved with calls to match().
+     *
+     * # Searching
+     * An automaton built in MODE_UNANCHORED looks for a match anywhere in the string instead, see
+     * search(). Its states are sets of NFA states too, but ordered by preference like the threads of a
+     * backtracking matcher: the initial state is added after the others at every position until a match
+     * is found, and the states after a final one are dropped. So the last final state reached is the end
+     * of the leftmost match, and among the matches which start there, of the one a backtracking matcher
+     * would find first.
+     */
+    class LazyDFA {
+    public:
+        /// Identifier for a state of the DFA
+        typedef uint32_t state_id;
+
+        /// Set of NFA states, identified by their index. Always kept sorted.
+        typedef std::vector<uint32_t> nfa_state_set_type;
+
+        /**
+         * @class Hasher
+         * @brief Functor which returns a `size_t` hash for a set of NFA states
+         */
+        struct Hasher {
+        public:
+            size_t operator()(nfa_state_set_type const& set) const {
+                size_t hash = 2166136261u; // FNV-1a
+                for (nfa_state_set_type::const_iterator it = set.begin(); it != set.end(); it++)
+                {
+                    hash ^= *it;
+                    hash *= 16777619u;
+                }
+                return hash;
+            }
+        };
+
+        typedef flat_hashtable<nfa_state_set_type, state_id, Hasher> state_cache_type;
+
+        /// How the automaton runs over a string
+        enum Mode {
+            /// The whole string has to be accepted, see match() and feed()
+            MODE_ANCHORED,
+
+            /// A match may start anywhere in the string, see search()
+            MODE_UNANCHORED
+        };
+
+        /// Default memory budget of the state cache, in bytes
+        static const size_t default_memory_budget = 1 << 20;
+
+        /// Number of symbols of the alphabet, this is the width of each row of the transition table
+        static const size_t alphabet_size = 256;
+
+        /// Marks a transition which hasn't been computed yet
+        static const state_id unknown_state = 0xFFFFFFFF;
+
+        /// Marks a transition to the empty set of states
+        static const state_id dead_state = 0xFFFFFFFE;
+
+        /// The cache is considered to thrash if fewer than this many bytes per state were scanned between flushes
+        static const size_t min_bytes_per_state = 10;
+
+        /// Number of strings match_many() runs at the same time
+        static const size_t interleave = 8;
+
+        /// Constructs an empty automaton which matches nothing
+        LazyDFA();
+
+        /// Constructs the automaton from a compiled NFA
+        /**
+         * No state of the DFA is built at this point.
+         *
+         * @param program Compiled automaton to determinize
+         * @param memory_budget Maximum number of bytes the state cache may use
+         * @param mode How the automaton runs over a string
+         */
+        explicit LazyDFA(std::shared_ptr<const Program> program, size_t memory_budget = default_memory_budget,
+                         Mode mode = MODE_ANCHORED);
+
+        /// Returns how the automaton runs over a string
+        Mode mode() const;
+
+        /// Returns true if the whole string is accepted by the automaton
+        /**
+         * States and transitions are created as they are needed and kept in the cache for the
+         * following calls.
+         * @param x String to match
+         * @return true if string matches pattern, false otherwise
+         */
+        bool match(std::string_view x);
+
+        /// Returns true if the bytes in \f$ [first, last) \f$ are accepted by the automaton. See match().
+        bool match(const char* first, const char* last);
+
+        /**
+         * @brief Matches many strings, `interleave` of them at a time. Only in MODE_ANCHORED.
+         *
+         * The strings are run in lockstep over the cached transitions, one byte of each in turn, so the
+         * lookups of different strings overlap instead of each waiting on the previous one. A string which
+         * needs a transition that isn't cached is finished on its own like in match(). If that flushes the
+         * cache, the other strings start over.
+         *
+         * @param strs Strings to match
+         * @param count Number of strings
+         * @param results Set to 1 for each string which is accepted and 0 for the others, in order
+         */
+        void match_many(std::string_view const* strs, size_t count, unsigned char* results);
+
+        /// Finds which final states of the NFA accept the bytes in \f$ [first, last) \f$. Only in MODE_ANCHORED.
+        /**
+         * This is match() for a program with several final states which need to be told apart, like the
+         * one of a RegexSet.
+         *
+         * @param first Pointer to the first byte
+         * @param last Pointer past the last byte
+         * @param finals Set to the final NFA states reached at the end of the string, sorted
+         * @return true if some final state was reached, false otherwise
+         */
+        bool match(const char* first, const char* last, nfa_state_set_type &finals);
+
+        /// Starts a new stream, discarding the current one. See feed().
+        void reset();
+
+        /// Matches the next chunk of the stream
+        /**
+         * The stream is matched as if all of its chunks were concatenated and given to match(). A chunk may
+         * end anywhere, even in the middle of what would be a single symbol of the pattern.
+         *
+         * @param data Pointer to the first byte of the chunk
+         * @param size Number of bytes of the chunk
+         * @return false if no continuation of the stream can match anymore, in which case the remaining
+         * chunks may be skipped
+         */
+        bool feed(const char* data, size_t size);
+
+        /// Returns true if the stream fed so far is accepted by the automaton, and starts a new stream
+        bool finish();
+
+        /// Finds where the leftmost match in \f$ [first, last) \f$ ends. Only in MODE_UNANCHORED.
+        /**
+         * The scan stops as soon as no longer match can be found, which is usually right after the end of
+         * the match. See the description of the class for which match is found.
+         *
+         * If every match starts with a literal, a prefilter for it may be given: whenever the automaton is
+         * back in its initial state, which means nothing scanned so far can be part of a match, it skips
+         * ahead to the next occurrence of the literal.
+         *
+         * @param first Pointer to the first byte
+         * @param last Pointer past the last byte
+         * @param end Set to the end of the match, if any
+         * @param prefix Prefilter for the literal every match starts with, if any
+         * @return true if there is a match, false otherwise
+         */
+        bool search(const char* first, const char* last, const char* &end, Prefilter const* prefix = nullptr);
+
+        /// Finds the longest suffix of \f$ [first, last) \f$ accepted read backwards. Only in MODE_ANCHORED.
+        /**
+         * This is meant for a program built by Program::reversed(): it then finds the leftmost start of
+         * the matches of the original program which end at `last`.
+         *
+         * @param first Pointer to the first byte
+         * @param last Pointer past the last byte
+         * @param begin Set to the start of the suffix, if any
+         * @return true if some suffix is accepted, false otherwise
+         */
+        bool longest_reverse(const char* first, const char* last, const char* &begin);
+
+        /// Sets the memory budget of the cache. Flushes the cache.
+        void setMemoryBudget(size_t memory_budget);
+
+        /// Returns the memory budget of the cache, in bytes
+        size_t memory_budget() const;
+
+        /// Returns the number of bytes currently used by the cache
+        size_t memory_used() const;
+
+        /// Returns the number of DFA states currently in the cache
+        size_t state_count() const;
+
+        /// Returns the number of times the cache has been flushed
+        size_t flush_count() const;
+
+        /// Returns the number of times matching fell back to the NFA because the cache thrashed
+        size_t fallback_count() const;
+
+        /// Returns the counters of the hot path. They stay at zero unless MYREGEX_ENABLE_STATS is defined.
+        MatchStats const& stats() const;
+
+        /// Sets the counters of the hot path back to zero
+        void resetStats();
+
+        /// Flushes every state of the cache
+        void flush();
+
+    private:
+        /// A state of the DFA
+        struct DFAState {
+            /// States of the NFA this state stands for
+            nfa_state_set_type nfa_states;
+
+            /// Whether any of the NFA states is final
+            bool is_end;
+        };
+
+        /// Marks NFA states in the set T of unanchored mode once a match has been found. Always last.
+        static const uint32_t matched_marker = 0xFFFFFFFF;
+
+        /// Computes the epsilon closure of T in place. The result is sorted.
+        void epsilon_closure(nfa_state_set_type &T);
+
+        /// Starts a new generation of marks_, so no state is marked
+        void clearMarks();
+
+        /// Appends the unmarked states of the epsilon closure of s to T in order of preference
+        /**
+         * @return true if a final state was reached, in which case the closure stops there
+         */
+        bool addOrdered(Program::state_id s, nfa_state_set_type &T);
+
+        /// Computes the set of NFA states of the initial state
+        void startSet(nfa_state_set_type &T);
+
+        /// Computes the set of NFA states reached from T on symbol c. It is empty if there is none.
+        void successor(nfa_state_set_type const& T, unsigned char c, nfa_state_set_type &result);
+
+        /// Returns the state reached from s on symbol c, computing it if needed
+        state_id step(state_id s, unsigned char c);
+
+        /// Computes the set of states to which there is a move from T on symbol c
+        void move(nfa_state_set_type const& T, unsigned char c, nfa_state_set_type &result);
+
+        /// Returns whether any state of T is final
+        bool accepts(nfa_state_set_type const& T) const;
+
+        /// Returns the DFA state for the given set, creating it (and maybe flushing the cache) if needed
+        state_id findOrAddState(nfa_state_set_type const& T);
+
+        /// Returns the start state, creating it if needed
+        state_id startState();
+
+        /// Runs the DFA from state s on \f$ [first, last) \f$
+        /**
+         * On return s is the state reached at `last`, or `dead_state`. If the cache thrashed, s is
+         * `unknown_state`, T is the set of NFA states reached and the returned pointer is where the
+         * string has to be resumed from. Otherwise `last` is returned.
+         */
+        const char* run(state_id &s, const char* first, const char* last, size_t &bytes_since_flush,
+                        nfa_state_set_type &T);
+
+        /// Returns true if the bytes in \f$ [first, last) \f$ are accepted starting from state s
+        bool matchFrom(state_id s, const char* first, const char* last);
+
+        /// Simulates the NFA from the set T on \f$ [it, last) \f$, returns false if T becomes empty
+        bool simulate(nfa_state_set_type &T, const char* it, const char* last);
+
+        /// Estimated number of bytes a state with the given number of NFA states uses
+        static size_t stateCost(size_t nfa_state_count);
+
+        /// Compiled NFA
+        std::shared_ptr<const Program> program_;
+
+        /// How the automaton runs over a string
+        Mode mode_;
+
+        /// Cached states of the DFA
+        std::vector<DFAState> states_;
+
+        /// Transition table, `alphabet_size` entries per state
+        std::vector<state_id> table_;
+
+        /// Maps a set of NFA states to its DFA state
+        state_cache_type cache_;
+
+        /// Start state of the DFA, `unknown_state` if not cached
+        state_id start_;
+
+        /// Memory budget of the cache
+        size_t memoryBudget_;
+
+        /// Memory currently used by the cache
+        size_t memoryUsed_;
+
+        /// Number of flushes so far
+        size_t flushCount_;
+
+        /// Number of fallbacks to the NFA so far
+        size_t fallbackCount_;
+
+        /// Counters of the hot path
+        MatchStats stats_;
+
+        /// Marks used while computing closures (avoids clearing a set for every closure)
+        std::vector<uint32_t> marks_;
+
+        /// Current generation of marks_
+        uint32_t markGeneration_;
+
+        /// Scratch stack used while computing closures
+        std::vector<uint32_t> stack_;
+
+        /// Current state of the stream. `unknown_state` if it is only known as the set streamSet_.
+        state_id streamState_;
+
+        /// Set of NFA states of the stream, when streamState_ is `unknown_state`
+        nfa_state_set_type streamSet_;
+
+        /// Bytes of the stream scanned since the last flush
+        size_t streamBytesSinceFlush_;
+    };
+}
+
+#endif //MYREGEX_LAZYDFA_H
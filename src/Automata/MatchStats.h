@@ -0,0 +1,94 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file MatchStats.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the counters the matchers keep when MYREGEX_ENABLE_STATS is defined
+ *
+ * # Description
+ * Counting on every byte isn't free, so the counters are only updated if the project is built with
+ * MYREGEX_ENABLE_STATS defined (the CMake option of the same name). Otherwise MYREGEX_STATS() expands to
+ * nothing and the counters stay at zero.
+ */
+//</editor-fold>
+#ifndef MYREGEX_MATCHSTATS_H
+#define MYREGEX_MATCHSTATS_H
+
+#include <cstdint>
+
+#ifdef MYREGEX_ENABLE_STATS
+/// Runs the statement, only if the counters are enabled
+#define MYREGEX_STATS(statement) do { statement; } while (0)
+#else
+/// Runs the statement, only if the counters are enabled
+#define MYREGEX_STATS(statement) do {} while (0)
+#endif
+
+namespace Automata {
+
+    /// Counters of the hot path of a matcher
+    struct MatchStats {
+#ifdef MYREGEX_ENABLE_STATS
+        /// Whether the counters are updated
+        static const bool enabled = true;
+#else
+        /// Whether the counters are updated
+        static const bool enabled = false;
+#endif
+
+        /// Bytes run through the automaton
+        uint64_t bytes;
+
+        /// Sum over the bytes of the number of NFA states active when the byte was read
+        uint64_t active_states;
+
+        /// Transitions of a lazy DFA found in its cache
+        uint64_t cache_hits;
+
+        /// Transitions of a lazy DFA which had to be computed
+        uint64_t cache_misses;
+
+        MatchStats()
+                : bytes(0),
+                  active_states(0),
+                  cache_hits(0),
+                  cache_misses(0)
+        {}
+
+        /// Adds the counters of another matcher to these ones
+        MatchStats& operator+=(MatchStats const& other) {
+            bytes += other.bytes;
+            active_states += other.active_states;
+            cache_hits += other.cache_hits;
+            cache_misses += other.cache_misses;
+            return *this;
+        }
+
+        /// Returns the average number of active NFA states per byte
+        double average_active_states() const {
+            return bytes == 0 ? 0.0 : static_cast<double>(active_states) / static_cast<double>(bytes);
+        }
+    };
+}
+
+#endif //MYREGEX_MATCHSTATS_H
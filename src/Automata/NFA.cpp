@@ -33,43 +33,62 @@
 
 
 #include <iostream>
+#include <utility>
 #include "AutomataErrors.h"
 #include "NFA.h"
 
 namespace Automata {
 
     NFA::NFA(std::string start_state_name, size_t bucket_count)
-            : stateTable_(state_table_type(bucket_count)),
+            : arena_(new Arena()),
+              stateTable_(state_table_type(bucket_count)),
               endStates_(state_set_type(bucket_count)),
               S_(state_set_type(1))
     {
-        addState(start_state_name); // add initial state
-        startState_ = getState(start_state_name); // find the address of the initial state
+        addState(std::move(start_state_name)); // add initial state
+        startState_ = &states_.front(); // the address of the initial state
     }
 
     NFA::NFA()
+            : arena_(new Arena()),
+              startState_(nullptr)
     {}
 
+    NFA::NFA(NFA &&nfa)
+            : arena_(std::move(nfa.arena_)),
+              states_(std::move(nfa.states_)),
+              stateTable_(std::move(nfa.stateTable_)),
+              endStates_(std::move(nfa.endStates_)),
+              startState_(nfa.startState_),
+              S_(std::move(nfa.S_))
+    {
+        nfa.startState_ = nullptr;
+    }
+
     NFA::~NFA() {
     }
 
     void NFA::addState(std::string state_name, bool is_end) {
-        State s(state_name, is_end);
+        if (stateTable_.contains_key(state_name))
+            throw DuplicateStateError(state_name);
 
-        if (stateTable_.contains_key(s.name()))
-            throw DuplicateStateError(s.name());
+        if (!arena_) // moved from
+            arena_.reset(new Arena());
 
-        if (s.isEnd())
-            endStates_.insert(s);
+        states_.push_back(State(std::move(state_name), is_end, *arena_));
+        State *s = &states_.back();
 
-        stateTable_.insert(s.name(), s);
+        if (s->isEnd())
+            endStates_.insert(*s);
+
+        stateTable_.insert(s->name(), s);
     }
 
     void NFA::addTransition(State *from, State *to, char symbol) {
         from->addTransition(to, symbol); // add the transition to the source state
     }
 
-    void NFA::addTransition(std::string from, std::string to, char symbol) {
+    void NFA::addTransition(std::string const& from, std::string const& to, char symbol) {
         // get elements
         State *source = getState(from);
         State *destination = getState(to);
@@ -86,7 +105,7 @@ namespace Automata {
         return stateTable_;
     }
 
-    State *NFA::getState(std::string name) {
+    State *NFA::getState(std::string const& name) {
         state_table_type::iterator it = stateTable_.find(name);
 
         if (stateTable_.count() == 0)
@@ -95,17 +114,16 @@ namespace Automata {
         if (it == stateTable_.end())
             throw StateNotFoundError(name);
 
-        State *s = &(it->second);
-        return s;
+        return it->second;
     }
 
-    NFA::state_set_type NFA::epsilon_closure(State s) {
+    NFA::state_set_type NFA::epsilon_closure(State const& s) {
         state_set_type result(stateTable_.count());
         result.insert(s);
 
-        State::transition_set_type transitions = s.transition_set();
-        for (State::transition_set_type::iterator it = transitions.begin();
-             it != transitions.end(); it++) // iterate over transitions
+        State::transition_set_type const& transitions = s.transition_set();
+        for (State::transition_set_type::const_iterator it = transitions.cbegin();
+             it != transitions.cend(); it++) // iterate over transitions
         {
             Transition t = *it;
             if (t.symbol() == epsilon)
@@ -119,26 +137,26 @@ namespace Automata {
         return result;
     }
 
-    NFA::state_set_type NFA::epsilon_closure(state_set_type T) {
+    NFA::state_set_type NFA::epsilon_closure(state_set_type const& T) {
         state_set_type result(stateTable_.count());
-        for (state_set_type::iterator it = T.begin(); it != T.end(); it++) // iterate over states s in T
+        for (state_set_type::const_iterator it = T.cbegin(); it != T.cend(); it++) // iterate over states s in T
         {
-            State s = *it;
+            State const& s = *it;
             if (!result.contains(s)) // dont even make the call if s is in result
                 result = result.Union(epsilon_closure(s));
         }
         return result;
     }
 
-    NFA::state_set_type NFA::move(NFA::state_set_type T, char c) {
+    NFA::state_set_type NFA::move(NFA::state_set_type const& T, char c) {
         state_set_type result(stateTable_.count());
 
-        for (state_set_type::iterator s_it = T.begin(); s_it != T.end(); s_it++) // iterate over states s in T
+        for (state_set_type::const_iterator s_it = T.cbegin(); s_it != T.cend(); s_it++) // iterate over states s in T
         {
-            State::transition_set_type s_transitions = s_it->transition_set();
+            State::transition_set_type const& s_transitions = s_it->transition_set();
 
-            for (State::transition_set_type::iterator t_it = s_transitions.begin();
-                 t_it != s_transitions.end(); t_it++)
+            for (State::transition_set_type::const_iterator t_it = s_transitions.cbegin();
+                 t_it != s_transitions.cend(); t_it++)
             {
                 Transition t = *t_it;
                 if (t.symbol() == c)
@@ -151,14 +169,14 @@ namespace Automata {
         return result;
     }
 
-    bool NFA::match(std::string x) {
+    bool NFA::match(std::string_view x) {
 
 
         state_set_type S = epsilon_closure(*startState_);
 
-        for (std::string::iterator c = x.begin(); c != x.end(); c++)
+        for (std::string_view::const_iterator c = x.begin(); c != x.end(); c++)
         {
-
+            MYREGEX_STATS(stats_.bytes++; stats_.active_states += S.count());
             S = epsilon_closure(move(S, *c));
         }
 
@@ -171,7 +189,7 @@ namespace Automata {
 
 
     void NFA::setString(std::string str) {
-        str_to_match = str;
+        str_to_match = std::move(str);
         current_ptr_ = str_to_match.begin();
         S_ = epsilon_closure(*startState_);
     }
@@ -180,11 +198,31 @@ namespace Automata {
         if (current_ptr_ == str_to_match.end())
             throw OutOfBoundsError(str_to_match);
 
+        MYREGEX_STATS(stats_.bytes++; stats_.active_states += S_.count());
         S_ = epsilon_closure(move(S_, *current_ptr_));
 
         current_ptr_++;
     }
 
+    size_t NFA::state_count() const {
+        return states_.size();
+    }
+
+    size_t NFA::transition_count() const {
+        size_t count = 0;
+        for (std::deque<State>::const_iterator it = states_.begin(); it != states_.end(); it++)
+            count += it->transition_set().count();
+        return count;
+    }
+
+    MatchStats const& NFA::stats() const {
+        return stats_;
+    }
+
+    void NFA::resetStats() {
+        stats_ = MatchStats();
+    }
+
     bool NFA::accepts() {
         return !(S_.Intersection(endStates_)).empty();
     }
@@ -202,17 +240,21 @@ namespace Automata {
     }
 
     NFA &NFA::operator=(const NFA &rhs) {
+        if (this == &rhs)
+            return *this;
 
         // Overwriting of automata
         S_ = rhs.S_;
-        stateTable_ = state_table_type( rhs.table().bucket_count() );
-        endStates_ = state_set_type( rhs.end_states().bucket_count() );
+        states_.clear();
+        arena_.reset(new Arena());
+        stateTable_ = state_table_type( rhs.table().count() );
+        endStates_ = state_set_type( rhs.end_states().count() );
 
         // Copy states of other automata
         for (state_table_type::const_iterator entry_it = rhs.stateTable_.cbegin();
              entry_it != rhs.stateTable_.cend(); entry_it++)
         {
-            State s = entry_it->second;
+            State const& s = *entry_it->second;
             this->addState(s.name(), s.isEnd());
         }
 
@@ -223,9 +265,9 @@ namespace Automata {
         for (state_table_type::const_iterator entry_it = rhs.stateTable_.cbegin();
              entry_it != rhs.stateTable_.cend(); entry_it++)
         {
-            State s = entry_it->second;
-            State::transition_set_type transitions = s.transition_set();
-            for (State::transition_set_type::iterator t_it = transitions.begin(); t_it != transitions.end(); t_it++)
+            State const& s = *entry_it->second;
+            State::transition_set_type const& transitions = s.transition_set();
+            for (State::transition_set_type::const_iterator t_it = transitions.cbegin(); t_it != transitions.cend(); t_it++)
             {
                 Transition t = *t_it;
                 this->addTransition(t.source()->name(), t.destination()->name(), t.symbol());
@@ -234,16 +276,31 @@ namespace Automata {
         return *this;
     }
 
+    NFA &NFA::operator=(NFA &&rhs) {
+        if (this != &rhs)
+        {
+            S_ = std::move(rhs.S_);
+            endStates_ = std::move(rhs.endStates_);
+            stateTable_ = std::move(rhs.stateTable_);
+            states_ = std::move(rhs.states_); // the old states go before their arena
+            arena_ = std::move(rhs.arena_);
+            startState_ = rhs.startState_;
+            rhs.startState_ = nullptr;
+        }
+        return *this;
+    }
+
     NFA::NFA(const NFA &nfa)
-            : stateTable_( state_table_type( nfa.table().bucket_count() ) ),
-              endStates_( state_set_type( nfa.end_states().bucket_count() ) ),
+            : arena_(new Arena()),
+              stateTable_( state_table_type( nfa.table().count() ) ),
+              endStates_( state_set_type( nfa.end_states().count() ) ),
               S_( nfa.S_ )
     {
         // Copy states of other automata
         for (state_table_type::const_iterator entry_it = nfa.stateTable_.cbegin();
              entry_it != nfa.stateTable_.cend(); entry_it++)
         {
-            State s = entry_it->second;
+            State const& s = *entry_it->second;
             this->addState(s.name(), s.isEnd());
         }
 
@@ -254,9 +311,9 @@ namespace Automata {
         for (state_table_type::const_iterator entry_it = nfa.stateTable_.cbegin();
              entry_it != nfa.stateTable_.cend(); entry_it++)
         {
-            State s = entry_it->second;
-            State::transition_set_type transitions = s.transition_set();
-            for (State::transition_set_type::iterator t_it = transitions.begin(); t_it != transitions.end(); t_it++)
+            State const& s = *entry_it->second;
+            State::transition_set_type const& transitions = s.transition_set();
+            for (State::transition_set_type::const_iterator t_it = transitions.cbegin(); t_it != transitions.cend(); t_it++)
             {
                 Transition t = *t_it;
                 this->addTransition(t.source()->name(), t.destination()->name(), t.symbol());
@@ -264,7 +321,7 @@ namespace Automata {
         }
     }
 
-    void NFA::setInitialState(std::string name) {
+    void NFA::setInitialState(std::string const& name) {
         startState_ = getState(name);
     }
 
@@ -274,15 +331,15 @@ namespace Automata {
 
         // Declaration of automata
         NFA result(start, // initial state with name start
-                   this->stateTable_.bucket_count() +
-                   to_nfa.stateTable_.bucket_count()); // maximum size to reduce load factor of hashtable
+                   this->stateTable_.count() +
+                   to_nfa.stateTable_.count() + 2); // number of states of the result
         result.addState(end, true); // add end state
 
         // Copy states of other automata
         for (state_table_type::const_iterator entry_it = to_nfa.stateTable_.cbegin();
              entry_it != to_nfa.stateTable_.cend(); entry_it++)
         {
-            State s = entry_it->second;
+            State const& s = *entry_it->second;
             result.addState("2_" + s.name(), s.isEnd());
         }
 
@@ -290,9 +347,9 @@ namespace Automata {
         for (state_table_type::const_iterator entry_it = to_nfa.stateTable_.cbegin();
              entry_it != to_nfa.stateTable_.cend(); entry_it++)
         {
-            State s = entry_it->second;
-            State::transition_set_type transitions = s.transition_set();
-            for (State::transition_set_type::iterator t_it = transitions.begin(); t_it != transitions.end(); t_it++)
+            State const& s = *entry_it->second;
+            State::transition_set_type const& transitions = s.transition_set();
+            for (State::transition_set_type::const_iterator t_it = transitions.cbegin(); t_it != transitions.cend(); t_it++)
             {
                 Transition t = *t_it;
                 result.addTransition("2_" + t.source()->name(), "2_" + t.destination()->name(), t.symbol());
@@ -303,7 +360,7 @@ namespace Automata {
         for (state_table_type::const_iterator entry_it = this->stateTable_.cbegin();
              entry_it != this->stateTable_.cend(); entry_it++)
         {
-            State s = entry_it->second;
+            State const& s = *entry_it->second;
             result.addState("1_" + s.name(), s.isEnd());
         }
 
@@ -311,9 +368,9 @@ namespace Automata {
         for (state_table_type::const_iterator entry_it = this->stateTable_.cbegin();
              entry_it != this->stateTable_.cend(); entry_it++)
         {
-            State s = entry_it->second;
-            State::transition_set_type transitions = s.transition_set();
-            for (State::transition_set_type::iterator t_it = transitions.begin(); t_it != transitions.end(); t_it++)
+            State const& s = *entry_it->second;
+            State::transition_set_type const& transitions = s.transition_set();
+            for (State::transition_set_type::const_iterator t_it = transitions.cbegin(); t_it != transitions.cend(); t_it++)
             {
                 Transition t = *t_it;
                 result.addTransition("1_" + t.source()->name(), "1_" + t.destination()->name(), t.symbol());
@@ -338,8 +395,8 @@ namespace Automata {
 
         // Declaration of automata
         NFA result(start, // initial state with name start
-                   this->stateTable_.bucket_count() +
-                   to_nfa.stateTable_.bucket_count()); // maximum size to reduce load factor of hashtable
+                   this->stateTable_.count() +
+                   to_nfa.stateTable_.count() + 2); // number of states of the result
         result.addState(end, true); // add end state
 
 
@@ -347,7 +404,7 @@ namespace Automata {
         for (state_table_type::const_iterator entry_it = to_nfa.stateTable_.cbegin();
              entry_it != to_nfa.stateTable_.cend(); entry_it++)
         {
-            State s = entry_it->second;
+            State const& s = *entry_it->second;
             result.addState("2_" + s.name(), false);
 
             if(s.isEnd()) // if is end then connect to the result's end state
@@ -358,9 +415,9 @@ namespace Automata {
         for (state_table_type::const_iterator entry_it = to_nfa.stateTable_.cbegin();
              entry_it != to_nfa.stateTable_.cend(); entry_it++)
         {
-            State s = entry_it->second;
-            State::transition_set_type transitions = s.transition_set();
-            for (State::transition_set_type::iterator t_it = transitions.begin(); t_it != transitions.end(); t_it++)
+            State const& s = *entry_it->second;
+            State::transition_set_type const& transitions = s.transition_set();
+            for (State::transition_set_type::const_iterator t_it = transitions.cbegin(); t_it != transitions.cend(); t_it++)
             {
                 Transition t = *t_it;
                 result.addTransition("2_" + t.source()->name(), "2_" + t.destination()->name(), t.symbol());
@@ -372,7 +429,7 @@ namespace Automata {
         for (state_table_type::const_iterator entry_it = this->stateTable_.cbegin();
              entry_it != this->stateTable_.cend(); entry_it++)
         {
-            State s = entry_it->second;
+            State const& s = *entry_it->second;
             result.addState("1_" + s.name(), false);
 
             if (s.isEnd()) // if is end then connect to other initial state
@@ -383,9 +440,9 @@ namespace Automata {
         for (state_table_type::const_iterator entry_it = this->stateTable_.cbegin();
              entry_it != this->stateTable_.cend(); entry_it++)
         {
-            State s = entry_it->second;
-            State::transition_set_type transitions = s.transition_set();
-            for (State::transition_set_type::iterator t_it = transitions.begin(); t_it != transitions.end(); t_it++)
+            State const& s = *entry_it->second;
+            State::transition_set_type const& transitions = s.transition_set();
+            for (State::transition_set_type::const_iterator t_it = transitions.cbegin(); t_it != transitions.cend(); t_it++)
             {
                 Transition t = *t_it;
                 result.addTransition("1_" + t.source()->name(), "1_" + t.destination()->name(), t.symbol());
@@ -405,14 +462,14 @@ namespace Automata {
 
         // Declaration of automata
         NFA result(start, // initial state with name start
-                   this->stateTable_.bucket_count()); // maximum size to reduce load factor of hashtable
+                   this->stateTable_.count() + 2); // number of states of the result
         result.addState(end, true); // add end state
 
         // Copy states of this automata
         for (state_table_type::const_iterator entry_it = this->stateTable_.cbegin();
              entry_it != this->stateTable_.cend(); entry_it++)
         {
-            State s = entry_it->second;
+            State const& s = *entry_it->second;
             result.addState("1_" + s.name(), false);
         }
 
@@ -420,9 +477,9 @@ namespace Automata {
         for (state_table_type::const_iterator entry_it = this->stateTable_.cbegin();
              entry_it != this->stateTable_.cend(); entry_it++)
         {
-            State s = entry_it->second;
-            State::transition_set_type transitions = s.transition_set();
-            for (State::transition_set_type::iterator t_it = transitions.begin(); t_it != transitions.end(); t_it++)
+            State const& s = *entry_it->second;
+            State::transition_set_type const& transitions = s.transition_set();
+            for (State::transition_set_type::const_iterator t_it = transitions.cbegin(); t_it != transitions.cend(); t_it++)
             {
                 Transition t = *t_it;
                 result.addTransition("1_" + t.source()->name(), "1_" + t.destination()->name(), t.symbol());
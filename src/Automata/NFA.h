@@ -43,8 +43,14 @@
 #ifndef MYREGEX_NFA_H
 #define MYREGEX_NFA_H
 
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+
 #include "State.h"
-#include "../Hashtable/Hashtable.h"
+#include "MatchStats.h"
+#include "../Hashtable/FlatHashtable.h"
 
 
 namespace Automata {
@@ -70,25 +76,29 @@ namespace Automata {
      */
     class NFA {
     public:
-        typedef hashtable<std::string, State> state_table_type;
+        typedef flat_hashtable<std::string, State*> state_table_type;
         typedef Set<State, State::Hasher> state_set_type;
 
         /// Instantiates the NFA with a starting state name
         /**
          * This constructor will instantiate the NFA given the name of the start state.
-         * It also takes the number of buckets which regulates whether the internal
-         * access to the elements will be \f$ O(1) \f$ or not.
-         *
-         * If the number of states is known beforehand, then you should set bucket count
-         * to be equal to the number of states.
+         * It also takes the number of states to make room for. The state table grows as states are added,
+         * so this is only a hint which saves the rehashing when the number of states is known beforehand.
          *
          * @param start_state_name Name of initial state
-         * @param bucket_count Number of buckets which the state table will have
+         * @param bucket_count Number of states to make room for
          */
         explicit NFA(std::string start_state_name, size_t bucket_count=100);
 
         NFA(const NFA& nfa);
 
+        /// Moves an automaton. Its states don't move, so pointers to them stay valid.
+        /**
+         * Like the copy constructor, the string given to setString() isn't carried over.
+         * The moved from automaton is left without states.
+         */
+        NFA(NFA&& nfa);
+
         NFA();
 
         /// Destructor method for NFA
@@ -135,7 +145,7 @@ namespace Automata {
          * @param to Name of the state to where the transition ends
          * @param symbol Character symbol required to make the transition
          */
-        void addTransition(std::string from, std::string to, char symbol);
+        void addTransition(std::string const& from, std::string const& to, char symbol);
 
         /// Concatenates two automatas
         /**
@@ -310,7 +320,7 @@ namespace Automata {
          * @param name Name of state
          * @return a pointer to the state
          */
-        State* getState(std::string name);
+        State* getState(std::string const& name);
 
         /// Returns a pointer to the initial state of the NFA
         /**
@@ -364,7 +374,7 @@ namespace Automata {
          * @param s State s
          * @return set of states reachable from state s on epsilon transition
          */
-        state_set_type epsilon_closure(State s);
+        state_set_type epsilon_closure(State const& s);
 
         /// Returns the epsilon closure of a set of states T
         /**
@@ -373,7 +383,7 @@ namespace Automata {
          * @param T Set of states
          * @return union of epsilon closure for each state s in T
          */
-        state_set_type epsilon_closure(state_set_type T);
+        state_set_type epsilon_closure(state_set_type const& T);
 
         /// Returns a the set of states to which there is a move from T on symbol c
         /**
@@ -384,7 +394,7 @@ namespace Automata {
          * @return a set of states to which there is a transition on symbol c from
          * some state s in T
          */
-        state_set_type move(state_set_type T, char c);
+        state_set_type move(state_set_type const& T, char c);
 
         /// Returns true if the string matches the nfa pattern
         /**
@@ -392,14 +402,32 @@ namespace Automata {
          * @param x String to match
          * @return true if string matches pattern, false otherwise
          */
-        bool match(std::string x);
+        bool match(std::string_view x);
+
+        /// Returns the number of states
+        size_t state_count() const;
+
+        /// Returns the number of transitions, epsilon transitions included
+        size_t transition_count() const;
+
+        /// Returns the counters of match() and advance(). They stay at zero unless MYREGEX_ENABLE_STATS is defined.
+        /**
+         * Copies of the automaton start with their own counters at zero.
+         */
+        MatchStats const& stats() const;
+
+        /// Sets the counters back to zero
+        void resetStats();
 
 
         /// Copies the NFA to another
         NFA& operator=(const NFA& rhs);
 
+        /// Moves an automaton into this one. See the move constructor.
+        NFA& operator=(NFA&& rhs);
+
         /// Sets the initial state of the automata
-        void setInitialState(std::string name);
+        void setInitialState(std::string const& name);
 
 
         /// We take the convention that the escape character '\x08' represents epsilon
@@ -408,7 +436,14 @@ namespace Automata {
     public:
         const std::string id_string_;
 
-        /// Table of states
+        /// Owns the transition sets of the states, released at once with the automaton. It is allocated
+        /// apart, so the allocators of the transition sets keep pointing to it when the automaton is moved.
+        std::unique_ptr<Arena> arena_;
+
+        /// States, in the order they were added. A deque never moves them, so transitions can point to them.
+        std::deque<State> states_;
+
+        /// Table of states by name
         state_table_type stateTable_;
 
         /// Set of end states
@@ -425,6 +460,9 @@ namespace Automata {
 
         /// Iterator pointing to the current char on str_to_match
         std::string::iterator current_ptr_;
+
+        /// Counters of match() and advance()
+        MatchStats stats_;
     };
 
 }
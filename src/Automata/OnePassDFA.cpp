@@ -0,0 +1,165 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file OnePassDFA.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26
+ *
+ * # Description
+ * This is the .cpp file which contains the implementation for all the methods declared in the header file OnePassDFA.h
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#include <utility>
+
+#include "OnePassDFA.h"
+#include "../Set/SparseSet.h"
+
+namespace Automata {
+
+    const OnePassDFA::state_id OnePassDFA::dead_state;
+    const size_t OnePassDFA::max_slots;
+
+    static_assert(OnePassDFA::max_slots <= 64, "the slots saved by a transition are the bits of a uint64_t");
+    const size_t OnePassDFA::default_max_states;
+
+    OnePassDFA::OnePassDFA()
+            : classCount_(0),
+              slotCount_(0),
+              onePass_(false)
+    {}
+
+    OnePassDFA::OnePassDFA(Program const &program, size_t max_states)
+            : classCount_(0),
+              slotCount_(program.slot_count()),
+              onePass_(false)
+    {
+        onePass_ = build(program, max_states);
+        if (!onePass_) // only keep the memory of a usable automaton
+        {
+            classOf_.clear();
+            table_.clear();
+            accepting_.clear();
+            acceptSaves_.clear();
+        }
+    }
+
+    bool OnePassDFA::build(Program const &program, size_t max_states) {
+        if (program.state_count() == 0 || slotCount_ > max_slots)
+            return false;
+
+        classCount_ = program.byte_classes(classOf_);
+
+        // states of the automaton, numbered in the order they are found
+        std::vector<state_id> index(program.state_count(), dead_state);
+        std::vector<Program::state_id> order(1, program.start());
+        index[program.start()] = 0;
+
+        SparseSet visited(program.state_count());
+        std::vector<std::pair<Program::state_id, uint64_t> > stack;
+
+        for (size_t q = 0; q < order.size(); q++)
+        {
+            Transition none = {0, dead_state};
+            table_.resize((q + 1) * classCount_, none);
+            accepting_.push_back(0);
+            acceptSaves_.push_back(0);
+            Transition* row = &table_[q * classCount_];
+
+            // follow the closure depth first in order of preference, with the slots saved on the way
+            visited.clear();
+            stack.push_back(std::make_pair(order[q], uint64_t(0)));
+            while (!stack.empty())
+            {
+                Program::state_id s = stack.back().first;
+                uint64_t saves = stack.back().second;
+                stack.pop_back();
+
+                if (!visited.insert(s)) // reached first by a preferred path
+                    continue;
+
+                if (program.slot(s) != Program::no_slot)
+                    saves |= uint64_t(1) << program.slot(s);
+
+                if (program.isEnd(s) && !accepting_[q])
+                {
+                    accepting_[q] = 1;
+                    acceptSaves_[q] = saves;
+                }
+
+                for (Program::Edge const* e = program.edges_begin(s); e != program.edges_end(s); e++)
+                {
+                    if (index[e->target] == dead_state)
+                    {
+                        if (order.size() == max_states)
+                            return false;
+                        index[e->target] = static_cast<state_id>(order.size());
+                        order.push_back(e->target);
+                    }
+
+                    state_id target = static_cast<state_id>(index[e->target] * classCount_);
+                    for (size_t k = classOf_[e->first]; k <= classOf_[e->last]; k++)
+                    {
+                        if (row[k].target == dead_state)
+                        {
+                            row[k].target = target;
+                            row[k].saves = saves;
+                        }
+                        else if (row[k].target != target) // two threads would go on after this byte
+                            return false;
+                    }
+                }
+
+                for (Program::state_id const* it = program.epsilon_end(s); it != program.epsilon_begin(s);)
+                {
+                    --it;
+                    if (!visited.contains(*it))
+                        stack.push_back(std::make_pair(*it, saves));
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool OnePassDFA::isOnePass() const {
+        return onePass_;
+    }
+
+    size_t OnePassDFA::slot_count() const {
+        return slotCount_;
+    }
+
+    size_t OnePassDFA::state_count() const {
+        return accepting_.size();
+    }
+
+    size_t OnePassDFA::memory_size() const {
+        return sizeof(OnePassDFA)
+               + classOf_.size() * sizeof(uint8_t)
+               + table_.size() * sizeof(Transition)
+               + accepting_.size() * sizeof(uint8_t)
+               + acceptSaves_.size() * sizeof(uint64_t);
+    }
+}
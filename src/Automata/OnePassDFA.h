@@ -0,0 +1,197 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file OnePassDFA.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the class OnePassDFA.
+ *
+ * # Description
+ * This file contains the declarations of a deterministic matcher which reports the capture groups of the
+ * patterns which never need to keep two threads alive.
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#ifndef MYREGEX_ONEPASSDFA_H
+#define MYREGEX_ONEPASSDFA_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Program.h"
+#include "../Set/StateBitset.h"
+
+namespace Automata {
+
+    /** @class OnePassDFA
+     * @author Carlos Brito (carlos.brito524@gmail.com)
+     * @date 10/14/26.
+     *
+     * @brief Deterministic automaton which saves the capture slots of a Program as it runs
+     *
+     * # Description
+     * A program is one-pass if, from any state a byte leads to, the epsilon closure holds at most one
+     * transition on each byte which leads somewhere new: the next byte of the string then always tells
+     * which way the match goes, and a matcher never has to keep two threads. Many patterns with groups are
+     * like this, such as `(\w+)@(\w+)\.com` or `(\d+)-(\d+)`, while `(a*)(a*)` or `(.*)x` aren't.
+     *
+     * The states of the automaton are the initial state of the program and the states its transitions lead
+     * to. Each entry of the transition table holds the next state and the set of slots to save at the
+     * position of the byte, that is the save states on the way through the closure. Each state also holds
+     * whether it accepts at the end of the string and what it saves then. So matching is a lookup per byte
+     * and a store per saved slot, and gives the slots a backtracking matcher would: of two paths through a
+     * closure to a same state, or to the final state, the preferred one is kept, which is the one a
+     * backtracking matcher tries first.
+     *
+     * If the program isn't one-pass, has more than `max_slots` slots or the automaton would have more than
+     * a given number of states, the construction gives up and isOnePass() is false. Only anchored matches
+     * are supported. Like DenseDFA, the automaton is read only once built.
+     *
+     * Please see:
+     * Russ Cox, Regular Expression Matching in the Wild (2010)
+     * https://swtch.com/~rsc/regexp/regexp3.html
+     */
+    class OnePassDFA {
+    public:
+        /// Identifier for a state
+        typedef uint32_t state_id;
+
+        /// Marks a transition which no thread takes
+        static const state_id dead_state = 0xFFFFFFFF;
+
+        /// Largest number of capture slots, the slots saved by a transition are a bitmask
+        static const size_t max_slots = 64;
+
+        /// Default maximum number of states, the table then takes at most 4 MB
+        static const size_t default_max_states = 1 << 10;
+
+        /// Constructs an automaton which isn't one-pass
+        OnePassDFA();
+
+        /**
+         * @brief Builds the automaton of a program if it is one-pass
+         *
+         * # Complexity
+         * \f$ O(d \cdot (c + e k)) \f$ where \f$ d \f$ is the number of states of the automaton, \f$ c \f$
+         * the size of the largest epsilon closure of the program, \f$ e \f$ the number of transitions of
+         * such a closure and \f$ k \f$ the number of byte classes
+         *
+         * @param program Compiled automaton, with its epsilon transitions in order of preference
+         * @param max_states Maximum number of states
+         */
+        explicit OnePassDFA(Program const& program, size_t max_states = default_max_states);
+
+        /// Returns true if the program is one-pass. Otherwise the automaton matches nothing.
+        bool isOnePass() const;
+
+        /**
+         * @brief Returns true if the bytes in \f$ [first, last) \f$ are accepted by the automaton
+         * @param first Pointer to the first byte
+         * @param last Pointer past the last byte
+         * @param slots Array of `slot_count()` entries. On a match, set to the offset from first each slot
+         * was saved at, or Program::no_position if it wasn't.
+         * @return true if string matches pattern, false otherwise
+         */
+        bool match(const char* first, const char* last, size_t* slots) const;
+
+        /// Returns the number of capture slots of the program
+        size_t slot_count() const;
+
+        /// Returns the number of states
+        size_t state_count() const;
+
+        /// Returns the number of bytes used by the automaton
+        size_t memory_size() const;
+
+    private:
+        /// An entry of the transition table
+        struct Transition {
+            /// Slots to save at the position of the byte, one bit per slot
+            uint64_t saves;
+
+            /// Offset of the row of the next state, or dead_state
+            state_id target;
+        };
+
+        /// Builds the automaton, returns false if the program isn't one-pass or the automaton too large
+        bool build(Program const& program, size_t max_states);
+
+        /// Sets the slots of a bitmask to a position
+        static void save(uint64_t saves, size_t position, size_t* slots);
+
+        /// Class of each byte
+        std::vector<uint8_t> classOf_;
+
+        /// Number of byte classes, the width of a row
+        size_t classCount_;
+
+        /// Transition table, a row of classCount_ entries per state
+        std::vector<Transition> table_;
+
+        /// Whether each state accepts at the end of the string
+        std::vector<uint8_t> accepting_;
+
+        /// Slots each state saves when it accepts
+        std::vector<uint64_t> acceptSaves_;
+
+        size_t slotCount_;
+        bool onePass_;
+    };
+
+    inline void OnePassDFA::save(uint64_t saves, size_t position, size_t *slots) {
+        for (; saves != 0; saves &= saves - 1)
+            slots[StateBitset::lowest_bit(saves)] = position;
+    }
+
+    inline bool OnePassDFA::match(const char *first, const char *last, size_t *slots) const {
+        if (!onePass_)
+            return false;
+
+        for (size_t i = 0; i < slotCount_; i++)
+            slots[i] = Program::no_position;
+
+        Transition const* table = table_.data();
+        uint8_t const* classOf = classOf_.data();
+        state_id row = 0;
+        for (const char* it = first; it != last; it++)
+        {
+            Transition const& t = table[row + classOf[static_cast<unsigned char>(*it)]];
+            if (t.target == dead_state)
+                return false;
+            if (t.saves != 0)
+                save(t.saves, static_cast<size_t>(it - first), slots);
+            row = t.target;
+        }
+
+        size_t s = row / classCount_;
+        if (!accepting_[s])
+            return false;
+
+        save(acceptSaves_[s], static_cast<size_t>(last - first), slots);
+        return true;
+    }
+}
+
+#endif //MYREGEX_ONEPASSDFA_H
@@ -0,0 +1,275 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file PikeVM.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26
+ *
+ * # Description
+ * This is the .cpp file which contains the implementation for all the methods declared in the header file PikeVM.h
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#include "PikeVM.h"
+
+namespace Automata {
+
+    const size_t PikeVM::bitset_max_states;
+    const size_t PikeVM::alphabet_size;
+
+    PikeVM::PikeVM()
+            : bitset_(false)
+    {}
+
+    PikeVM::PikeVM(std::shared_ptr<const Program> program)
+            : program_(program),
+              current_(program->state_count()),
+              next_(program->state_count()),
+              stream_(program->state_count()),
+              bitset_(false)
+    {
+        // a state is pushed at most once per epsilon transition leading to it, plus the initial push
+        stack_.reserve(program->epsilon_count() + 1);
+
+        if (program->state_count() > 0)
+        {
+            addClosure(current_, program->start());
+            startClosure_.assign(current_.cbegin(), current_.cend());
+        }
+
+        if (program->state_count() > 0 && program->state_count() <= bitset_max_states)
+            buildBitsets();
+
+        reset();
+    }
+
+    bool PikeVM::match(std::string_view x) {
+        return match(x.data(), x.data() + x.size());
+    }
+
+    bool PikeVM::match(const char *first, const char *last) {
+        if (!program_ || program_->state_count() == 0)
+            return false;
+
+        if (bitset_)
+        {
+            bitCurrent_ = bitStart_;
+            return stepBitset(first, last) && bitCurrent_.intersects(bitFinals_);
+        }
+
+        loadStart(current_);
+        return step(first, last) && accepts(current_);
+    }
+
+    void PikeVM::reset() {
+        if (bitset_)
+            bitStream_ = bitStart_;
+        else if (program_ && program_->state_count() > 0)
+            loadStart(stream_);
+    }
+
+    bool PikeVM::feed(const char *data, size_t size) {
+        if (bitset_)
+        {
+            if (bitStream_.empty())
+                return false;
+
+            bitCurrent_.swap(bitStream_);
+            bool alive = stepBitset(data, data + size);
+            bitCurrent_.swap(bitStream_);
+
+            return alive;
+        }
+
+        if (stream_.empty())
+            return false;
+
+        current_.swap(stream_);
+        bool alive = step(data, data + size);
+        current_.swap(stream_);
+
+        return alive;
+    }
+
+    bool PikeVM::finish() {
+        bool accepted = bitset_ ? bitStream_.intersects(bitFinals_) : accepts(stream_);
+        reset();
+        return accepted;
+    }
+
+    bool PikeVM::uses_bitsets() const {
+        return bitset_;
+    }
+
+    MatchStats const& PikeVM::stats() const {
+        return stats_;
+    }
+
+    void PikeVM::resetStats() {
+        stats_ = MatchStats();
+    }
+
+    bool PikeVM::step(const char *first, const char *last) {
+        for (const char* it = first; it != last; it++)
+        {
+            unsigned char c = static_cast<unsigned char>(*it);
+            MYREGEX_STATS(stats_.bytes++; stats_.active_states += current_.count());
+
+            next_.clear();
+            for (SparseSet::const_iterator s_it = current_.cbegin(); s_it != current_.cend(); s_it++)
+            {
+                for (Program::Edge const* e_it = program_->edges_begin(*s_it);
+                     e_it != program_->edges_end(*s_it); e_it++)
+                {
+                    if (e_it->contains(c))
+                        addClosure(next_, e_it->target);
+                    else if (e_it->first > c) // transitions are sorted by their first symbol
+                        break;
+                }
+            }
+
+            current_.swap(next_);
+            if (current_.empty())
+                return false;
+        }
+
+        return true;
+    }
+
+    bool PikeVM::stepBitset(const char *first, const char *last) {
+        size_t words = bitCurrent_.word_count();
+
+        for (const char* it = first; it != last; it++)
+        {
+            unsigned char c = static_cast<unsigned char>(*it);
+            MYREGEX_STATS(stats_.bytes++; stats_.active_states += bitCurrent_.count());
+
+            bitActive_.assign_intersection(bitCurrent_, &bitOnSymbol_[c * words]);
+            bitNext_.clear();
+
+            StateBitset::word_type const* active = bitActive_.data();
+            for (size_t w = 0; w < words; w++)
+            {
+                for (StateBitset::word_type bits = active[w]; bits != 0; bits &= bits - 1)
+                {
+                    Program::state_id s = static_cast<Program::state_id>(
+                            w * StateBitset::word_bits + StateBitset::lowest_bit(bits));
+
+                    for (Program::Edge const* e_it = program_->edges_begin(s); e_it != program_->edges_end(s); e_it++)
+                    {
+                        if (e_it->contains(c))
+                            bitNext_.unite(&bitClosures_[e_it->target * words]);
+                        else if (e_it->first > c) // transitions are sorted by their first symbol
+                            break;
+                    }
+                }
+            }
+
+            bitCurrent_.swap(bitNext_);
+            if (bitCurrent_.empty())
+                return false;
+        }
+
+        return true;
+    }
+
+    void PikeVM::buildBitsets() {
+        size_t n = program_->state_count();
+
+        bitCurrent_ = StateBitset(n);
+        bitNext_ = StateBitset(n);
+        bitStream_ = StateBitset(n);
+        bitActive_ = StateBitset(n);
+        bitStart_ = StateBitset(n);
+        bitFinals_ = StateBitset(n);
+
+        size_t words = bitCurrent_.word_count();
+        bitClosures_.assign(n * words, 0);
+        bitOnSymbol_.assign(alphabet_size * words, 0);
+
+        for (Program::state_id s = 0; s < n; s++)
+        {
+            current_.clear();
+            addClosure(current_, s);
+            for (SparseSet::const_iterator it = current_.cbegin(); it != current_.cend(); it++)
+                bitClosures_[s * words + *it / StateBitset::word_bits] |=
+                        StateBitset::word_type(1) << (*it % StateBitset::word_bits);
+
+            for (Program::Edge const* e_it = program_->edges_begin(s); e_it != program_->edges_end(s); e_it++)
+                for (size_t c = e_it->first; c <= e_it->last; c++)
+                    bitOnSymbol_[c * words + s / StateBitset::word_bits] |=
+                            StateBitset::word_type(1) << (s % StateBitset::word_bits);
+
+            if (program_->isEnd(s))
+                bitFinals_.insert(s);
+        }
+
+        for (std::vector<Program::state_id>::const_iterator it = startClosure_.begin(); it != startClosure_.end(); it++)
+            bitStart_.insert(*it);
+
+        // the sparse sets are only needed to compute the closures
+        current_ = SparseSet();
+        next_ = SparseSet();
+        stream_ = SparseSet();
+        bitset_ = true;
+    }
+
+    bool PikeVM::accepts(SparseSet const &set) const {
+        for (SparseSet::const_iterator s_it = set.cbegin(); s_it != set.cend(); s_it++)
+            if (program_->isEnd(*s_it))
+                return true;
+
+        return false;
+    }
+
+    void PikeVM::loadStart(SparseSet &set) const {
+        set.clear();
+        typedef std::vector<Program::state_id>::const_iterator closure_iterator;
+        for (closure_iterator it = startClosure_.begin(); it != startClosure_.end(); it++)
+            set.insert(*it);
+    }
+
+    void PikeVM::addClosure(SparseSet &set, Program::state_id s) {
+        if (set.contains(s))
+            return;
+
+        stack_.push_back(s);
+        while (!stack_.empty())
+        {
+            Program::state_id top = stack_.back();
+            stack_.pop_back();
+
+            if (!set.insert(top))
+                continue;
+
+            // push in reverse so the preferred transition is followed first
+            for (Program::state_id const* it = program_->epsilon_end(top); it != program_->epsilon_begin(top);)
+            {
+                --it;
+                if (!set.contains(*it))
+                    stack_.push_back(*it);
+            }
+        }
+    }
+}
@@ -0,0 +1,198 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file PikeVM.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the class PikeVM.
+ *
+ * # Description
+ * This file contains the declarations of a matcher which simulates a Program directly, keeping the set of
+ * current states in sparse sets which are allocated once.
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#ifndef MYREGEX_PIKEVM_H
+#define MYREGEX_PIKEVM_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Program.h"
+#include "MatchStats.h"
+#include "../Set/SparseSet.h"
+#include "../Set/StateBitset.h"
+
+namespace Automata {
+
+    /** @class PikeVM
+     * @author Carlos Brito (carlos.brito524@gmail.com)
+     * @date 10/14/26.
+     *
+     * @brief Simulates the NFA of a Program one byte at a time
+     *
+     * # Description
+     * This is the same algorithm as NFA::match(): the current set of states is the epsilon closure of the
+     * move of the previous one on the current symbol. The difference is in the bookkeeping:
+     *
+     * - The current and next sets of states are two SparseSet which are swapped after every byte, so
+     * clearing a set is \f$ O(1) \f$.
+     * - The epsilon closure is computed iteratively on an explicit stack.
+     * - The sets and the stack are allocated once, on construction, with room for every state of the
+     * program.
+     * - The epsilon closure of the initial state is computed once, on construction.
+     *
+     * So a match does no heap allocation at all and costs \f$ O(nm) \f$ in the worst case, where \f$ n \f$
+     * is the length of the string and \f$ m \f$ the number of states, with no dependence on a cache like
+     * the LazyDFA.
+     *
+     * # Small programs
+     * When the program has at most `bitset_max_states` states, the sets of states are StateBitset instead.
+     * The epsilon closure of every state is then computed once, on construction, and a step is a handful of
+     * word operations: the states of the current set with a transition on the byte are found by intersecting
+     * it with the set of states having one, and the closures of their destinations are or'ed together.
+     * Whether a set accepts is a single intersection test with the set of final states.
+     *
+     * A string may also be matched as a stream, one chunk at a time, with feed() and finish(). The set of
+     * states of the stream is kept in its own sparse set, so a stream may be interleaved with calls to
+     * match().
+     */
+    class PikeVM {
+    public:
+        /// Largest number of states for which the sets of states are bitsets
+        static const size_t bitset_max_states = 1024;
+
+        /// Number of distinct bytes
+        static const size_t alphabet_size = 256;
+
+        /// Constructs a matcher which matches nothing
+        PikeVM();
+
+        /// Constructs a matcher for a program
+        /**
+         * @param program Compiled automaton to simulate
+         */
+        explicit PikeVM(std::shared_ptr<const Program> program);
+
+        /// Returns true if the whole string is accepted by the automaton
+        /**
+         * @param x String to match
+         * @return true if string matches pattern, false otherwise
+         */
+        bool match(std::string_view x);
+
+        /// Returns true if the bytes in \f$ [first, last) \f$ are accepted by the automaton. See match().
+        bool match(const char* first, const char* last);
+
+        /// Starts a new stream, discarding the current one. See LazyDFA::feed().
+        void reset();
+
+        /// Matches the next chunk of the stream. Returns false if no continuation of the stream can match.
+        bool feed(const char* data, size_t size);
+
+        /// Returns true if the stream fed so far is accepted by the automaton, and starts a new stream
+        bool finish();
+
+        /// Returns true if the sets of states are bitsets, see `bitset_max_states`
+        bool uses_bitsets() const;
+
+        /// Returns the counters of the hot path. They stay at zero unless MYREGEX_ENABLE_STATS is defined.
+        MatchStats const& stats() const;
+
+        /// Sets the counters of the hot path back to zero
+        void resetStats();
+
+    private:
+        /// Steps the set current_ over \f$ [first, last) \f$, returns false if it becomes empty
+        bool step(const char* first, const char* last);
+
+        /// Returns whether any state of the set is final
+        bool accepts(SparseSet const& set) const;
+
+        /// Steps the bitset bitCurrent_ over \f$ [first, last) \f$, returns false if it becomes empty
+        bool stepBitset(const char* first, const char* last);
+
+        /// Computes the closures and the sets used by the bitset steps
+        void buildBitsets();
+
+        /// Sets the set to the epsilon closure of the initial state
+        void loadStart(SparseSet &set) const;
+
+        /// Adds the epsilon closure of state s to the set
+        void addClosure(SparseSet &set, Program::state_id s);
+
+        /// Compiled NFA
+        std::shared_ptr<const Program> program_;
+
+        /// Current set of states
+        SparseSet current_;
+
+        /// Next set of states
+        SparseSet next_;
+
+        /// Set of states of the stream
+        SparseSet stream_;
+
+        /// Stack used while computing closures
+        std::vector<Program::state_id> stack_;
+
+        /// Epsilon closure of the initial state, computed once
+        std::vector<Program::state_id> startClosure_;
+
+        /// Whether the sets of states are the bitsets below
+        bool bitset_;
+
+        /// Counters of the hot path
+        MatchStats stats_;
+
+        /// Current set of states
+        StateBitset bitCurrent_;
+
+        /// Next set of states
+        StateBitset bitNext_;
+
+        /// Set of states of the stream
+        StateBitset bitStream_;
+
+        /// States of the current set with a transition on the current byte
+        StateBitset bitActive_;
+
+        /// Epsilon closure of the initial state
+        StateBitset bitStart_;
+
+        /// Final states
+        StateBitset bitFinals_;
+
+        /// States with a transition on each byte, `bitCurrent_.word_count()` words per byte
+        std::vector<StateBitset::word_type> bitOnSymbol_;
+
+        /// Epsilon closure of each state, `bitCurrent_.word_count()` words per state
+        std::vector<StateBitset::word_type> bitClosures_;
+    };
+}
+
+#endif //MYREGEX_PIKEVM_H
@@ -0,0 +1,181 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file Prefilter.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26
+ *
+ * # Description
+ * This is the .cpp file which contains the implementation for all the methods declared in the header file Prefilter.h
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#include <cstring>
+
+#include "Prefilter.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MYREGEX_X86_SIMD 1
+#include <immintrin.h>
+#define MYREGEX_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace Automata {
+
+    Prefilter::Prefilter()
+            : method_(METHOD_SCALAR)
+    {}
+
+    Prefilter::Prefilter(std::string const &literal)
+            : literal_(literal),
+              method_(METHOD_SCALAR)
+    {
+#ifdef MYREGEX_X86_SIMD
+        __builtin_cpu_init();
+        if (literal_.size() >= 2)
+        {
+            if (__builtin_cpu_supports("avx2"))
+                method_ = METHOD_AVX2;
+            else if (__builtin_cpu_supports("sse2"))
+                method_ = METHOD_SSE2;
+        }
+#endif
+    }
+
+    const char* Prefilter::find(const char *first, const char *last) const {
+        size_t k = literal_.size();
+        if (k == 0)
+            return first;
+        if (static_cast<size_t>(last - first) < k)
+            return nullptr;
+        if (k == 1)
+            return static_cast<const char*>(std::memchr(first, literal_[0], last - first));
+
+        switch (method_)
+        {
+            case METHOD_AVX2:
+                return findAVX2(first, last);
+            case METHOD_SSE2:
+                return findSSE2(first, last);
+            default:
+                return findScalar(first, last);
+        }
+    }
+
+    std::string const& Prefilter::literal() const {
+        return literal_;
+    }
+
+    bool Prefilter::empty() const {
+        return literal_.empty();
+    }
+
+    bool Prefilter::matchesAt(const char *it) const {
+        size_t k = literal_.size();
+        return k <= 2 || std::memcmp(it + 1, literal_.data() + 1, k - 2) == 0;
+    }
+
+    const char* Prefilter::findScalar(const char *first, const char *last) const {
+        size_t k = literal_.size();
+        const char* stop = last - k + 1; // a match can't start at or after stop
+
+        for (const char* it = first; it < stop; it++)
+        {
+            it = static_cast<const char*>(std::memchr(it, literal_[0], stop - it));
+            if (!it)
+                return nullptr;
+
+            if (it[k - 1] == literal_[k - 1] && matchesAt(it))
+                return it;
+        }
+
+        return nullptr;
+    }
+
+#ifdef MYREGEX_X86_SIMD
+    MYREGEX_TARGET("sse2")
+    const char* Prefilter::findSSE2(const char *first, const char *last) const {
+        size_t k = literal_.size();
+        const char* stop = last - k + 1;
+
+        const __m128i head = _mm_set1_epi8(literal_[0]);
+        const __m128i tail = _mm_set1_epi8(literal_[k - 1]);
+
+        const char* it = first;
+        for (; it + 16 <= stop; it += 16)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it + k - 1));
+            unsigned int mask = static_cast<unsigned int>(
+                    _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, head), _mm_cmpeq_epi8(b, tail))));
+
+            while (mask != 0)
+            {
+                unsigned int bit = static_cast<unsigned int>(__builtin_ctz(mask));
+                if (matchesAt(it + bit))
+                    return it + bit;
+                mask &= mask - 1;
+            }
+        }
+
+        return it < stop ? findScalar(it, last) : nullptr;
+    }
+
+    MYREGEX_TARGET("avx2")
+    const char* Prefilter::findAVX2(const char *first, const char *last) const {
+        size_t k = literal_.size();
+        const char* stop = last - k + 1;
+
+        const __m256i head = _mm256_set1_epi8(literal_[0]);
+        const __m256i tail = _mm256_set1_epi8(literal_[k - 1]);
+
+        const char* it = first;
+        for (; it + 32 <= stop; it += 32)
+        {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(it));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(it + k - 1));
+            unsigned int mask = static_cast<unsigned int>(
+                    _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, head), _mm256_cmpeq_epi8(b, tail))));
+
+            while (mask != 0)
+            {
+                unsigned int bit = static_cast<unsigned int>(__builtin_ctz(mask));
+                if (matchesAt(it + bit))
+                    return it + bit;
+                mask &= mask - 1;
+            }
+        }
+
+        return it < stop ? findSSE2(it, last) : nullptr;
+    }
+#else
+    const char* Prefilter::findSSE2(const char *first, const char *last) const {
+        return findScalar(first, last);
+    }
+
+    const char* Prefilter::findAVX2(const char *first, const char *last) const {
+        return findScalar(first, last);
+    }
+#endif
+}
@@ -0,0 +1,96 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file Prefilter.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the class Prefilter.
+ *
+ * # Description
+ * This file contains the declarations of a fast substring search, which lets the matchers skip the parts
+ * of a string where no match can be.
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#ifndef MYREGEX_PREFILTER_H
+#define MYREGEX_PREFILTER_H
+
+#include <string>
+
+namespace Automata {
+
+    /** @class Prefilter
+     * @author Carlos Brito (carlos.brito524@gmail.com)
+     * @date 10/14/26.
+     *
+     * @brief Finds the occurrences of a literal string
+     *
+     * # Description
+     * The search compares the first and the last byte of the literal against 16 (SSE2) or 32 (AVX2)
+     * positions of the string at once, and only compares the rest of the literal at the positions where
+     * both agree. So on text which rarely contains the literal most of the bytes are looked at once, in
+     * a vector register. A literal of a single byte is searched with `memchr`.
+     *
+     * The widest instruction set supported by the processor is picked once, on construction. Where
+     * neither is available the search falls back to `memchr` on the first byte of the literal.
+     */
+    class Prefilter {
+    public:
+        /// Constructs a prefilter for the empty literal, which is found everywhere
+        Prefilter();
+
+        /// Constructs a prefilter for a literal
+        explicit Prefilter(std::string const& literal);
+
+        /// Returns the first occurrence of the literal in \f$ [first, last) \f$, or `nullptr` if there is none
+        const char* find(const char* first, const char* last) const;
+
+        /// Returns the literal
+        std::string const& literal() const;
+
+        /// Returns true if the literal is empty
+        bool empty() const;
+
+    private:
+        /// How find() searches
+        enum Method {
+            METHOD_SCALAR,
+            METHOD_SSE2,
+            METHOD_AVX2
+        };
+
+        const char* findScalar(const char* first, const char* last) const;
+        const char* findSSE2(const char* first, const char* last) const;
+        const char* findAVX2(const char* first, const char* last) const;
+
+        /// Returns true if the literal is at it, given its first and last bytes already match
+        bool matchesAt(const char* it) const;
+
+        std::string literal_;
+        Method method_;
+    };
+}
+
+#endif //MYREGEX_PREFILTER_H
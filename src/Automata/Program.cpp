@@ -0,0 +1,769 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file Program.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26
+ *
+ * # Description
+ * This is the .cpp file which contains the implementation for all the methods declared in the header file Program.h
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <utility>
+
+#include "Program.h"
+#include "AutomataErrors.h"
+#include "../IO/Image.h"
+
+namespace Automata {
+
+    namespace {
+        bool edge_less(Program::Edge const& lhs, Program::Edge const& rhs) {
+            if (lhs.first != rhs.first)
+                return lhs.first < rhs.first;
+            if (lhs.last != rhs.last)
+                return lhs.last < rhs.last;
+            return lhs.target < rhs.target;
+        }
+
+        bool edge_equal(Program::Edge const& lhs, Program::Edge const& rhs) {
+            return lhs.first == rhs.first && lhs.last == rhs.last && lhs.target == rhs.target;
+        }
+
+        bool reversed_edge_less(std::pair<Program::state_id, Program::Edge> const& lhs,
+                                std::pair<Program::state_id, Program::Edge> const& rhs) {
+            return lhs.first < rhs.first || (lhs.first == rhs.first && edge_less(lhs.second, rhs.second));
+        }
+
+        bool edge_target_less(Program::Edge const& lhs, Program::Edge const& rhs) {
+            return lhs.target < rhs.target || (lhs.target == rhs.target && lhs.first < rhs.first);
+        }
+
+        /// Joins the transitions of a row to the same target on overlapping or adjacent ranges, then sorts it
+        void join_ranges(std::vector<Program::Edge> &row) {
+            if (row.size() < 2)
+                return;
+
+            std::sort(row.begin(), row.end(), edge_target_less);
+            size_t last = 0;
+            for (size_t i = 1; i < row.size(); i++)
+            {
+                Program::Edge &joined = row[last];
+                if (row[i].target == joined.target && row[i].first <= joined.last + 1)
+                    joined.last = std::max(joined.last, row[i].last);
+                else
+                    row[++last] = row[i];
+            }
+            row.resize(last + 1);
+            std::sort(row.begin(), row.end(), edge_less);
+        }
+
+        const char image_magic[8] = {'M', 'Y', 'R', 'X', 'P', 'R', 'O', 'G'};
+        const uint32_t byte_order_mark = 0x01020304;
+
+        /// Returns true if offsets are the rows of a CSR array of count entries whose values are below n
+        bool valid_offsets(const uint32_t* offsets, size_t n, size_t count) {
+            if (offsets[0] != 0 || offsets[n] != count)
+                return false;
+
+            for (size_t s = 0; s < n; s++)
+                if (offsets[s] > offsets[s + 1])
+                    return false;
+
+            return true;
+        }
+    }
+
+    const size_t Program::alphabet_size;
+    const uint32_t Program::image_version;
+    const size_t Program::default_max_growth;
+    const uint32_t Program::no_slot;
+    const size_t Program::no_position;
+
+    Program::Program()
+            : edgeOffsets_(1, 0),
+              epsilonOffsets_(1, 0),
+              slotCount_(0),
+              groupCount_(0)
+    {
+        bind();
+    }
+
+    Program::Program(Program const &other)
+            : edgeOffsets_(other.edgeOffsets_),
+              edges_(other.edges_),
+              epsilonOffsets_(other.epsilonOffsets_),
+              epsilon_(other.epsilon_),
+              isEnd_(other.isEnd_),
+              slots_(other.slots_),
+              inPlace_(other.inPlace_),
+              storage_(other.storage_),
+              stateCount_(other.stateCount_),
+              edgeCount_(other.edgeCount_),
+              epsilonCount_(other.epsilonCount_),
+              slotCount_(other.slotCount_),
+              groupCount_(other.groupCount_),
+              edgeOffsetsData_(other.edgeOffsetsData_),
+              edgesData_(other.edgesData_),
+              epsilonOffsetsData_(other.epsilonOffsetsData_),
+              epsilonData_(other.epsilonData_),
+              isEndData_(other.isEndData_),
+              slotsData_(other.slotsData_)
+    {
+        if (!inPlace_)
+            bind();
+    }
+
+    Program& Program::operator=(Program const &other) {
+        if (this != &other)
+        {
+            edgeOffsets_ = other.edgeOffsets_;
+            edges_ = other.edges_;
+            epsilonOffsets_ = other.epsilonOffsets_;
+            epsilon_ = other.epsilon_;
+            isEnd_ = other.isEnd_;
+            slots_ = other.slots_;
+            inPlace_ = other.inPlace_;
+            storage_ = other.storage_;
+            stateCount_ = other.stateCount_;
+            edgeCount_ = other.edgeCount_;
+            epsilonCount_ = other.epsilonCount_;
+            slotCount_ = other.slotCount_;
+            groupCount_ = other.groupCount_;
+            edgeOffsetsData_ = other.edgeOffsetsData_;
+            edgesData_ = other.edgesData_;
+            epsilonOffsetsData_ = other.epsilonOffsetsData_;
+            epsilonData_ = other.epsilonData_;
+            isEndData_ = other.isEndData_;
+            slotsData_ = other.slotsData_;
+
+            if (!inPlace_)
+                bind();
+        }
+        return *this;
+    }
+
+    Program::Program(Program &&other) {
+        take(other);
+    }
+
+    Program& Program::operator=(Program &&other) {
+        if (this != &other)
+            take(other);
+        return *this;
+    }
+
+    void Program::take(Program &other) {
+        // moving a vector keeps its buffer, so a program reading its own vectors still does
+        edgeOffsets_ = std::move(other.edgeOffsets_);
+        edges_ = std::move(other.edges_);
+        epsilonOffsets_ = std::move(other.epsilonOffsets_);
+        epsilon_ = std::move(other.epsilon_);
+        isEnd_ = std::move(other.isEnd_);
+        slots_ = std::move(other.slots_);
+        inPlace_ = other.inPlace_;
+        storage_ = std::move(other.storage_);
+        stateCount_ = other.stateCount_;
+        edgeCount_ = other.edgeCount_;
+        epsilonCount_ = other.epsilonCount_;
+        slotCount_ = other.slotCount_;
+        groupCount_ = other.groupCount_;
+        edgeOffsetsData_ = other.edgeOffsetsData_;
+        edgesData_ = other.edgesData_;
+        epsilonOffsetsData_ = other.epsilonOffsetsData_;
+        epsilonData_ = other.epsilonData_;
+        isEndData_ = other.isEndData_;
+        slotsData_ = other.slotsData_;
+
+        other.edgeOffsets_.assign(1, 0);
+        other.edges_.clear();
+        other.epsilonOffsets_.assign(1, 0);
+        other.epsilon_.clear();
+        other.isEnd_.clear();
+        other.slots_.clear();
+        other.slotCount_ = 0;
+        other.groupCount_ = 0;
+        other.storage_.reset();
+        other.bind();
+    }
+
+    Program::Program(NFA const &nfa)
+            : edgeOffsets_(1, 0),
+              epsilonOffsets_(1, 0),
+              slotCount_(0),
+              groupCount_(0)
+    {
+        const uint32_t unnumbered = 0xFFFFFFFF;
+        NFA::state_table_type const& table = nfa.table();
+
+        // Number the states in breadth first order, the initial state is 0
+        flat_hashtable<State const*, uint32_t> index(table.count() + 1);
+        for (NFA::state_table_type::const_iterator entry_it = table.cbegin(); entry_it != table.cend(); entry_it++)
+            index.insert(entry_it->second, unnumbered);
+
+        std::vector<State const*> order;
+        order.push_back(nfa.initialState());
+        index.at(nfa.initialState()) = 0;
+
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            State::transition_set_type const& transitions = order[i]->transition_set();
+            for (State::transition_set_type::const_iterator t_it = transitions.cbegin();
+                 t_it != transitions.cend(); t_it++)
+            {
+                flat_hashtable<State const*, uint32_t>::iterator dest = index.find((*t_it).destination());
+                if (dest == index.end())
+                    throw StateNotFoundError((*t_it).destination()->name());
+
+                if (dest->second == unnumbered)
+                {
+                    dest->second = static_cast<uint32_t>(order.size());
+                    order.push_back((*t_it).destination());
+                }
+            }
+        }
+
+        // Lay out the transitions
+        isEnd_.reserve(order.size());
+        edgeOffsets_.reserve(order.size() + 1);
+        epsilonOffsets_.reserve(order.size() + 1);
+
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            isEnd_.push_back(order[i]->isEnd() ? 1 : 0);
+
+            size_t first_edge = edges_.size();
+            size_t first_epsilon = epsilon_.size();
+
+            State::transition_set_type const& transitions = order[i]->transition_set();
+            for (State::transition_set_type::const_iterator t_it = transitions.cbegin();
+                 t_it != transitions.cend(); t_it++)
+            {
+                Transition const& t = *t_it;
+                state_id target = index.at(t.destination());
+
+                if (t.symbol() == NFA::epsilon)
+                    epsilon_.push_back(target);
+                else
+                {
+                    Edge e;
+                    e.first = static_cast<unsigned char>(t.symbol());
+                    e.last = e.first;
+                    e.target = target;
+                    edges_.push_back(e);
+                }
+            }
+
+            std::sort(edges_.begin() + first_edge, edges_.end(), edge_less);
+            edges_.erase(std::unique(edges_.begin() + first_edge, edges_.end(), edge_equal), edges_.end());
+
+            std::sort(epsilon_.begin() + first_epsilon, epsilon_.end());
+            epsilon_.erase(std::unique(epsilon_.begin() + first_epsilon, epsilon_.end()), epsilon_.end());
+
+            edgeOffsets_.push_back(static_cast<uint32_t>(edges_.size()));
+            epsilonOffsets_.push_back(static_cast<uint32_t>(epsilon_.size()));
+        }
+
+        // Release the slack of the vectors
+        std::vector<Edge>(edges_).swap(edges_);
+        std::vector<state_id>(epsilon_).swap(epsilon_);
+        bind();
+    }
+
+    Program Program::reversed() const {
+        Program result;
+        size_t n = state_count();
+        if (n == 0)
+            return result;
+
+        // Turn every transition around, source of the result first
+        std::vector<std::pair<state_id, Edge> > edges;
+        std::vector<std::pair<state_id, state_id> > epsilon;
+        edges.reserve(edges_.size());
+        epsilon.reserve(epsilon_.size() + n);
+
+        for (state_id s = 0; s < n; s++)
+        {
+            for (Edge const* it = edges_begin(s); it != edges_end(s); it++)
+            {
+                Edge e = *it;
+                e.target = s + 1;
+                edges.push_back(std::make_pair(it->target + 1, e));
+            }
+
+            for (state_id const* it = epsilon_begin(s); it != epsilon_end(s); it++)
+                epsilon.push_back(std::make_pair(*it + 1, s + 1));
+
+            if (isEnd(s))
+                epsilon.push_back(std::make_pair(0u, s + 1));
+        }
+
+        std::sort(edges.begin(), edges.end(), reversed_edge_less);
+        std::sort(epsilon.begin(), epsilon.end());
+
+        // Lay them out
+        result.edges_.reserve(edges.size());
+        result.epsilon_.reserve(epsilon.size());
+        result.edgeOffsets_.reserve(n + 2);
+        result.epsilonOffsets_.reserve(n + 2);
+
+        size_t e_it = 0;
+        size_t eps_it = 0;
+        for (state_id s = 0; s <= n; s++)
+        {
+            for (; e_it < edges.size() && edges[e_it].first == s; e_it++)
+                result.edges_.push_back(edges[e_it].second);
+            for (; eps_it < epsilon.size() && epsilon[eps_it].first == s; eps_it++)
+                result.epsilon_.push_back(epsilon[eps_it].second);
+
+            result.edgeOffsets_.push_back(static_cast<uint32_t>(result.edges_.size()));
+            result.epsilonOffsets_.push_back(static_cast<uint32_t>(result.epsilon_.size()));
+        }
+
+        result.isEnd_.assign(n + 1, 0);
+        result.isEnd_[start() + 1] = 1;
+        result.bind();
+
+        return result;
+    }
+
+    Program Program::unite(std::vector<Program const*> const &programs, std::vector<state_id> &offsets) {
+        Program result;
+        offsets.clear();
+
+        state_id next = 1;
+        for (size_t i = 0; i < programs.size(); i++)
+        {
+            offsets.push_back(next);
+            next += static_cast<state_id>(programs[i]->state_count());
+        }
+        offsets.push_back(next);
+
+        result.isEnd_.reserve(next);
+        result.edgeOffsets_.reserve(next + 1);
+        result.epsilonOffsets_.reserve(next + 1);
+
+        // the new initial state
+        result.isEnd_.push_back(0);
+        for (size_t i = 0; i < programs.size(); i++)
+            if (programs[i]->state_count() > 0)
+                result.epsilon_.push_back(offsets[i] + programs[i]->start());
+        result.edgeOffsets_.push_back(0);
+        result.epsilonOffsets_.push_back(static_cast<uint32_t>(result.epsilon_.size()));
+
+        for (size_t i = 0; i < programs.size(); i++)
+        {
+            Program const& p = *programs[i];
+            state_id offset = offsets[i];
+            for (state_id s = 0; s < p.state_count(); s++)
+            {
+                result.isEnd_.push_back(p.isEnd(s) ? 1 : 0);
+
+                for (Edge const* it = p.edges_begin(s); it != p.edges_end(s); it++)
+                {
+                    Edge e = *it;
+                    e.target = it->target + offset;
+                    result.edges_.push_back(e);
+                }
+
+                for (state_id const* it = p.epsilon_begin(s); it != p.epsilon_end(s); it++)
+                    result.epsilon_.push_back(*it + offset);
+
+                result.edgeOffsets_.push_back(static_cast<uint32_t>(result.edges_.size()));
+                result.epsilonOffsets_.push_back(static_cast<uint32_t>(result.epsilon_.size()));
+            }
+        }
+
+        result.bind();
+        return result;
+    }
+
+    Program Program::epsilon_free(size_t max_edges) const {
+        size_t n = state_count();
+        if (n == 0)
+            return Program();
+
+        // only the initial state and the targets of transitions on a symbol are left
+        std::vector<uint8_t> kept(n, 0);
+        kept[start()] = 1;
+        for (state_id s = 0; s < n; s++)
+            for (Edge const* it = edges_begin(s); it != edges_end(s); it++)
+                kept[it->target] = 1;
+
+        std::vector<std::vector<Edge> > edges(n);
+        std::vector<std::vector<state_id> > epsilon(n);
+        std::vector<uint8_t> ends(n, 0);
+
+        // mark[t] == s + 1 once t is in the closure of s
+        std::vector<state_id> mark(n, 0);
+        std::vector<state_id> stack;
+        size_t total = 0;
+
+        for (state_id s = 0; s < n; s++)
+        {
+            if (!kept[s])
+                continue;
+
+            std::vector<Edge> &row = edges[s];
+            mark[s] = s + 1;
+            stack.push_back(s);
+            while (!stack.empty())
+            {
+                state_id t = stack.back();
+                stack.pop_back();
+
+                if (isEnd(t))
+                    ends[s] = 1;
+                row.insert(row.end(), edges_begin(t), edges_end(t));
+
+                for (state_id const* it = epsilon_begin(t); it != epsilon_end(t); it++)
+                    if (mark[*it] != s + 1)
+                    {
+                        mark[*it] = s + 1;
+                        stack.push_back(*it);
+                    }
+            }
+
+            join_ranges(row);
+            total += row.size();
+            if (max_edges > 0 && total > max_edges)
+                return *this;
+        }
+
+        return layout(edges, epsilon, ends);
+    }
+
+    Program Program::merged() const {
+        Program current = *this;
+
+        std::vector<uint32_t> signature;
+        for (;;)
+        {
+            size_t n = current.state_count();
+
+            // states with the same signature are equivalent. The initial state is in class 0.
+            std::map<std::vector<uint32_t>, state_id> classes;
+            std::vector<state_id> class_of(n);
+            std::vector<state_id> representative;
+            for (state_id s = 0; s < n; s++)
+            {
+                signature.clear();
+                signature.push_back(current.isEnd(s) ? 1 : 0);
+                signature.push_back(static_cast<uint32_t>(current.edges_end(s) - current.edges_begin(s)));
+                for (Edge const* it = current.edges_begin(s); it != current.edges_end(s); it++)
+                {
+                    signature.push_back(it->first);
+                    signature.push_back(it->last);
+                    signature.push_back(it->target);
+                }
+                signature.insert(signature.end(), current.epsilon_begin(s), current.epsilon_end(s));
+
+                std::pair<std::map<std::vector<uint32_t>, state_id>::iterator, bool> inserted =
+                        classes.insert(std::make_pair(signature, static_cast<state_id>(classes.size())));
+                if (inserted.second)
+                    representative.push_back(s);
+                class_of[s] = inserted.first->second;
+            }
+
+            if (classes.size() == n)
+                return current;
+
+            // one state for each class, with the transitions of its representative
+            std::vector<std::vector<Edge> > edges(classes.size());
+            std::vector<std::vector<state_id> > epsilon(classes.size());
+            std::vector<uint8_t> isEnd(classes.size());
+            for (state_id c = 0; c < classes.size(); c++)
+            {
+                state_id s = representative[c];
+                isEnd[c] = current.isEnd(s) ? 1 : 0;
+
+                for (Edge const* it = current.edges_begin(s); it != current.edges_end(s); it++)
+                {
+                    Edge e = *it;
+                    e.target = class_of[it->target];
+                    edges[c].push_back(e);
+                }
+
+                for (state_id const* it = current.epsilon_begin(s); it != current.epsilon_end(s); it++)
+                    epsilon[c].push_back(class_of[*it]);
+            }
+
+            current = layout(edges, epsilon, isEnd);
+        }
+    }
+
+    Program Program::simplified(size_t max_growth) const {
+        size_t max_edges = max_growth * (edge_count() + epsilon_count()) + alphabet_size;
+        if (epsilon_count() == 0)
+            return merged();
+
+        Program result = epsilon_free(max_edges);
+        if (result.epsilon_count() > 0) // it grew too much, merge the Thompson automaton as it is
+            return merged();
+
+        return result.merged();
+    }
+
+    Program Program::layout(std::vector<std::vector<Edge> > &edges,
+                            std::vector<std::vector<state_id> > const &epsilon,
+                            std::vector<uint8_t> const &isEnd) {
+        const state_id unnumbered = 0xFFFFFFFF;
+        Program result;
+        size_t n = isEnd.size();
+        if (n == 0)
+            return result;
+
+        // Number the states in breadth first order, the initial state is 0
+        std::vector<state_id> index(n, unnumbered);
+        std::vector<state_id> order;
+        order.push_back(0);
+        index[0] = 0;
+
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            std::vector<Edge> const& row = edges[order[i]];
+            std::vector<state_id> const& closure = epsilon[order[i]];
+            for (size_t j = 0; j < row.size() + closure.size(); j++)
+            {
+                state_id target = j < row.size() ? row[j].target : closure[j - row.size()];
+                if (index[target] == unnumbered)
+                {
+                    index[target] = static_cast<state_id>(order.size());
+                    order.push_back(target);
+                }
+            }
+        }
+
+        // Lay out the transitions
+        result.isEnd_.reserve(order.size());
+        result.edgeOffsets_.reserve(order.size() + 1);
+        result.epsilonOffsets_.reserve(order.size() + 1);
+
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            result.isEnd_.push_back(isEnd[order[i]]);
+
+            std::vector<Edge> &row = edges[order[i]];
+            for (size_t j = 0; j < row.size(); j++)
+                row[j].target = index[row[j].target];
+            join_ranges(row);
+            result.edges_.insert(result.edges_.end(), row.begin(), row.end());
+
+            // the first of the transitions to a same state is the preferred one, keep it alone
+            size_t first_epsilon = result.epsilon_.size();
+            std::vector<state_id> const& closure = epsilon[order[i]];
+            for (size_t j = 0; j < closure.size(); j++)
+                if (std::find(result.epsilon_.begin() + first_epsilon, result.epsilon_.end(), index[closure[j]])
+                    == result.epsilon_.end())
+                    result.epsilon_.push_back(index[closure[j]]);
+
+            result.edgeOffsets_.push_back(static_cast<uint32_t>(result.edges_.size()));
+            result.epsilonOffsets_.push_back(static_cast<uint32_t>(result.epsilon_.size()));
+        }
+
+        result.bind();
+        return result;
+    }
+
+    size_t Program::edge_count() const {
+        return edgeCount_;
+    }
+
+    size_t Program::epsilon_count() const {
+        return epsilonCount_;
+    }
+
+    bool Program::isDeterministic() const {
+        if (epsilonCount_ > 0)
+            return false;
+
+        for (state_id s = 0; s < state_count(); s++)
+            for (Edge const* e = edges_begin(s); e != edges_end(s); e++)
+                if (e != edges_begin(s) && e->first <= e[-1].last) // the edges are sorted by first
+                    return false;
+
+        return true;
+    }
+
+    size_t Program::byte_classes(std::vector<uint8_t> &class_of) const {
+        // a class starts at every byte where a range starts or which follows the end of one
+        std::vector<uint8_t> starts(alphabet_size + 1, 0);
+        for (size_t i = 0; i < edgeCount_; i++)
+        {
+            starts[edgesData_[i].first] = 1;
+            starts[edgesData_[i].last + 1] = 1;
+        }
+
+        class_of.resize(alphabet_size);
+        size_t k = 0;
+        for (size_t c = 0; c < alphabet_size; c++)
+        {
+            if (starts[c] && c > 0)
+                k++;
+            class_of[c] = static_cast<uint8_t>(k);
+        }
+        return k + 1;
+    }
+
+    size_t Program::memory_size() const {
+        return sizeof(Program)
+               + (stateCount_ + 1) * sizeof(uint32_t)
+               + edgeCount_ * sizeof(Edge)
+               + (stateCount_ + 1) * sizeof(uint32_t)
+               + epsilonCount_ * sizeof(state_id)
+               + stateCount_ * sizeof(uint8_t)
+               + (slotsData_ ? stateCount_ * sizeof(uint32_t) : 0);
+    }
+
+    void Program::save(std::vector<char> &image) const {
+        ImageWriter writer(image);
+
+        writer.write(image_magic, sizeof(image_magic));
+        writer.write(image_version);
+        writer.write(byte_order_mark);
+        writer.write(static_cast<uint32_t>(sizeof(Edge)));
+        writer.write(static_cast<uint32_t>(offsetof(Edge, target)));
+        writer.write(static_cast<uint32_t>(stateCount_));
+        writer.write(static_cast<uint32_t>(edgeCount_));
+        writer.write(static_cast<uint32_t>(epsilonCount_));
+        writer.write(static_cast<uint32_t>(slotCount_));
+        writer.write(static_cast<uint32_t>(groupCount_));
+
+        writer.write_array(edgeOffsetsData_, stateCount_ + 1);
+
+        // edges one by one, so the padding of Edge is written as zeroes
+        writer.align();
+        for (size_t i = 0; i < edgeCount_; i++)
+        {
+            char record[sizeof(Edge)] = {0};
+            record[offsetof(Edge, first)] = static_cast<char>(edgesData_[i].first);
+            record[offsetof(Edge, last)] = static_cast<char>(edgesData_[i].last);
+            std::memcpy(record + offsetof(Edge, target), &edgesData_[i].target, sizeof(state_id));
+            writer.write(record, sizeof(record));
+        }
+
+        writer.write_array(epsilonOffsetsData_, stateCount_ + 1);
+        writer.write_array(epsilonData_, epsilonCount_);
+        writer.write_array(isEndData_, stateCount_);
+        if (slotCount_ > 0)
+            writer.write_array(slotsData_, stateCount_);
+        writer.align();
+    }
+
+    Program Program::load(const char *first, const char *last, const char *&next,
+                          std::shared_ptr<const void> const &storage) {
+        ImageReader reader(first, last);
+
+        const char* magic = reader.read(sizeof(image_magic));
+        if (!magic || std::memcmp(magic, image_magic, sizeof(image_magic)) != 0)
+            throw InvalidImageError("not a program");
+
+        uint32_t version, byte_order, edge_size, target_offset, state_count, edge_count, epsilon_count, slot_count;
+        uint32_t group_count;
+        if (!reader.read_value(version) || !reader.read_value(byte_order) || !reader.read_value(edge_size)
+            || !reader.read_value(target_offset) || !reader.read_value(state_count) || !reader.read_value(edge_count)
+            || !reader.read_value(epsilon_count) || !reader.read_value(slot_count)
+            || !reader.read_value(group_count))
+            throw InvalidImageError("truncated program header");
+
+        if (version != image_version)
+            throw InvalidImageError("unsupported program version " + std::to_string(version));
+
+        if (byte_order != byte_order_mark || edge_size != sizeof(Edge) || target_offset != offsetof(Edge, target))
+            throw InvalidImageError("program saved on an incompatible machine");
+
+        Program program;
+        program.inPlace_ = true;
+        program.storage_ = storage;
+        program.stateCount_ = state_count;
+        program.edgeCount_ = edge_count;
+        program.epsilonCount_ = epsilon_count;
+        program.slotCount_ = slot_count;
+        program.groupCount_ = group_count;
+        program.edgeOffsetsData_ = reader.read_array<uint32_t>(static_cast<size_t>(state_count) + 1);
+        program.edgesData_ = reader.read_array<Edge>(edge_count);
+        program.epsilonOffsetsData_ = reader.read_array<uint32_t>(static_cast<size_t>(state_count) + 1);
+        program.epsilonData_ = reader.read_array<state_id>(epsilon_count);
+        program.isEndData_ = reader.read_array<uint8_t>(state_count);
+        if (slot_count > 0)
+            program.slotsData_ = reader.read_array<uint32_t>(state_count);
+
+        if (!program.edgeOffsetsData_ || !program.edgesData_ || !program.epsilonOffsetsData_
+            || !program.epsilonData_ || !program.isEndData_ || (slot_count > 0 && !program.slotsData_)
+            || !reader.align())
+            throw InvalidImageError("truncated program");
+
+        // a corrupted image must not make the matchers read out of the arrays
+        if (!valid_offsets(program.edgeOffsetsData_, state_count, edge_count)
+            || !valid_offsets(program.epsilonOffsetsData_, state_count, epsilon_count))
+            throw InvalidImageError("corrupted program offsets");
+
+        for (size_t i = 0; i < edge_count; i++)
+            if (program.edgesData_[i].target >= state_count || program.edgesData_[i].first > program.edgesData_[i].last)
+                throw InvalidImageError("corrupted program transitions");
+
+        for (size_t i = 0; i < epsilon_count; i++)
+            if (program.epsilonData_[i] >= state_count)
+                throw InvalidImageError("corrupted program transitions");
+
+        // the matchers allocate slot_count() slots per state, it must be the one the slots of the states call for
+        size_t used_slots = 0;
+        for (size_t s = 0; program.slotsData_ && s < state_count; s++)
+        {
+            size_t slot = program.slotsData_[s];
+            if (slot == no_slot)
+                continue;
+            if (slot >= slot_count) // the matchers index their slot arrays with it
+                throw InvalidImageError("corrupted program slots");
+            used_slots = std::max(used_slots, slot / 2 * 2 + 2);
+        }
+        if (slot_count != used_slots || group_count < slot_count / 2 || (slot_count == 0 && group_count != 0))
+            throw InvalidImageError("corrupted program slots");
+
+        // the vectors aren't used, release them
+        program.edgeOffsets_.clear();
+        program.epsilonOffsets_.clear();
+
+        next = reader.position();
+        return program;
+    }
+
+    void Program::bind() {
+        inPlace_ = false;
+        stateCount_ = isEnd_.size();
+        edgeCount_ = edges_.size();
+        epsilonCount_ = epsilon_.size();
+        edgeOffsetsData_ = edgeOffsets_.data();
+        edgesData_ = edges_.data();
+        epsilonOffsetsData_ = epsilonOffsets_.data();
+        epsilonData_ = epsilon_.data();
+        isEndData_ = isEnd_.data();
+        slotsData_ = slots_.empty() ? nullptr : slots_.data();
+    }
+}
@@ -0,0 +1,392 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file Program.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the class Program.
+ *
+ * # Description
+ * This file contains the declarations of the compiled, flattened form of an NFA which every matcher runs on.
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#ifndef MYREGEX_PROGRAM_H
+#define MYREGEX_PROGRAM_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "NFA.h"
+
+namespace Automata {
+
+    /** @class Program
+     * @author Carlos Brito (carlos.brito524@gmail.com)
+     * @date 10/14/26.
+     *
+     * @brief Compiled, read-only form of an NFA
+     *
+     * # Description
+     * An NFA is convenient to build but slow to run: its states live in a hashtable keyed by name and
+     * every transition set is a hashtable of its own. A Program is the same automaton flattened into a
+     * handful of contiguous arrays:
+     *
+     * - States are numbered from 0 to `state_count() - 1` in breadth first order from the initial state,
+     * which is always state 0. States which can't be reached from it are dropped.
+     * - The transitions on a symbol are stored in compressed sparse row form: the transitions of state `s`
+     * are `edges_[edgeOffsets_[s]]` up to `edges_[edgeOffsets_[s + 1]]`, sorted by their first byte. Each
+     * one is taken on a range of bytes, so a class like `[a-z]` costs a single transition.
+     * - The epsilon transitions are stored apart in the same form, so matchers computing closures never
+     * look at the other ones. When the program comes from a ProgramBuilder they are kept in order of
+     * preference.
+     * - A state with a single epsilon transition may save the position it is reached at in a capture slot,
+     * see slot(). Only programs made by a ProgramBuilder have slots, the other constructors and passes
+     * treat these states as plain epsilon transitions and drop their slots.
+     *
+     * A Program is never modified once built, so it can be shared by any number of matchers.
+     *
+     * # Images
+     * save() lays the arrays out in a binary image, and load() makes a Program which reads them right
+     * where they lie in the image, for example in a file mapped in memory, without copying them. The
+     * image is checked on load, but it is only valid on machines with the same byte order and layout of
+     * Edge as the one which saved it.
+     */
+    class Program {
+        friend class ProgramBuilder;
+
+    public:
+        /// Identifier for a state
+        typedef uint32_t state_id;
+
+        /// A transition on a range of symbols
+        struct Edge {
+            /// First symbol of the range
+            unsigned char first;
+
+            /// Last symbol of the range, which is part of it
+            unsigned char last;
+
+            /// Destination state
+            state_id target;
+
+            /// Returns true if the transition is taken on symbol c
+            bool contains(unsigned char c) const {
+                return first <= c && c <= last;
+            }
+        };
+
+        /// Number of symbols
+        static const size_t alphabet_size = 256;
+
+        /// Version of the binary image made by save()
+        static const uint32_t image_version = 4;
+
+        /// Slot of a state which doesn't save its position
+        static const uint32_t no_slot = 0xFFFFFFFF;
+
+        /// Value the matchers leave in a capture slot whose save state wasn't part of the match
+        static const size_t no_position = static_cast<size_t>(-1);
+
+        /// Default bound of simplified() on the growth of the number of transitions
+        static const size_t default_max_growth = 4;
+
+        /// Constructs an empty program which has no states
+        Program();
+
+        /// Copies a program. The copy of a loaded program reads the same image.
+        Program(Program const& other);
+
+        /// Copies a program. The copy of a loaded program reads the same image.
+        Program& operator=(Program const& other);
+
+        /// Moves a program without copying its arrays. The moved from program is left without states.
+        Program(Program&& other);
+
+        /// Moves a program without copying its arrays. The moved from program is left without states.
+        Program& operator=(Program&& other);
+
+        /// Compiles an NFA into a program
+        /**
+         * # Complexity
+         * \f$ O(n + m) \f$ where \f$ n \f$ is the number of states and \f$ m \f$ the number of transitions
+         *
+         * @param nfa Automaton to compile
+         */
+        explicit Program(NFA const& nfa);
+
+        /// Returns the automaton which accepts the reverse of every string this one accepts
+        /**
+         * State 0 of the result is a new initial state with an epsilon transition to every final state,
+         * state \f$ s + 1 \f$ is state \f$ s \f$ of this program with its transitions turned around, and
+         * the only final state is the old initial state. The order of preference of the epsilon
+         * transitions is not kept.
+         *
+         * # Complexity
+         * \f$ O(n + m \log m) \f$ where \f$ n \f$ is the number of states and \f$ m \f$ the number of
+         * transitions
+         */
+        Program reversed() const;
+
+        /// Returns the automaton which accepts every string one of the programs accepts
+        /**
+         * State 0 of the result is a new initial state with an epsilon transition to the initial state of
+         * every program, in order of preference. The states of program \f$ i \f$ follow, numbered from
+         * `offsets[i]`, so each final state of the result can be traced back to the program it comes from.
+         *
+         * # Complexity
+         * \f$ O(n + m) \f$ where \f$ n \f$ is the total number of states and \f$ m \f$ of transitions
+         *
+         * @param programs Programs to unite
+         * @param offsets Set to the number of the first state of each program in the result, plus one past
+         * the last state
+         */
+        static Program unite(std::vector<Program const*> const& programs, std::vector<state_id> &offsets);
+
+        /// Returns the same automaton without epsilon transitions
+        /**
+         * Each state takes the transitions of every state of its epsilon closure, and is final if one of them
+         * is. The states which were only reached through epsilon transitions can't be reached anymore and are
+         * dropped, then the transitions of a state to the same target on adjacent ranges are joined.
+         *
+         * The order of preference of the epsilon transitions is lost, so the result accepts the same strings
+         * but doesn't suit a leftmost first search (LazyDFA::MODE_UNANCHORED).
+         *
+         * # Complexity
+         * \f$ O(n c + m \log m) \f$ where \f$ n \f$ is the number of states, \f$ c \f$ the size of the
+         * largest epsilon closure and \f$ m \f$ the number of transitions of the result
+         *
+         * @param max_edges Largest number of transitions of the result, 0 for no limit. If there would be
+         * more, a copy of this program is returned instead.
+         */
+        Program epsilon_free(size_t max_edges = 0) const;
+
+        /// Returns the same automaton with its equivalent states merged
+        /**
+         * Two states are equivalent if both are final or neither is and they have the same transitions, to
+         * the same targets. Merging states may make their predecessors equivalent in turn, so the merge is
+         * repeated until no two states are equivalent, which for instance shares the common suffixes of the
+         * alternatives of `abc|xbc`. Epsilon transitions are compared and kept in order of preference.
+         *
+         * # Complexity
+         * \f$ O(k m \log n) \f$ where \f$ k \f$ is the number of rounds of merges, one more than the
+         * length of the longest chain of merges
+         */
+        Program merged() const;
+
+        /// Returns the automaton the matchers should run: epsilon_free() then merged()
+        /**
+         * The passes leave out the epsilon transitions and the states the Thompson construction chains with
+         * them, so the closures the matchers compute at every byte are trivial and their sets of states are
+         * several times smaller. Like epsilon_free(), the result doesn't suit a leftmost first search.
+         *
+         * @param max_growth If removing the epsilon transitions would make more than this many times more
+         * transitions than there are transitions and epsilon transitions now, they are kept and only
+         * merged() is applied
+         */
+        Program simplified(size_t max_growth = default_max_growth) const;
+
+        /// Returns the number of states
+        size_t state_count() const;
+
+        /// Returns the number of transitions, not counting epsilon transitions
+        size_t edge_count() const;
+
+        /// Returns the number of epsilon transitions
+        size_t epsilon_count() const;
+
+        /// Returns true if no state has epsilon transitions or two transitions on the same byte
+        bool isDeterministic() const;
+
+        /// Partitions the bytes into the classes which no transition tells apart
+        /**
+         * Two bytes are in the same class if every transition is taken on both or on neither of them.
+         * The classes are ranges of bytes and are numbered in increasing order of their bytes, so the
+         * bytes of a transition are those of the classes `class_of[e.first]` up to `class_of[e.last]`.
+         *
+         * @param class_of Set to the class of each of the 256 bytes
+         * @return Number of classes
+         */
+        size_t byte_classes(std::vector<uint8_t>& class_of) const;
+
+        /// Returns the initial state
+        state_id start() const;
+
+        /// Returns true if the state is final
+        bool isEnd(state_id s) const;
+
+        /// Returns the number of capture slots, 0 if the program has none
+        /**
+         * Group \f$ g \f$ of the pattern starts at the position saved in slot \f$ 2g \f$ and ends at the
+         * one saved in slot \f$ 2g + 1 \f$, see ProgramBuilder::capture().
+         */
+        size_t slot_count() const;
+
+        /// Returns the number of groups of the pattern, group 0 included, 0 if the program has no slots
+        /**
+         * A group repeated `{0,0}` has no save state left, so the count can be larger than the one of the
+         * groups which have slots, slot_count() / 2. Such a group never takes part in a match.
+         */
+        size_t group_count() const;
+
+        /// Returns the capture slot state s saves the position in, or no_slot
+        uint32_t slot(state_id s) const;
+
+        /// Returns a pointer to the first transition of state s
+        Edge const* edges_begin(state_id s) const;
+
+        /// Returns a pointer past the last transition of state s
+        Edge const* edges_end(state_id s) const;
+
+        /// Returns a pointer to the first destination of the epsilon transitions of state s
+        state_id const* epsilon_begin(state_id s) const;
+
+        /// Returns a pointer past the last destination of the epsilon transitions of state s
+        state_id const* epsilon_end(state_id s) const;
+
+        /// Returns the number of bytes used by the program
+        size_t memory_size() const;
+
+        /**
+         * @brief Appends the binary image of the program
+         * @param image Image to append to, its size must be a multiple of ImageWriter::alignment
+         */
+        void save(std::vector<char> &image) const;
+
+        /**
+         * @brief Makes a program which reads its arrays from a binary image made by save()
+         *
+         * # Complexity
+         * \f$ O(n + m) \f$ to check the image, nothing is copied
+         *
+         * @param first Pointer to the first byte of the image, aligned to ImageWriter::alignment
+         * @param last Pointer past the last byte available
+         * @param next Set to the first byte after the image
+         * @param storage Kept alive for as long as any copy of the program. It should own the image, if it is
+         * empty the image must outlive every copy.
+         * @return Program reading the image
+         * @throws InvalidImageError if the image is truncated or corrupted
+         */
+        static Program load(const char* first, const char* last, const char*& next,
+                            std::shared_ptr<const void> const& storage);
+
+    private:
+        /// Points the arrays at the vectors below
+        void bind();
+
+        /// Takes the arrays of another program and leaves it without states
+        void take(Program& other);
+
+        /**
+         * @brief Lays out an automaton given by rows of transitions. The states reached from state 0 are
+         * numbered in breadth first order, the others are dropped.
+         * @param edges Transitions of each state, the targets are indices of rows. Sorted in place.
+         * @param epsilon Destinations of the epsilon transitions of each state, in order of preference
+         * @param isEnd Whether each state is final
+         */
+        static Program layout(std::vector<std::vector<Edge> > &edges,
+                              std::vector<std::vector<state_id> > const &epsilon,
+                              std::vector<uint8_t> const &isEnd);
+
+        /// Offset of the first transition of each state, plus one past the end
+        std::vector<uint32_t> edgeOffsets_;
+
+        /// Transitions on a symbol
+        std::vector<Edge> edges_;
+
+        /// Offset of the first epsilon transition of each state, plus one past the end
+        std::vector<uint32_t> epsilonOffsets_;
+
+        /// Destinations of the epsilon transitions
+        std::vector<state_id> epsilon_;
+
+        /// Whether each state is final
+        std::vector<uint8_t> isEnd_;
+
+        /// Capture slot of each state, empty if the program has no slots
+        std::vector<uint32_t> slots_;
+
+        /// Whether the arrays point into an image instead of the vectors above
+        bool inPlace_;
+
+        /// Owner of the image the arrays point into
+        std::shared_ptr<const void> storage_;
+
+        size_t stateCount_;
+        size_t edgeCount_;
+        size_t epsilonCount_;
+        size_t slotCount_;
+        size_t groupCount_;
+        const uint32_t* edgeOffsetsData_;
+        const Edge* edgesData_;
+        const uint32_t* epsilonOffsetsData_;
+        const state_id* epsilonData_;
+        const uint8_t* isEndData_;
+        const uint32_t* slotsData_;
+    };
+
+    inline size_t Program::state_count() const {
+        return stateCount_;
+    }
+
+    inline Program::state_id Program::start() const {
+        return 0;
+    }
+
+    inline bool Program::isEnd(state_id s) const {
+        return isEndData_[s] != 0;
+    }
+
+    inline size_t Program::slot_count() const {
+        return slotCount_;
+    }
+
+    inline size_t Program::group_count() const {
+        return groupCount_;
+    }
+
+    inline uint32_t Program::slot(state_id s) const {
+        return slotsData_ ? slotsData_[s] : no_slot;
+    }
+
+    inline Program::Edge const *Program::edges_begin(state_id s) const {
+        return edgesData_ + edgeOffsetsData_[s];
+    }
+
+    inline Program::Edge const *Program::edges_end(state_id s) const {
+        return edgesData_ + edgeOffsetsData_[s + 1];
+    }
+
+    inline Program::state_id const *Program::epsilon_begin(state_id s) const {
+        return epsilonData_ + epsilonOffsetsData_[s];
+    }
+
+    inline Program::state_id const *Program::epsilon_end(state_id s) const {
+        return epsilonData_ + epsilonOffsetsData_[s + 1];
+    }
+}
+
+#endif //MYREGEX_PROGRAM_H
@@ -0,0 +1,347 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file ProgramBuilder.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26
+ *
+ * # Description
+ * This is the .cpp file which contains the implementation for all the methods declared in the header file
+ * ProgramBuilder.h
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#include <algorithm>
+
+#include "ProgramBuilder.h"
+#include "AutomataErrors.h"
+
+namespace Automata {
+
+    namespace {
+        bool edge_first_less(Program::Edge const& lhs, Program::Edge const& rhs) {
+            return lhs.first < rhs.first;
+        }
+    }
+
+    const uint32_t ProgramBuilder::nil;
+    const size_t ProgramBuilder::unbounded;
+    const size_t ProgramBuilder::default_max_states;
+
+    ProgramBuilder::ProgramBuilder(size_t max_states)
+            : maxStates_(max_states)
+    {}
+
+    ProgramBuilder::state_id ProgramBuilder::addNode(Kind kind, state_id out0, state_id out1) {
+        Node node;
+        node.kind = static_cast<uint8_t>(kind);
+        node.range_begin = static_cast<uint32_t>(ranges_.size());
+        node.range_end = node.range_begin;
+        node.slot = Program::no_slot;
+        node.out[0] = out0;
+        node.out[1] = out1;
+
+        nodes_.push_back(node);
+        return static_cast<state_id>(nodes_.size() - 1);
+    }
+
+    ProgramBuilder::Fragment ProgramBuilder::dangling(state_id start, state_id s, unsigned int which) {
+        Fragment f;
+        f.start = start;
+        f.out_head = s * 2 + which;
+        f.out_tail = f.out_head;
+        return f;
+    }
+
+    void ProgramBuilder::patch(uint32_t out_head, state_id s) {
+        while (out_head != nil)
+        {
+            state_id &out = nodes_[out_head / 2].out[out_head % 2];
+            out_head = out; // dangling transitions hold the next one of the list
+            out = s;
+        }
+    }
+
+    ProgramBuilder::Fragment ProgramBuilder::symbol(unsigned char c) {
+        return ranges(std::vector<range_type>(1, range_type(c, c)));
+    }
+
+    ProgramBuilder::Fragment ProgramBuilder::ranges(std::vector<range_type> const &ranges) {
+        state_id s = addNode(KIND_SYMBOL, nil, nil);
+        ranges_.insert(ranges_.end(), ranges.begin(), ranges.end());
+        nodes_[s].range_end = static_cast<uint32_t>(ranges_.size());
+        return dangling(s, s, 0);
+    }
+
+    ProgramBuilder::Fragment ProgramBuilder::concatenate(Fragment const &a, Fragment const &b) {
+        patch(a.out_head, b.start);
+
+        Fragment f = b;
+        f.start = a.start;
+        return f;
+    }
+
+    ProgramBuilder::Fragment ProgramBuilder::alternate(Fragment const &a, Fragment const &b) {
+        state_id split = addNode(KIND_SPLIT, a.start, b.start);
+
+        // append the dangling transitions of b to the ones of a
+        nodes_[a.out_tail / 2].out[a.out_tail % 2] = b.out_head;
+
+        Fragment f;
+        f.start = split;
+        f.out_head = a.out_head;
+        f.out_tail = b.out_tail;
+        return f;
+    }
+
+    ProgramBuilder::Fragment ProgramBuilder::kleene(Fragment const &a) {
+        // (a+)? rather than a single split which loops back: when `a` matches the empty string, the
+        // empty iteration must reach the end of the closure before the split is visited again
+        return optional(kleene_plus(a));
+    }
+
+    ProgramBuilder::Fragment ProgramBuilder::kleene_plus(Fragment const &a) {
+        state_id split = addNode(KIND_SPLIT, a.start, nil);
+        patch(a.out_head, split); // loop back
+
+        return dangling(a.start, split, 1);
+    }
+
+    ProgramBuilder::Fragment ProgramBuilder::optional(Fragment const &a) {
+        state_id split = addNode(KIND_SPLIT, a.start, nil);
+
+        // the skip transition is appended to the dangling transitions of a
+        nodes_[split].out[1] = a.out_head;
+
+        Fragment f;
+        f.start = split;
+        f.out_head = split * 2 + 1;
+        f.out_tail = a.out_tail;
+        return f;
+    }
+
+    ProgramBuilder::Fragment ProgramBuilder::empty() {
+        // both transitions go to the same state, compile() lays them out as a single one
+        state_id split = addNode(KIND_SPLIT, nil, nil);
+        nodes_[split].out[0] = split * 2 + 1;
+
+        Fragment f;
+        f.start = split;
+        f.out_head = split * 2;
+        f.out_tail = split * 2 + 1;
+        return f;
+    }
+
+    ProgramBuilder::Fragment ProgramBuilder::capture(Fragment const &a, size_t group) {
+        state_id open = addNode(KIND_SAVE, a.start, nil);
+        nodes_[open].slot = static_cast<uint32_t>(2 * group);
+
+        state_id close = addNode(KIND_SAVE, nil, nil);
+        nodes_[close].slot = static_cast<uint32_t>(2 * group + 1);
+        patch(a.out_head, close);
+
+        return dangling(open, close, 0);
+    }
+
+    ProgramBuilder::Fragment ProgramBuilder::repeat(Fragment const &a, size_t min, size_t max) {
+        if (max == 0)
+            return empty();
+        if (min == 0 && max == unbounded)
+            return kleene(a);
+
+        // Find the states of a, following every transition which isn't dangling
+        std::vector<uint32_t> slots;
+        for (uint32_t slot = a.out_head; slot != nil; slot = nodes_[slot / 2].out[slot % 2])
+            slots.push_back(slot);
+        std::sort(slots.begin(), slots.end());
+
+        std::vector<state_id> states(1, a.start);
+        flat_hashtable<state_id, state_id> position(16);
+        position.insert(a.start, 0);
+        for (size_t i = 0; i < states.size(); i++)
+        {
+            Node const& node = nodes_[states[i]];
+            unsigned int out_count = node.kind == KIND_SPLIT ? 2 : 1;
+            for (unsigned int k = 0; k < out_count; k++)
+            {
+                if (std::binary_search(slots.begin(), slots.end(), states[i] * 2 + k)
+                    || position.find(node.out[k]) != position.end())
+                    continue;
+
+                position.insert(node.out[k], static_cast<state_id>(states.size()));
+                states.push_back(node.out[k]);
+            }
+        }
+
+        size_t copies = max == unbounded ? min : max;
+        if (nodes_.size() + (copies - 1) * states.size() > maxStates_)
+            throw TooManyStatesError(maxStates_);
+
+        // every occurrence is copied before any of them is patched
+        std::vector<Fragment> occurrences(1, a);
+        for (size_t i = 1; i < copies; i++)
+            occurrences.push_back(copy(a, states, slots, position));
+
+        if (max == unbounded)
+        {
+            occurrences.back() = kleene_plus(occurrences.back());
+            min = copies;
+        }
+
+        // the optional occurrences, innermost first
+        Fragment tail = occurrences.back();
+        if (copies > min)
+        {
+            size_t i = copies - 1;
+            tail = optional(occurrences[i]);
+            while (i-- > min)
+                tail = optional(concatenate(occurrences[i], tail));
+            if (min == 0)
+                return tail;
+        }
+
+        Fragment f = occurrences[0];
+        for (size_t i = 1; i < min; i++)
+            f = concatenate(f, occurrences[i]);
+        if (copies > min)
+            f = concatenate(f, tail);
+        return f;
+    }
+
+    ProgramBuilder::Fragment ProgramBuilder::copy(Fragment const &a, std::vector<state_id> const &states,
+                                                  std::vector<uint32_t> const &slots,
+                                                  flat_hashtable<state_id, state_id> const &position) {
+        state_id base = static_cast<state_id>(nodes_.size());
+        for (size_t i = 0; i < states.size(); i++)
+        {
+            Node node = nodes_[states[i]];
+            unsigned int out_count = node.kind == KIND_SPLIT ? 2 : 1;
+            for (unsigned int k = 0; k < out_count; k++)
+                if (!std::binary_search(slots.begin(), slots.end(), states[i] * 2 + k))
+                    node.out[k] = base + position.at(node.out[k]);
+
+            nodes_.push_back(node); // the ranges are shared
+        }
+
+        // thread the dangling transitions of the copy in the same order
+        Fragment f;
+        f.start = base + position.at(a.start);
+        f.out_head = (base + position.at(a.out_head / 2)) * 2 + a.out_head % 2;
+        f.out_tail = (base + position.at(a.out_tail / 2)) * 2 + a.out_tail % 2;
+
+        for (uint32_t slot = a.out_head; slot != nil; slot = nodes_[slot / 2].out[slot % 2])
+        {
+            uint32_t next = nodes_[slot / 2].out[slot % 2];
+            uint32_t copied = (base + position.at(slot / 2)) * 2 + slot % 2;
+            nodes_[copied / 2].out[copied % 2] = next == nil ? nil
+                                                             : (base + position.at(next / 2)) * 2 + next % 2;
+        }
+        return f;
+    }
+
+    Program ProgramBuilder::compile(Fragment const &f, size_t group_count) {
+        const uint32_t unnumbered = 0xFFFFFFFF;
+
+        state_id end = addNode(KIND_END, nil, nil);
+        patch(f.out_head, end);
+
+        // Number the states in breadth first order, the initial state is 0
+        std::vector<uint32_t> index(nodes_.size(), unnumbered);
+        std::vector<state_id> order;
+        order.push_back(f.start);
+        index[f.start] = 0;
+
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            Node const& node = nodes_[order[i]];
+            unsigned int out_count = node.kind == KIND_SPLIT ? 2 : node.kind == KIND_END ? 0 : 1;
+
+            for (unsigned int k = 0; k < out_count; k++)
+            {
+                if (index[node.out[k]] == unnumbered)
+                {
+                    index[node.out[k]] = static_cast<uint32_t>(order.size());
+                    order.push_back(node.out[k]);
+                }
+            }
+        }
+
+        // Lay out the transitions, epsilon transitions are kept in order of preference
+        Program program;
+        for (size_t i = 0; i < order.size(); i++)
+            if (nodes_[order[i]].kind == KIND_SAVE)
+                program.slotCount_ = std::max<size_t>(program.slotCount_, nodes_[order[i]].slot / 2 * 2 + 2);
+        if (program.slotCount_ > 0)
+            program.slots_.assign(order.size(), Program::no_slot);
+        program.groupCount_ = std::max(group_count, program.slotCount_ / 2);
+
+        program.isEnd_.reserve(order.size());
+        program.edgeOffsets_.reserve(order.size() + 1);
+        program.epsilonOffsets_.reserve(order.size() + 1);
+
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            Node const& node = nodes_[order[i]];
+            program.isEnd_.push_back(node.kind == KIND_END ? 1 : 0);
+
+            if (node.kind == KIND_SYMBOL)
+            {
+                size_t first_edge = program.edges_.size();
+                for (uint32_t r = node.range_begin; r < node.range_end; r++)
+                {
+                    Program::Edge e;
+                    e.first = ranges_[r].first;
+                    e.last = ranges_[r].second;
+                    e.target = index[node.out[0]];
+                    program.edges_.push_back(e);
+                }
+                std::sort(program.edges_.begin() + first_edge, program.edges_.end(), edge_first_less);
+            } else if (node.kind == KIND_SPLIT)
+            {
+                program.epsilon_.push_back(index[node.out[0]]);
+                if (node.out[1] != node.out[0])
+                    program.epsilon_.push_back(index[node.out[1]]);
+            } else if (node.kind == KIND_SAVE)
+            {
+                program.epsilon_.push_back(index[node.out[0]]);
+                program.slots_[i] = node.slot;
+            }
+
+            program.edgeOffsets_.push_back(static_cast<uint32_t>(program.edges_.size()));
+            program.epsilonOffsets_.push_back(static_cast<uint32_t>(program.epsilon_.size()));
+        }
+
+        program.bind();
+        return program;
+    }
+
+    void ProgramBuilder::clear() {
+        nodes_.clear();
+        ranges_.clear();
+    }
+
+    size_t ProgramBuilder::state_count() const {
+        return nodes_.size();
+    }
+}
@@ -0,0 +1,255 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file ProgramBuilder.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the class ProgramBuilder.
+ *
+ * # Description
+ * This file contains the declarations of a builder which applies the Thompson construction directly on a
+ * pool of states and produces a Program, without going through the NFA class.
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#ifndef MYREGEX_PROGRAMBUILDER_H
+#define MYREGEX_PROGRAMBUILDER_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Program.h"
+#include "../Hashtable/FlatHashtable.h"
+
+namespace Automata {
+
+    /** @class ProgramBuilder
+     * @author Carlos Brito (carlos.brito524@gmail.com)
+     * @date 10/14/26.
+     *
+     * @brief Builds a Program with the Thompson construction
+     *
+     * # Description
+     * The combinators of NFA (concatenate(), alternate(), kleene(), ...) copy both operands into a brand
+     * new automaton, so building the automaton of a pattern is quadratic in its length. The builder
+     * instead keeps every state of every automaton in a single pool, and an automaton under construction
+     * is only a Fragment: its initial state plus the list of its dangling transitions, the ones which
+     * still have no destination. Combining fragments just adds at most one state and patches dangling
+     * transitions, which is \f$ O(1) \f$ except for concatenation which is linear in the number of
+     * dangling transitions of the left operand.
+     *
+     * The list of dangling transitions costs no memory: it is threaded through the destination fields of
+     * the transitions themselves, which aren't used until they are patched.
+     *
+     * Each state of the pool is one of:
+     *
+     * - a symbol state, which has transitions on one or more ranges of symbols, all to the same state
+     * - a split state, which has two epsilon transitions, the first one being the preferred one
+     * - a save state, which has one epsilon transition and saves the position in a capture slot
+     * - the final state, which is added by compile()
+     *
+     * Please see:
+     * Russ Cox, Regular Expression Matching Can Be Simple And Fast (2007)
+     * https://swtch.com/~rsc/regexp/regexp1.html
+     */
+    class ProgramBuilder {
+    public:
+        typedef Program::state_id state_id;
+
+        /// Upper bound of repeat() for a repetition without one, like `{m,}`
+        static const size_t unbounded = static_cast<size_t>(-1);
+
+        /// Default largest number of states repeat() lets the pool grow to
+        static const size_t default_max_states = 1 << 16;
+
+        /// Automaton under construction
+        struct Fragment {
+            /// Initial state
+            state_id start;
+
+            /// First dangling transition
+            uint32_t out_head;
+
+            /// Last dangling transition
+            uint32_t out_tail;
+        };
+
+        /// Constructs an empty builder
+        /**
+         * @param max_states Largest number of states repeat() lets the pool grow to
+         */
+        explicit ProgramBuilder(size_t max_states = default_max_states);
+
+        /// Range of symbols, from `first` to `second` both included
+        typedef std::pair<unsigned char, unsigned char> range_type;
+
+        /// Returns a fragment which accepts the language \f$ \{ c \} \f$
+        Fragment symbol(unsigned char c);
+
+        /// Returns a fragment which accepts every single symbol of the ranges
+        /**
+         * The fragment is a single state, with one transition per range. Without ranges it accepts nothing.
+         *
+         * @param ranges Ranges of symbols
+         */
+        Fragment ranges(std::vector<range_type> const& ranges);
+
+        /// Returns the concatenation of two fragments. See NFA::concatenate().
+        Fragment concatenate(Fragment const& a, Fragment const& b);
+
+        /// Returns the alternation of two fragments, `a` being the preferred one. See NFA::alternate().
+        Fragment alternate(Fragment const& a, Fragment const& b);
+
+        /// Returns the kleene closure of a fragment. See NFA::kleene().
+        /**
+         * The closure is built as `(a+)?`, so that an iteration of `a` which matches the empty string, like
+         * the one of `(b?)*` on an empty string, sets the groups of `a` instead of dying on the loop.
+         */
+        Fragment kleene(Fragment const& a);
+
+        /// Returns the kleene plus closure of a fragment. See NFA::kleene_plus().
+        /**
+         * Unlike NFA::kleene_plus(), the fragment isn't duplicated: a single split state loops back to it.
+         */
+        Fragment kleene_plus(Fragment const& a);
+
+        /// Returns a fragment which accepts the language of `a` or the empty string. See NFA::optional().
+        Fragment optional(Fragment const& a);
+
+        /// Returns a fragment which accepts only the empty string
+        Fragment empty();
+
+        /// Returns the same fragment as `a`, which saves where it starts and ends as group `group`
+        /**
+         * A save state for slot \f$ 2g \f$ is put before `a` and one for slot \f$ 2g + 1 \f$ after it,
+         * see Program::slot(). Copies of the fragment made by repeat() save in the same slots, so the
+         * positions of the last occurrence are the ones left in the slots.
+         *
+         * @param a Fragment
+         * @param group Number of the group
+         */
+        Fragment capture(Fragment const& a, size_t group);
+
+        /// Returns a fragment which accepts from min to max concatenations of the language of `a`
+        /**
+         * An automaton has no counters, so each occurrence is a copy of the states of `a`, which only costs
+         * the copy: the ranges of the symbol states are shared. `x{m,}` is `m - 1` copies followed by a
+         * loop on the last one, like kleene_plus(), and the optional copies of `x{m,n}` are nested, as in
+         * `xx(x(x)?)?` for `x{2,4}`, so the automaton stops trying them after the first one which doesn't
+         * match and a closure holds a single split state per copy.
+         *
+         * # Complexity
+         * \f$ O(k n) \f$ where \f$ k \f$ is the number of states of `a` and \f$ n \f$ the number
+         * of copies, max or min if there is no upper bound
+         *
+         * @param a Fragment to repeat, it is the first occurrence
+         * @param min Least number of occurrences
+         * @param max Largest number of occurrences, at least min, or unbounded
+         * @throws TooManyStatesError if the pool would hold more than max_states states
+         */
+        Fragment repeat(Fragment const& a, size_t min, size_t max);
+
+        /// Builds the program whose automaton is the fragment
+        /**
+         * The dangling transitions of the fragment are connected to a new final state and the states
+         * reachable from the initial state of the fragment are laid out into a Program. The fragment
+         * can't be used anymore afterwards.
+         *
+         * @param f Complete automaton
+         * @param group_count Number of groups of the pattern, group 0 included, see Program::group_count().
+         * The groups of the save states of the fragment are always counted.
+         * @return Compiled program
+         */
+        Program compile(Fragment const& f, size_t group_count = 0);
+
+        /// Removes every state from the pool
+        void clear();
+
+        /// Returns the number of states in the pool
+        size_t state_count() const;
+
+    private:
+        /// Kind of a state of the pool
+        enum Kind {
+            KIND_SYMBOL,
+            KIND_SPLIT,
+            KIND_SAVE,
+            KIND_END
+        };
+
+        /// A state of the pool
+        struct Node {
+            /// Kind of state
+            uint8_t kind;
+
+            /// First range of the transitions of a symbol state in ranges_
+            uint32_t range_begin;
+
+            /// One past the last range of the transitions of a symbol state in ranges_
+            uint32_t range_end;
+
+            /// Capture slot of a save state
+            uint32_t slot;
+
+            /// Destinations. While dangling, they hold the next dangling transition of the list instead.
+            state_id out[2];
+        };
+
+        /// Marks the end of a list of dangling transitions and an unset destination
+        static const uint32_t nil = 0xFFFFFFFF;
+
+        /// Adds a state to the pool and returns its identifier
+        state_id addNode(Kind kind, state_id out0, state_id out1);
+
+        /// Returns the list made of the single dangling transition `which` of state s
+        Fragment dangling(state_id start, state_id s, unsigned int which);
+
+        /// Sets the destination of every transition of the list to s
+        void patch(uint32_t out_head, state_id s);
+
+        /**
+         * @brief Adds a copy of the states of a fragment to the pool
+         * @param a Fragment to copy, none of its dangling transitions may be patched yet
+         * @param states States of the fragment
+         * @param slots Dangling transitions of the fragment, sorted
+         * @param position Index of each state of the fragment in states
+         * @return The copy
+         */
+        Fragment copy(Fragment const& a, std::vector<state_id> const& states, std::vector<uint32_t> const& slots,
+                      flat_hashtable<state_id, state_id> const& position);
+
+        /// Largest number of states repeat() lets the pool grow to
+        size_t maxStates_;
+
+        /// Pool of states
+        std::vector<Node> nodes_;
+
+        /// Ranges of the symbol states
+        std::vector<range_type> ranges_;
+    };
+}
+
+#endif //MYREGEX_PROGRAMBUILDER_H
@@ -0,0 +1,647 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file SharedLazyDFA.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26
+ *
+ * # Description
+ * This is the .cpp file which contains the implementation for all the methods declared in the header file SharedLazyDFA.h
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#include "SharedLazyDFA.h"
+#include "LazyDFA.h"
+
+namespace Automata {
+
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "the table is made with calloc");
+
+    const size_t SharedLazyDFA::alphabet_size;
+    const SharedLazyDFA::state_id SharedLazyDFA::unknown_state;
+    const SharedLazyDFA::state_id SharedLazyDFA::dead_state;
+    const size_t SharedLazyDFA::default_memory_budget;
+    const size_t SharedLazyDFA::interleave;
+    const uint32_t SharedLazyDFA::unknown_entry;
+    const uint32_t SharedLazyDFA::dead_entry;
+
+    SharedLazyDFA::Generation::Generation(uint64_t serial, size_t capacity)
+            : serial(serial),
+              capacity(capacity),
+              table(static_cast<std::atomic<uint32_t>*>(std::calloc(capacity * alphabet_size, sizeof(uint32_t)))),
+              states(new State[capacity]),
+              count(0),
+              memoryUsed(0),
+              start(0)
+    {
+        if (!table)
+            throw std::bad_alloc();
+
+        // at most half full, so a probe always ends on an empty slot
+        size_t slot_count = 1;
+        while (slot_count < 2 * capacity)
+            slot_count *= 2;
+
+        slots.reset(new std::atomic<uint32_t>[slot_count]());
+        slotMask = slot_count - 1;
+    }
+
+    SharedLazyDFA::Generation::~Generation() {
+        std::free(table);
+    }
+
+    SharedLazyDFA::SharedLazyDFA(std::shared_ptr<const Program> program, size_t memory_budget)
+            : program_(program),
+              memoryBudget_(memory_budget),
+              capacity_(std::max(memory_budget / stateCost(0), static_cast<size_t>(1))),
+              current_(new Generation(1, capacity_)),
+              epoch_(1),
+              flushCount_(0),
+              fallbackCount_(0)
+    {}
+
+    SharedLazyDFA::~SharedLazyDFA() {
+        for (size_t i = 0; i < retired_.size(); i++)
+            delete retired_[i].first;
+        delete current_.load();
+    }
+
+    size_t SharedLazyDFA::memory_budget() const {
+        return memoryBudget_;
+    }
+
+    size_t SharedLazyDFA::memory_used() const {
+        // the current generation can't be freed while the lock is held
+        std::lock_guard<std::mutex> lock(mutex_);
+        return current_.load()->memoryUsed.load();
+    }
+
+    size_t SharedLazyDFA::state_count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Generation const* g = current_.load();
+        return std::min(static_cast<size_t>(g->count.load()), g->capacity);
+    }
+
+    size_t SharedLazyDFA::flush_count() const {
+        return flushCount_.load();
+    }
+
+    size_t SharedLazyDFA::fallback_count() const {
+        return fallbackCount_.load();
+    }
+
+    SharedLazyDFA::state_id SharedLazyDFA::findOrAddState(Generation *g, nfa_state_set_type const &T, bool is_end) {
+        if (current_.load(std::memory_order_relaxed) != g) // a state added to a retired generation is lost
+            return unknown_state;
+
+        uint32_t id = unknown_state; // reserved for T, once it is known not to be there
+        for (size_t i = LazyDFA::Hasher()(T) & g->slotMask;; i = (i + 1) & g->slotMask)
+        {
+            uint32_t entry = g->slots[i].load(std::memory_order_acquire);
+            if (entry == 0)
+            {
+                if (id == unknown_state)
+                {
+                    size_t cost = stateCost(T.size());
+                    uint32_t count = g->count.load(std::memory_order_relaxed);
+                    if (count >= g->capacity || (count > 0 && g->memoryUsed.load() + cost > memoryBudget_))
+                        return unknown_state;
+
+                    id = g->count.fetch_add(1);
+                    if (id >= g->capacity)
+                        return unknown_state;
+
+                    g->states[id].nfa_states = T;
+                    g->states[id].is_end = is_end;
+                    g->memoryUsed.fetch_add(cost);
+                }
+
+                // publishes the state, unless another thread took the slot first
+                if (g->slots[i].compare_exchange_strong(entry, id + 1, std::memory_order_acq_rel,
+                                                        std::memory_order_acquire))
+                    return id;
+            }
+
+            if (g->states[entry - 1].nfa_states == T) // the state reserved for T, if any, is left unused
+                return entry - 1;
+        }
+    }
+
+    SharedLazyDFA::Generation* SharedLazyDFA::flush(Generation *g) {
+        Generation* current = current_.load();
+        if (current != g)
+            return current;
+
+        Generation* fresh = new Generation(g->serial + 1, capacity_);
+        if (!current_.compare_exchange_strong(current, fresh))
+        {
+            delete fresh;
+            return current;
+        }
+
+        flushCount_++;
+        std::lock_guard<std::mutex> lock(mutex_);
+        retired_.push_back(std::make_pair(g, epoch_.fetch_add(1) + 1));
+        reclaim();
+        return fresh;
+    }
+
+    void SharedLazyDFA::reclaim() {
+        // a scanner which entered in epoch e may read any generation retired after e
+        uint64_t oldest = UINT64_MAX;
+        for (size_t i = 0; i < participants_.size(); i++)
+        {
+            uint64_t epoch = participants_[i]->epoch.load();
+            if (epoch != 0)
+                oldest = std::min(oldest, epoch);
+        }
+
+        size_t kept = 0;
+        for (size_t i = 0; i < retired_.size(); i++)
+        {
+            if (retired_[i].second <= oldest)
+                delete retired_[i].first;
+            else
+                retired_[kept++] = retired_[i];
+        }
+        retired_.resize(kept);
+    }
+
+    SharedLazyDFA::Participant* SharedLazyDFA::enroll() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        participants_.push_back(std::unique_ptr<Participant>(new Participant()));
+        participants_.back()->epoch.store(0);
+        return participants_.back().get();
+    }
+
+    void SharedLazyDFA::withdraw(Participant *participant) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < participants_.size(); i++)
+        {
+            if (participants_[i].get() == participant)
+            {
+                participants_[i].swap(participants_.back());
+                participants_.pop_back();
+                break;
+            }
+        }
+        reclaim();
+    }
+
+    size_t SharedLazyDFA::stateCost(size_t nfa_state_count) {
+        return alphabet_size * sizeof(uint32_t) // row of the transition table
+               + nfa_state_count * sizeof(uint32_t) // the set itself
+               + sizeof(State) + 2 * sizeof(uint32_t); // and its slots in the hashtable
+    }
+
+    SharedLazyDFA::Scanner::Scanner()
+            : participant_(nullptr),
+              markGeneration_(0),
+              streamState_(unknown_state),
+              streamSerial_(0),
+              streamBytesSinceFlush_(0)
+    {}
+
+    SharedLazyDFA::Scanner::Scanner(std::shared_ptr<SharedLazyDFA> dfa)
+            : dfa_(dfa),
+              participant_(dfa ? dfa->enroll() : nullptr),
+              marks_(dfa ? dfa->program_->state_count() : 0, 0),
+              markGeneration_(0),
+              streamState_(unknown_state),
+              streamSerial_(0),
+              streamBytesSinceFlush_(0)
+    {
+        reset();
+    }
+
+    SharedLazyDFA::Scanner::Scanner(Scanner const &other)
+            : Scanner(other.dfa_)
+    {}
+
+    SharedLazyDFA::Scanner& SharedLazyDFA::Scanner::operator=(Scanner const &other) {
+        if (this == &other)
+            return *this;
+
+        if (participant_)
+            dfa_->withdraw(participant_);
+
+        dfa_ = other.dfa_;
+        participant_ = dfa_ ? dfa_->enroll() : nullptr;
+        marks_.assign(dfa_ ? dfa_->program_->state_count() : 0, 0);
+        markGeneration_ = 0;
+        stats_ = MatchStats();
+        reset();
+        return *this;
+    }
+
+    SharedLazyDFA::Scanner::~Scanner() {
+        if (participant_)
+            dfa_->withdraw(participant_);
+    }
+
+    bool SharedLazyDFA::Scanner::match(const char *first, const char *last) {
+        if (!dfa_ || dfa_->program_->state_count() == 0)
+            return false;
+
+        Generation* g = enter();
+        bool accepted = matchIn(g, first, last);
+        leave();
+        return accepted;
+    }
+
+    void SharedLazyDFA::Scanner::match_many(std::string_view const *strs, size_t count, unsigned char *results) {
+        if (!dfa_ || dfa_->program_->state_count() == 0)
+        {
+            std::fill(results, results + count, 0);
+            return;
+        }
+
+        Generation* g = enter();
+        Generation* lanes = g; // generation the states of the lanes are in
+
+        // a lane without a string is in dead_state, with no index
+        const char* it[interleave];
+        const char* end[interleave];
+        state_id s[interleave];
+        size_t index[interleave];
+        size_t next = 0;
+        size_t busy = 0;
+
+        // once g moved to a newer generation, the lanes start over in it
+        auto settle = [&]() {
+            while (lanes != g)
+            {
+                lanes = g;
+                for (size_t j = 0; j < interleave; j++)
+                    if (s[j] != dead_state)
+                    {
+                        it[j] = strs[index[j]].data();
+                        s[j] = startState(g);
+                    }
+            }
+        };
+
+        auto load = [&](size_t k) {
+            s[k] = dead_state;
+            index[k] = SIZE_MAX;
+            if (next == count)
+                return;
+
+            it[k] = strs[next].data();
+            end[k] = strs[next].data() + strs[next].size();
+            s[k] = startState(g);
+            index[k] = next++;
+            busy++;
+        };
+
+        for (size_t k = 0; k < interleave; k++)
+            load(k);
+        settle();
+
+        while (busy > 0)
+        {
+            // no lane runs out of bytes before the shortest one
+            size_t steps = SIZE_MAX;
+            for (size_t k = 0; k < interleave; k++)
+                if (s[k] != dead_state)
+                    steps = std::min(steps, static_cast<size_t>(end[k] - it[k]));
+
+            std::atomic<uint32_t>* table = g->table;
+            for (; steps > 0 && busy > 0; steps--)
+                for (size_t k = 0; k < interleave; k++)
+                {
+                    if (s[k] == dead_state)
+                        continue;
+
+                    uint32_t entry = table[s[k] * alphabet_size + static_cast<unsigned char>(*it[k])].load(
+                            std::memory_order_acquire);
+                    if (entry != unknown_entry && entry != dead_entry)
+                    {
+                        MYREGEX_STATS(stats_.bytes++; stats_.active_states += g->states[s[k]].nfa_states.size());
+                        MYREGEX_STATS(stats_.cache_hits++);
+                        s[k] = entry - 1;
+                        it[k]++;
+                        continue;
+                    }
+
+                    // the transition is dead or not cached, the rest of the string is matched on its own
+                    state_id state = s[k];
+                    size_t bytes_since_flush = 0;
+                    const char* resume = run(g, state, it[k], end[k], bytes_since_flush, next_);
+                    if (state == unknown_state)
+                    {
+                        dfa_->fallbackCount_++;
+                        results[index[k]] = simulate(next_, resume, end[k]) && accepts(next_);
+                    } else
+                        results[index[k]] = state != dead_state && g->states[state].is_end;
+
+                    s[k] = dead_state;
+                    index[k] = SIZE_MAX;
+                    busy--;
+
+                    settle();
+                    table = g->table;
+                }
+
+            for (size_t k = 0; k < interleave; k++)
+                if (index[k] == SIZE_MAX || it[k] == end[k])
+                {
+                    if (index[k] != SIZE_MAX)
+                    {
+                        results[index[k]] = g->states[s[k]].is_end;
+                        busy--;
+                    }
+                    load(k);
+                }
+            settle();
+        }
+
+        leave();
+    }
+
+    bool SharedLazyDFA::Scanner::matchIn(Generation *&g, const char *first, const char *last) {
+        state_id s = startState(g);
+        size_t bytes_since_flush = 0;
+
+        const char* it = run(g, s, first, last, bytes_since_flush, next_);
+        if (s == unknown_state)
+        {
+            dfa_->fallbackCount_++;
+            return simulate(next_, it, last) && accepts(next_);
+        }
+
+        return s != dead_state && g->states[s].is_end;
+    }
+
+    void SharedLazyDFA::Scanner::reset() {
+        streamSet_.clear();
+        streamState_ = unknown_state;
+        streamSerial_ = 0;
+        streamBytesSinceFlush_ = 0;
+
+        if (dfa_ && dfa_->program_->state_count() > 0)
+            startSet(streamSet_);
+    }
+
+    bool SharedLazyDFA::Scanner::feed(const char *data, size_t size) {
+        if (streamSet_.empty())
+            return false;
+
+        // the stream is carried from one chunk to the next as a set, its state may be gone by the next one
+        Generation* g = enter();
+        state_id s = g->serial == streamSerial_ ? streamState_ : findOrAddState(g, streamSet_);
+
+        const char* last = data + size;
+        const char* it = run(g, s, data, last, streamBytesSinceFlush_, next_);
+        if (s == unknown_state)
+        {
+            dfa_->fallbackCount_++;
+            streamSet_.swap(next_);
+            if (!simulate(streamSet_, it, last))
+                streamSet_.clear();
+            streamSerial_ = 0;
+        } else if (s == dead_state)
+            streamSet_.clear();
+        else
+        {
+            streamSet_ = g->states[s].nfa_states;
+            streamState_ = s;
+            streamSerial_ = g->serial;
+        }
+
+        leave();
+        return !streamSet_.empty();
+    }
+
+    bool SharedLazyDFA::Scanner::finish() {
+        bool accepted = accepts(streamSet_);
+        reset();
+        return accepted;
+    }
+
+    MatchStats const& SharedLazyDFA::Scanner::stats() const {
+        return stats_;
+    }
+
+    void SharedLazyDFA::Scanner::resetStats() {
+        stats_ = MatchStats();
+    }
+
+    SharedLazyDFA::Generation* SharedLazyDFA::Scanner::enter() {
+        participant_->epoch.store(dfa_->epoch_.load());
+        return dfa_->current_.load();
+    }
+
+    void SharedLazyDFA::Scanner::leave() {
+        participant_->epoch.store(0, std::memory_order_release);
+    }
+
+    SharedLazyDFA::state_id SharedLazyDFA::Scanner::startState(Generation *&g) {
+        uint32_t entry = g->start.load(std::memory_order_acquire);
+        if (entry != 0)
+            return entry - 1;
+
+        nfa_state_set_type T;
+        startSet(T);
+        Generation* before = g;
+        state_id s = findOrAddState(g, T);
+        if (g == before)
+            g->start.store(s + 1, std::memory_order_release);
+        return s;
+    }
+
+    const char* SharedLazyDFA::Scanner::run(Generation *&g, state_id &s, const char *first, const char *last,
+                                            size_t &bytes_since_flush, nfa_state_set_type &T) {
+        // the state is kept in locals, the atomic loads would make the compiler spill the references
+        std::atomic<uint32_t>* table = g->table;
+        state_id current = s;
+        const char* it = first;
+        for (;;)
+        {
+            const char* cached = it;
+            uint32_t entry = unknown_entry;
+            for (; it != last; it++)
+            {
+                entry = table[current * alphabet_size + static_cast<unsigned char>(*it)].load(std::memory_order_acquire);
+
+                MYREGEX_STATS(stats_.bytes++; stats_.active_states += g->states[current].nfa_states.size());
+                MYREGEX_STATS(entry == unknown_entry ? stats_.cache_misses++ : stats_.cache_hits++);
+
+                if (entry == unknown_entry || entry == dead_entry)
+                    break;
+
+                current = entry - 1;
+            }
+            bytes_since_flush += it - cached;
+
+            if (it == last)
+            {
+                s = current;
+                return last;
+            }
+
+            unsigned char c = static_cast<unsigned char>(*it);
+            if (entry == unknown_entry)
+            {
+                successor(g->states[current].nfa_states, c, T);
+
+                if (T.empty())
+                {
+                    entry = dead_entry;
+                    table[current * alphabet_size + c].store(entry, std::memory_order_release);
+                } else
+                {
+                    Generation* before = g;
+                    state_id next = findOrAddState(g, T);
+                    if (g != before) // the source state is in the old generation, we can't memoize
+                    {
+                        size_t states_before = std::min(static_cast<size_t>(before->count.load()), before->capacity);
+                        if (bytes_since_flush < LazyDFA::min_bytes_per_state * states_before) // cache thrashes
+                        {
+                            s = unknown_state;
+                            return it + 1;
+                        }
+                        bytes_since_flush = 0;
+                        table = g->table;
+                    } else
+                        table[current * alphabet_size + c].store(next + 1, std::memory_order_release);
+
+                    entry = next + 1;
+                }
+            }
+
+            if (entry == dead_entry)
+            {
+                s = dead_state;
+                return last;
+            }
+
+            current = entry - 1;
+            bytes_since_flush++;
+            it++;
+        }
+    }
+
+    SharedLazyDFA::state_id SharedLazyDFA::Scanner::findOrAddState(Generation *&g, nfa_state_set_type const &T) {
+        bool is_end = accepts(T);
+        for (;;)
+        {
+            state_id id = dfa_->findOrAddState(g, T, is_end);
+            if (id != unknown_state)
+                return id;
+
+            g = dfa_->flush(g);
+        }
+    }
+
+    void SharedLazyDFA::Scanner::startSet(nfa_state_set_type &T) {
+        T.clear();
+        T.push_back(dfa_->program_->start());
+        epsilon_closure(T);
+    }
+
+    void SharedLazyDFA::Scanner::successor(nfa_state_set_type const &T, unsigned char c, nfa_state_set_type &result) {
+        Program const& program = *dfa_->program_;
+        result.clear();
+        for (nfa_state_set_type::const_iterator s_it = T.begin(); s_it != T.end(); s_it++)
+        {
+            for (Program::Edge const* e_it = program.edges_begin(*s_it); e_it != program.edges_end(*s_it); e_it++)
+            {
+                if (e_it->contains(c))
+                    result.push_back(e_it->target);
+                else if (e_it->first > c) // transitions are sorted by their first symbol
+                    break;
+            }
+        }
+        epsilon_closure(result);
+    }
+
+    void SharedLazyDFA::Scanner::epsilon_closure(nfa_state_set_type &T) {
+        if (++markGeneration_ == 0) // marks wrapped around, clear them
+        {
+            std::fill(marks_.begin(), marks_.end(), 0);
+            markGeneration_ = 1;
+        }
+
+        Program const& program = *dfa_->program_;
+        stack_.clear();
+        for (nfa_state_set_type::iterator it = T.begin(); it != T.end(); it++)
+        {
+            if (marks_[*it] != markGeneration_)
+            {
+                marks_[*it] = markGeneration_;
+                stack_.push_back(*it);
+            }
+        }
+
+        T.clear();
+        while (!stack_.empty())
+        {
+            uint32_t s = stack_.back();
+            stack_.pop_back();
+            T.push_back(s);
+
+            for (Program::state_id const* it = program.epsilon_begin(s); it != program.epsilon_end(s); it++)
+            {
+                if (marks_[*it] != markGeneration_)
+                {
+                    marks_[*it] = markGeneration_;
+                    stack_.push_back(*it);
+                }
+            }
+        }
+
+        std::sort(T.begin(), T.end());
+    }
+
+    bool SharedLazyDFA::Scanner::simulate(nfa_state_set_type &T, const char *it, const char *last) {
+        nfa_state_set_type next;
+        for (; it != last; it++)
+        {
+            MYREGEX_STATS(stats_.bytes++; stats_.active_states += T.size());
+
+            successor(T, static_cast<unsigned char>(*it), next);
+            if (next.empty())
+            {
+                T.clear();
+                return false;
+            }
+
+            T.swap(next);
+        }
+        return true;
+    }
+
+    bool SharedLazyDFA::Scanner::accepts(nfa_state_set_type const &T) const {
+        for (nfa_state_set_type::const_iterator it = T.begin(); it != T.end(); it++)
+            if (dfa_->program_->isEnd(*it))
+                return true;
+
+        return false;
+    }
+}
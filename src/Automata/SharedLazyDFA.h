@@ -0,0 +1,365 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file SharedLazyDFA.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the class SharedLazyDFA.
+ *
+ * # Description
+ * This file contains the declarations of a lazily built deterministic automaton whose state cache is shared by
+ * any number of threads, each matching through its own SharedLazyDFA::Scanner.
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#ifndef MYREGEX_SHAREDLAZYDFA_H
+#define MYREGEX_SHAREDLAZYDFA_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include "Program.h"
+#include "MatchStats.h"
+
+namespace Automata {
+
+    /** @class SharedLazyDFA
+     * @author Carlos Brito (carlos.brito524@gmail.com)
+     * @date 10/14/26.
+     *
+     * @brief Lazy DFA whose state cache is shared by several threads
+     *
+     * # Description
+     * This is LazyDFA with a single cache for every thread which matches the pattern, so the states are
+     * built once instead of once per thread and the memory budget bounds the whole. The cache is only
+     * read and filled through a Scanner, which holds what a thread needs while matching: the scratch sets
+     * of the subset construction and the state of a stream. A Scanner must not be used by two threads at
+     * the same time, a SharedLazyDFA may be used by any number of them.
+     *
+     * Following a cached transition takes no lock, it is a single atomic load. A state missing from
+     * the cache is computed by the thread which needs it and published with a compare and swap in a
+     * hashtable of the sets of NFA states, so two threads which compute the same state at the same
+     * time agree on it. The transition to it is then stored in the table, a plain atomic store being
+     * enough since every thread stores the same value.
+     *
+     * When the cache is full it is flushed, which here means a new empty cache, a generation, replaces
+     * it. Threads in the middle of a string keep reading the old generation until they need a state
+     * it lacks. The old generation is freed by epoch based reclamation: every Scanner announces the
+     * epoch in which it started reading the cache, and a generation retired in epoch e is freed once no
+     * Scanner still reads from an epoch before e. Only flushes and the registration of Scanners take
+     * a lock.
+     *
+     * If the cache thrashes, the rest of the string is matched by simulating the NFA, as in LazyDFA.
+     * Only anchored matches are supported.
+     */
+    class SharedLazyDFA {
+    private:
+        struct Generation;
+        struct Participant;
+
+    public:
+        /// Identifier for a state of the DFA
+        typedef uint32_t state_id;
+
+        /// Set of NFA states, identified by their index. Always kept sorted.
+        typedef std::vector<uint32_t> nfa_state_set_type;
+
+        /// Number of symbols of the alphabet, this is the width of each row of the transition table
+        static const size_t alphabet_size = 256;
+
+        /// Marks a state which isn't known, or isn't in the generation at hand
+        static const state_id unknown_state = 0xFFFFFFFF;
+
+        /// Marks the empty set of states
+        static const state_id dead_state = 0xFFFFFFFE;
+
+        /// Default memory budget of the state cache, in bytes, the same as the one of LazyDFA
+        static const size_t default_memory_budget = 1 << 20;
+
+        /// Number of strings Scanner::match_many() runs at the same time
+        static const size_t interleave = 8;
+
+        /**
+         * @class Scanner
+         * @brief What a thread needs to match strings with a SharedLazyDFA
+         *
+         * A copy of a Scanner uses the same automaton, with a stream of its own.
+         */
+        class Scanner {
+        public:
+            /// Constructs a scanner which matches nothing
+            Scanner();
+
+            /// Constructs a scanner for an automaton
+            explicit Scanner(std::shared_ptr<SharedLazyDFA> dfa);
+
+            Scanner(Scanner const& other);
+            Scanner& operator=(Scanner const& other);
+
+            /// Stops using the automaton
+            ~Scanner();
+
+            /// Returns true if the bytes in \f$ [first, last) \f$ are accepted by the automaton
+            bool match(const char* first, const char* last);
+
+            /**
+             * @brief Matches many strings, `interleave` of them at a time. See LazyDFA::match_many().
+             *
+             * The cache is entered once for the whole batch rather than once per string.
+             *
+             * @param strs Strings to match
+             * @param count Number of strings
+             * @param results Set to 1 for each string which is accepted and 0 for the others, in order
+             */
+            void match_many(std::string_view const* strs, size_t count, unsigned char* results);
+
+            /// Starts a new stream, discarding the current one. See LazyDFA::feed().
+            void reset();
+
+            /// Matches the next chunk of the stream, returns false if no continuation can match anymore
+            bool feed(const char* data, size_t size);
+
+            /// Returns true if the stream fed so far is accepted by the automaton, and starts a new stream
+            bool finish();
+
+            /// Returns the counters of the hot path. They stay at zero unless MYREGEX_ENABLE_STATS is defined.
+            MatchStats const& stats() const;
+
+            /// Sets the counters of the hot path back to zero
+            void resetStats();
+
+        private:
+            /// Announces that the cache is being read and returns its current generation
+            Generation* enter();
+
+            /// Announces that the cache isn't read anymore, the generations may then be freed
+            void leave();
+
+            /// Returns true if the bytes in \f$ [first, last) \f$ are accepted, between enter() and leave()
+            bool matchIn(Generation*& g, const char* first, const char* last);
+
+            /// Returns the initial state, moving g to a newer generation if g has no room for it
+            state_id startState(Generation*& g);
+
+            /// Runs the DFA from state s of generation g on \f$ [first, last) \f$. See LazyDFA::run().
+            /**
+             * g is moved to a newer generation whenever g has no room for a state. If the cache thrashed,
+             * s is `unknown_state`, T is the set of NFA states reached and the returned pointer is where
+             * the string has to be resumed from.
+             */
+            const char* run(Generation*& g, state_id &s, const char* first, const char* last,
+                            size_t &bytes_since_flush, nfa_state_set_type &T);
+
+            /// Returns the state for T in generation g, moving to a newer generation if g has no room for it
+            state_id findOrAddState(Generation*& g, nfa_state_set_type const& T);
+
+            /// Computes the set of NFA states of the initial state
+            void startSet(nfa_state_set_type &T);
+
+            /// Computes the set of NFA states reached from T on symbol c. It is empty if there is none.
+            void successor(nfa_state_set_type const& T, unsigned char c, nfa_state_set_type &result);
+
+            /// Computes the epsilon closure of T in place. The result is sorted.
+            void epsilon_closure(nfa_state_set_type &T);
+
+            /// Simulates the NFA from the set T on \f$ [it, last) \f$, returns false if T becomes empty
+            bool simulate(nfa_state_set_type &T, const char* it, const char* last);
+
+            /// Returns whether any state of T is final
+            bool accepts(nfa_state_set_type const& T) const;
+
+            /// Automaton, shared with the other scanners
+            std::shared_ptr<SharedLazyDFA> dfa_;
+
+            /// Epoch announced by this scanner, owned by dfa_
+            Participant* participant_;
+
+            /// Counters of the hot path
+            MatchStats stats_;
+
+            /// Marks used while computing closures (avoids clearing a set for every closure)
+            std::vector<uint32_t> marks_;
+
+            /// Current generation of marks_
+            uint32_t markGeneration_;
+
+            /// Scratch stack used while computing closures
+            std::vector<uint32_t> stack_;
+
+            /// Scratch set of the successors of a state
+            nfa_state_set_type next_;
+
+            /// Set of NFA states of the stream. Empty once no continuation can match.
+            nfa_state_set_type streamSet_;
+
+            /// State of the stream in the generation of serial streamSerial_, if it is still the current one
+            state_id streamState_;
+
+            /// Serial of the generation streamState_ belongs to
+            uint64_t streamSerial_;
+
+            /// Bytes of the stream scanned since the last flush
+            size_t streamBytesSinceFlush_;
+        };
+
+        /**
+         * @brief Constructs the automaton from a compiled NFA
+         * @param program Compiled automaton to determinize
+         * @param memory_budget Maximum number of bytes the state cache may use
+         */
+        explicit SharedLazyDFA(std::shared_ptr<const Program> program, size_t memory_budget = default_memory_budget);
+
+        SharedLazyDFA(SharedLazyDFA const&) = delete;
+        SharedLazyDFA& operator=(SharedLazyDFA const&) = delete;
+
+        /// Frees every generation. No Scanner may use the automaton anymore.
+        ~SharedLazyDFA();
+
+        /// Returns the memory budget of the cache, in bytes
+        size_t memory_budget() const;
+
+        /// Returns the number of bytes currently used by the cache
+        size_t memory_used() const;
+
+        /// Returns the number of DFA states currently in the cache
+        size_t state_count() const;
+
+        /// Returns the number of times the cache has been flushed
+        size_t flush_count() const;
+
+        /// Returns the number of times matching fell back to the NFA because the cache thrashed
+        size_t fallback_count() const;
+
+    private:
+        /// A state of the DFA
+        struct State {
+            /// States of the NFA this state stands for
+            nfa_state_set_type nfa_states;
+
+            /// Whether any of the NFA states is final
+            bool is_end;
+        };
+
+        /// Entry of the transition table for a transition which hasn't been computed. Others are the target plus one.
+        static const uint32_t unknown_entry = 0;
+
+        /// Entry of the transition table for a transition to the empty set
+        static const uint32_t dead_entry = 0xFFFFFFFF;
+
+        /// A cache, replaced by a new one on flush
+        struct Generation {
+            Generation(uint64_t serial, size_t capacity);
+            ~Generation();
+
+            /// Number of the generation, increasing from one flush to the next
+            uint64_t serial;
+
+            /// Maximum number of states
+            size_t capacity;
+
+            /// Transition table, `alphabet_size` entries per state. Made with calloc, so the rows the cache doesn't
+            /// reach take no memory.
+            std::atomic<uint32_t>* table;
+
+            /// States, those past count aren't there
+            std::unique_ptr<State[]> states;
+
+            /// Number of states handed out, it may exceed capacity
+            std::atomic<uint32_t> count;
+
+            /// Hashtable of the states by set of NFA states, open addressing. Each slot is 0 or a state plus one.
+            std::unique_ptr<std::atomic<uint32_t>[]> slots;
+
+            /// Number of slots minus one, a power of two minus one
+            size_t slotMask;
+
+            /// Estimated number of bytes used by the states
+            std::atomic<size_t> memoryUsed;
+
+            /// Initial state plus one, 0 if not built
+            std::atomic<uint32_t> start;
+        };
+
+        /// Epoch in which a Scanner started reading the cache
+        struct Participant {
+            /// The epoch, 0 if the Scanner doesn't read the cache
+            std::atomic<uint64_t> epoch;
+        };
+
+        /// Returns the state for T in generation g, or unknown_state if g has no room for it
+        state_id findOrAddState(Generation* g, nfa_state_set_type const& T, bool is_end);
+
+        /// Replaces generation g by a new one, unless another thread did it already. Returns the current generation.
+        Generation* flush(Generation* g);
+
+        /// Frees the retired generations no Scanner reads anymore. mutex_ must be held.
+        void reclaim();
+
+        /// Registers a Scanner
+        Participant* enroll();
+
+        /// Unregisters a Scanner
+        void withdraw(Participant* participant);
+
+        /// Estimated number of bytes a state with the given number of NFA states uses
+        static size_t stateCost(size_t nfa_state_count);
+
+        /// Compiled NFA
+        std::shared_ptr<const Program> program_;
+
+        /// Memory budget of the cache
+        size_t memoryBudget_;
+
+        /// Maximum number of states of a generation
+        size_t capacity_;
+
+        /// Current generation
+        std::atomic<Generation*> current_;
+
+        /// Current epoch, incremented whenever a generation retires
+        std::atomic<uint64_t> epoch_;
+
+        /// Number of flushes so far
+        std::atomic<size_t> flushCount_;
+
+        /// Number of fallbacks to the NFA so far
+        std::atomic<size_t> fallbackCount_;
+
+        /// Guards participants_ and retired_. A generation can't be freed while it is held.
+        mutable std::mutex mutex_;
+
+        /// Registered scanners
+        std::vector<std::unique_ptr<Participant> > participants_;
+
+        /// Generations replaced by a newer one, with the epoch they were retired in
+        std::vector<std::pair<Generation*, uint64_t> > retired_;
+    };
+}
+
+#endif //MYREGEX_SHAREDLAZYDFA_H
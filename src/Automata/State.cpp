@@ -31,18 +31,20 @@
  */
 //</editor-fold>
 
+#include <utility>
+
 #include "State.h"
 #include "Transition.h"
 
 namespace Automata {
 
-    State::State(std::string name, bool is_end, size_t bucket_count)
-            : name_(name),
+    State::State(std::string name, bool is_end, Arena &arena, size_t bucket_count)
+            : name_(std::move(name)),
               is_end_(is_end) {
-        transitions_ = new Set<Transition, Transition::Hasher>(bucket_count);
+        transitions_ = arena.create<transition_set_type>(bucket_count, transition_allocator_type(arena));
     }
 
-    std::string State::name() const {
+    std::string const& State::name() const {
         return name_;
     }
 
@@ -61,7 +63,7 @@ namespace Automata {
     }
 
     void State::setName(std::string name) {
-        name_ = name;
+        name_ = std::move(name);
     }
 
     State::transition_set_type & State::transition_set() {
@@ -73,7 +75,6 @@ namespace Automata {
     }
 
     State::~State() {
-//        delete transitions_;
     }
 
 }
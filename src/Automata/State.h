@@ -41,6 +41,7 @@
 #include <vector>
 
 #include "../Set/Set.h"
+#include "../Memory/Arena.h"
 
 #include "Transition.h"
 
@@ -69,12 +70,19 @@ namespace Automata {
      *
      * Adding an indentical transition has no effect on the set and therefore
      * isn't added.
+     *
+     * The transition set is allocated in an Arena, usually the one of the NFA the state
+     * belongs to, and copies of a state share it. So the arena must outlive the state and
+     * all of its copies.
     */
     class State {
 
     public:
+        /// Allocator of the transition sets
+        typedef ArenaAllocator<std::pair<Transition, bool> > transition_allocator_type;
+
         /// Set of transitions
-        typedef Set<Transition, Transition::Hasher> transition_set_type;
+        typedef Set<Transition, Transition::Hasher, std::equal_to<Transition>, transition_allocator_type> transition_set_type;
 
         /**
          * @class Hasher
@@ -86,7 +94,7 @@ namespace Automata {
         struct Hasher {
             std::hash<std::string> h;
         public:
-            size_t operator()(State state) const {
+            size_t operator()(State const& state) const {
                 size_t hash = 0;
                 hash = h(state.name());
                 return hash;
@@ -98,12 +106,18 @@ namespace Automata {
          * @brief Constructs a state given a unique name and whether the state is final or not
          * @param name Name of state
          * @param is_end `true` if the state is final, `false` otherwise
-         * @param bucket_count Number of buckets to be used for a transition set
+         * @param arena Arena the transition set is allocated in
+         * @param bucket_count Number of transitions to make room for, the transition set grows past it
          */
-        State(std::string name, bool is_end = false, size_t bucket_count = 100);
+        State(std::string name, bool is_end, Arena &arena, size_t bucket_count = 2);
+
+        State(State const& state) = default;
+        State(State&& state) = default;
+        State& operator=(State const& state) = default;
+        State& operator=(State&& state) = default;
 
         /**
-         * @brief Destructor for state
+         * @brief Destructor for state. The transition set is released with its arena.
          */
         ~State();
 
@@ -130,7 +144,7 @@ namespace Automata {
          * @brief Returns the name of the state
          * @return Name of state
          */
-        std::string name() const;
+        std::string const& name() const;
 
         /**
          * @brief Returns whether the state is final or not
@@ -154,7 +168,7 @@ namespace Automata {
         /// Name of state. Must be unique.
         std::string name_; // this attribute must be unique to each state
 
-        /// Set of transitons
+        /// Set of transitons, owned by the arena
         transition_set_type *transitions_;
 
         /// Whether state is final
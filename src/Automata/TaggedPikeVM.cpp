@@ -0,0 +1,155 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file TaggedPikeVM.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26
+ *
+ * # Description
+ * This is the .cpp file which contains the implementation for all the methods declared in the header file TaggedPikeVM.h
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#include <algorithm>
+
+#include "TaggedPikeVM.h"
+
+namespace Automata {
+
+    TaggedPikeVM::TaggedPikeVM()
+            : slotCount_(0)
+    {}
+
+    TaggedPikeVM::TaggedPikeVM(std::shared_ptr<const Program> program)
+            : program_(program),
+              slotCount_(program->slot_count()),
+              current_(program->state_count()),
+              next_(program->state_count()),
+              currentSlots_(program->state_count() * program->slot_count()),
+              nextSlots_(program->state_count() * program->slot_count()),
+              scratch_(program->slot_count())
+    {
+        // a state is pushed at most once per epsilon transition leading to it, and its slot restored once
+        stack_.reserve(program->epsilon_count() + program->state_count() + 1);
+    }
+
+    bool TaggedPikeVM::match(const char *first, const char *last, size_t *slots) {
+        if (!program_ || program_->state_count() == 0)
+            return false;
+
+        std::fill(scratch_.begin(), scratch_.end(), Program::no_position);
+        current_.clear();
+        addThread(current_, currentSlots_.data(), program_->start(), 0);
+
+        for (const char* it = first; it != last; it++)
+        {
+            unsigned char c = static_cast<unsigned char>(*it);
+            size_t position = static_cast<size_t>(it - first) + 1;
+
+            // the threads are stepped in order of preference, so the next set is in that order too
+            next_.clear();
+            for (SparseSet::const_iterator s_it = current_.cbegin(); s_it != current_.cend(); s_it++)
+            {
+                for (Program::Edge const* e_it = program_->edges_begin(*s_it);
+                     e_it != program_->edges_end(*s_it); e_it++)
+                {
+                    if (e_it->contains(c))
+                    {
+                        size_t const* row = currentSlots_.data() + *s_it * slotCount_;
+                        std::copy(row, row + slotCount_, scratch_.begin());
+                        addThread(next_, nextSlots_.data(), e_it->target, position);
+                    }
+                    else if (e_it->first > c) // transitions are sorted by their first symbol
+                        break;
+                }
+            }
+
+            current_.swap(next_);
+            currentSlots_.swap(nextSlots_);
+            if (current_.empty())
+                return false;
+        }
+
+        for (SparseSet::const_iterator s_it = current_.cbegin(); s_it != current_.cend(); s_it++)
+        {
+            if (program_->isEnd(*s_it))
+            {
+                size_t const* row = currentSlots_.data() + *s_it * slotCount_;
+                std::copy(row, row + slotCount_, slots);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    size_t TaggedPikeVM::slot_count() const {
+        return slotCount_;
+    }
+
+    void TaggedPikeVM::addThread(SparseSet &set, size_t *table, Program::state_id s, size_t position) {
+        if (set.contains(s))
+            return;
+
+        Frame visit = {s, Program::no_slot, 0};
+        stack_.push_back(visit);
+        while (!stack_.empty())
+        {
+            Frame top = stack_.back();
+            stack_.pop_back();
+
+            if (top.slot != Program::no_slot) // going back up past a save state
+            {
+                scratch_[top.slot] = top.value;
+                continue;
+            }
+
+            if (!set.insert(top.state))
+                continue;
+
+            // the old value is restored once the states after this one are visited
+            uint32_t slot = program_->slot(top.state);
+            if (slot != Program::no_slot)
+            {
+                Frame restore = {top.state, slot, scratch_[slot]};
+                stack_.push_back(restore);
+                scratch_[slot] = position;
+            }
+
+            std::copy(scratch_.begin(), scratch_.end(), table + top.state * slotCount_);
+
+            // push in reverse so the preferred transition is followed first
+            for (Program::state_id const* it = program_->epsilon_end(top.state);
+                 it != program_->epsilon_begin(top.state);)
+            {
+                --it;
+                if (!set.contains(*it))
+                {
+                    Frame next = {*it, Program::no_slot, 0};
+                    stack_.push_back(next);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,146 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file TaggedPikeVM.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the class TaggedPikeVM.
+ *
+ * # Description
+ * This file contains the declarations of a matcher which simulates a Program like PikeVM, and also tells
+ * where each capture group of the pattern matched.
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#ifndef MYREGEX_TAGGEDPIKEVM_H
+#define MYREGEX_TAGGEDPIKEVM_H
+
+#include <memory>
+#include <vector>
+
+#include "Program.h"
+#include "../Set/SparseSet.h"
+
+namespace Automata {
+
+    /** @class TaggedPikeVM
+     * @author Carlos Brito (carlos.brito524@gmail.com)
+     * @date 10/14/26.
+     *
+     * @brief Simulates the NFA of a Program and records the positions of its capture slots
+     *
+     * # Description
+     * Each state of the current set is a thread which carries its own copy of the capture slots (see
+     * Program::slot()), in the `slot_count()` entries of its row in a table. The threads are kept in order
+     * of preference: the epsilon closures are followed depth first, preferred transition first, the
+     * threads of the next set are added in the order of the threads they come from, and a state already
+     * in a set keeps the thread which reached it first. A thread which reaches a state later can't win,
+     * since whatever it could match from there the earlier one matches as well and is preferred. So the
+     * first final thread once the string is consumed holds the slots a backtracking matcher would report,
+     * without the backtracking.
+     *
+     * The epsilon closures are computed on an explicit stack, which also holds the old values of the
+     * slots overwritten on the way, to restore them when the closure goes back up. The sets, tables and
+     * stack are allocated on construction, so a match does no heap allocation and costs
+     * \f$ O(n m k) \f$ in the worst case, where \f$ n \f$ is the length of the string, \f$ m \f$ the
+     * number of states and \f$ k \f$ the number of slots.
+     *
+     * Please see:
+     * Russ Cox, Regular Expression Matching: the Virtual Machine Approach (2009)
+     * https://swtch.com/~rsc/regexp/regexp2.html
+     */
+    class TaggedPikeVM {
+    public:
+        /// Constructs a matcher which matches nothing
+        TaggedPikeVM();
+
+        /// Constructs a matcher for a program
+        /**
+         * @param program Compiled automaton to simulate, with its epsilon transitions in order of preference
+         */
+        explicit TaggedPikeVM(std::shared_ptr<const Program> program);
+
+        /**
+         * @brief Returns true if the bytes in \f$ [first, last) \f$ are accepted by the automaton
+         * @param first Pointer to the first byte
+         * @param last Pointer past the last byte
+         * @param slots Array of `slot_count()` entries. On a match, set to the offset from first each slot
+         * was saved at by the preferred thread, or Program::no_position if it wasn't.
+         * @return true if string matches pattern, false otherwise
+         */
+        bool match(const char* first, const char* last, size_t* slots);
+
+        /// Returns the number of capture slots of the program
+        size_t slot_count() const;
+
+    private:
+        /// An entry of the stack of addThread(): a state to visit, or the old value of a slot to restore
+        struct Frame {
+            /// State to visit
+            Program::state_id state;
+
+            /// Slot to restore, or Program::no_slot if the frame is a state to visit
+            uint32_t slot;
+
+            /// Value to restore the slot to
+            size_t value;
+        };
+
+        /**
+         * @brief Adds the epsilon closure of state s to a set, in order of preference
+         * @param set Set of states the closure is added to
+         * @param table Slots of the threads of the set, the row of each new state is filled
+         * @param s State
+         * @param position Offset of the current byte, saved in the slots of the save states
+         */
+        void addThread(SparseSet &set, size_t* table, Program::state_id s, size_t position);
+
+        /// Compiled NFA
+        std::shared_ptr<const Program> program_;
+
+        /// Number of capture slots
+        size_t slotCount_;
+
+        /// Current set of threads
+        SparseSet current_;
+
+        /// Next set of threads
+        SparseSet next_;
+
+        /// Slots of the current threads, `slotCount_` per state
+        std::vector<size_t> currentSlots_;
+
+        /// Slots of the next threads, `slotCount_` per state
+        std::vector<size_t> nextSlots_;
+
+        /// Slots of the thread being followed through a closure
+        std::vector<size_t> scratch_;
+
+        /// Stack used while computing closures
+        std::vector<Frame> stack_;
+    };
+}
+
+#endif //MYREGEX_TAGGEDPIKEVM_H
@@ -38,11 +38,9 @@
 namespace Automata {
 
     Transition::Transition(State *source, State *destination, char symbol)
-            : source_(source),
-              destination_(destination),
-              symbol_(symbol),
-              source_name_(source->name()),
-              destination_name_(source->name())
+            : symbol_(symbol),
+              source_(source),
+              destination_(destination)
     {
     }
 
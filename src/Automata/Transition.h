@@ -26,9 +26,8 @@
  * @brief Header file for the Transition class
  *
  *
- * TODO:
- * - THIS CLASS LEAKS MEMORY
- * - THERE IS A POINTER NOT BEING ALLOCATED
+ * # TODO
+ * Nothing for the moment.
  */
 //</editor-fold>
 
@@ -57,17 +56,16 @@ namespace Automata {
         // Classes
         /**
          * @brief Hasher to hash a transition
+         *
+         * Two transitions are equal when they have the same states and symbol, so the hash is made of the
+         * addresses of the states, which never move while they belong to an NFA.
          */
         struct Hasher {
-            std::hash<std::string> h;
         public:
-            size_t operator()(Transition transition) const {
-                size_t hash = 0;
-                std::string unique_name = transition.source_name_
-                                          + std::string(1, transition.symbol())
-                                          + transition.destination_name_;
-
-                hash = h(unique_name);
+            size_t operator()(Transition const& transition) const {
+                size_t hash = reinterpret_cast<size_t>(transition.source_);
+                hash = hash * 31 + reinterpret_cast<size_t>(transition.destination_);
+                hash = hash * 31 + static_cast<unsigned char>(transition.symbol_);
                 return hash;
             }
         };
@@ -112,18 +110,6 @@ namespace Automata {
 
         /// To where the transition ends
         State *destination_;
-
-
-        /*
-         * NOTE:
-         * A note on the following two variables.
-         * We should be able to access the names using the pointers defined above.
-         * However, we need the definition of State in Hasher. Because they are
-         * codependent, this means we won't be able to access the names.
-         * Instead, AS A WORKAROUND, we store them directly.
-         */
-        std::string source_name_;
-        std::string destination_name_;
     };
 
     inline bool operator==(Transition const &lhs, Transition const &rhs) {
@@ -0,0 +1,632 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file FlatHashtable.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * This header file has been compiled for C++11.
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#ifndef MYREGEX_FLATHASHTABLE_H
+#define MYREGEX_FLATHASHTABLE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// - - - - - - - - CLASS DEFINITION  - - - - - - - - //
+/** @class flat_hashtable
+* # Description
+*
+* This is a hashtable with open addressing and Robin Hood hashing, with the same interface as `hashtable`.
+*
+* The entries live in a single array of slots, so a lookup touches one or two cache lines instead of
+* following the nodes of a list. A key is looked for from its home slot onwards, and on insertion an entry
+* which is further from its home slot than the one in the way takes its place (the rich give to the poor).
+* This keeps every entry close to its home slot, so lookups stay short even at high load, and a miss
+* stops as soon as it meets an entry closer to its home than the key would be. Erasing shifts the
+* following entries back, there are no tombstones.
+*
+* The number of slots is a power of two and doubles whenever the load factor would exceed
+* `max_load_factor`, so the bucket count given on construction is only a hint.
+*
+* Keys with the same hash end up in a run of consecutive slots, so a poor hash makes lookups as slow as
+* in a long bucket of `hashtable`, but never makes the hashtable grow.
+*
+* The slots are allocated with `Allocator`, for example an ArenaAllocator during the construction of an automaton.
+*
+* Inserting may move the entries, which invalidates every iterator, pointer and reference to them.
+* Erasing invalidates the ones to the entries after the erased one.
+*/
+template <
+        class Key,
+        class T,
+        class Hasher = std::hash<Key>,
+        class KeyEqual = std::equal_to<Key>,
+        class Allocator = std::allocator<std::pair<Key, T> >
+>
+class flat_hashtable {
+
+public:
+    // TYPEDEFS
+    typedef flat_hashtable<Key,T,Hasher,KeyEqual,Allocator> self_type;
+    typedef typename std::pair<Key, T> hash_entry_type;
+    typedef Allocator allocator_type;
+
+    /// Maximum ratio of entries to slots, as a fraction of 8
+    static const size_t max_load_eighths = 7;
+
+    /// Smallest number of slots
+    static const size_t min_bucket_count = 8;
+
+    // CLASSES
+
+    /// Class iterator
+    class iterator {
+    public:
+        typedef iterator self_type;
+        typedef int difference_type;
+        typedef hash_entry_type& reference;
+        typedef hash_entry_type value_type;
+        typedef hash_entry_type* pointer;
+
+        iterator(flat_hashtable& table, size_t index)
+                : t_(&table),
+                  index_(index)
+        {}
+
+        self_type& operator++() { // prefix
+            index_ = t_->next(index_ + 1);
+            return *this;
+        }
+
+        self_type operator++(int dummy) { // postfix
+            self_type it = *this; ++(*this); return it;
+        }
+
+        reference operator*() { return t_->slots_[index_]; }
+        pointer operator->() { return &t_->slots_[index_]; }
+
+        bool operator==(const self_type& rhs) const { return index_ == rhs.index_ && t_ == rhs.t_; }
+        bool operator!=(const self_type& rhs) const { return !(*this == rhs); }
+
+    private:
+        flat_hashtable* t_;
+        size_t index_;
+    };
+
+    /// Class const_iterator
+    class const_iterator {
+    public:
+        typedef const_iterator self_type;
+        typedef int difference_type;
+        typedef hash_entry_type const& reference;
+        typedef hash_entry_type value_type;
+        typedef hash_entry_type const* pointer;
+
+        const_iterator(flat_hashtable const& table, size_t index)
+                : t_(&table),
+                  index_(index)
+        {}
+
+        self_type& operator++() { // prefix
+            index_ = t_->next(index_ + 1);
+            return *this;
+        }
+
+        self_type operator++(int dummy) { // postfix
+            self_type it = *this; ++(*this); return it;
+        }
+
+        reference operator*() const { return t_->slots_[index_]; }
+        pointer operator->() const { return &t_->slots_[index_]; }
+
+        bool operator==(const self_type& rhs) const { return index_ == rhs.index_ && t_ == rhs.t_; }
+        bool operator!=(const self_type& rhs) const { return !(*this == rhs); }
+
+    private:
+        flat_hashtable const* t_;
+        size_t index_;
+    };
+
+    friend class iterator;
+    friend class const_iterator;
+
+    // METHODS
+public:
+
+    /// Constructs an empty hashtable
+    flat_hashtable()
+            : slots_(nullptr),
+              distances_(nullptr),
+              mask_(0),
+              count_(0)
+    {}
+
+    /// Constructs an empty hashtable with room for the specified number of objects
+    explicit flat_hashtable(const size_t buckets)
+            : slots_(nullptr),
+              distances_(nullptr),
+              mask_(0),
+              count_(0)
+    {
+        reserve(buckets);
+    }
+
+    /// Constructs an empty hashtable which allocates its slots with the allocator
+    flat_hashtable(const size_t buckets, allocator_type const& alloc)
+            : slots_(nullptr),
+              distances_(nullptr),
+              mask_(0),
+              count_(0),
+              alloc_(alloc)
+    {
+        reserve(buckets);
+    }
+
+    /// Copies a hashtable. The copy allocates with a copy of its allocator.
+    flat_hashtable(self_type const& table)
+            : slots_(nullptr),
+              distances_(nullptr),
+              mask_(0),
+              count_(0),
+              h_(table.h_),
+              equal_to_(table.equal_to_),
+              alloc_(table.alloc_)
+    {
+        copyFrom(table);
+    }
+
+    flat_hashtable(self_type&& table)
+            : slots_(table.slots_),
+              distances_(table.distances_),
+              mask_(table.mask_),
+              count_(table.count_),
+              h_(table.h_),
+              equal_to_(table.equal_to_),
+              alloc_(table.alloc_)
+    {
+        table.slots_ = nullptr;
+        table.distances_ = nullptr;
+        table.mask_ = 0;
+        table.count_ = 0;
+    }
+
+    ~flat_hashtable() {
+        destroy();
+    }
+
+    /**
+     * @brief Overload of the operator `=`
+     *
+     * This operator overwrites the left hand side value completely. The left hand side keeps its allocator.
+     *
+     * @param rhs Hashtable to be copied
+     * @return Reference to new object
+     */
+    self_type& operator=(self_type const& rhs) {
+        if (this != &rhs)
+        {
+            destroy();
+            h_ = rhs.h_;
+            equal_to_ = rhs.equal_to_;
+            copyFrom(rhs);
+        }
+        return *this;
+    }
+
+    /// Moves a hashtable, its slots and its allocator
+    self_type& operator=(self_type&& rhs) {
+        if (this != &rhs)
+        {
+            destroy();
+            slots_ = rhs.slots_;
+            distances_ = rhs.distances_;
+            mask_ = rhs.mask_;
+            count_ = rhs.count_;
+            h_ = rhs.h_;
+            equal_to_ = rhs.equal_to_;
+            alloc_ = rhs.alloc_;
+
+            rhs.slots_ = nullptr;
+            rhs.distances_ = nullptr;
+            rhs.mask_ = 0;
+            rhs.count_ = 0;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Inserts an element using its key into hashtable
+     *
+     * If the key is already in the hashtable, nothing is inserted.
+     *
+     * @param key key of object
+     * @param obj object
+     * @return iterator pointing to the inserted object, or to the object with the same key
+     *
+     * # Complexity
+     * - Average \f$ O(1) \f$
+     * - Worst \f$ O(n) \f$
+     */
+    iterator insert(Key const& key, T const& obj) {
+        size_t found = lookup(key);
+        if (found != bucket_count())
+            return iterator(*this, found);
+
+        if ((count_ + 1) * 8 > bucket_count() * max_load_eighths)
+            rehash(bucket_count() == 0 ? min_bucket_count : 2 * bucket_count());
+
+        return iterator(*this, place(hash_entry_type(key, obj)));
+    }
+
+    /**
+     * @brief Finds an element in the hashtable
+     *
+     * @param key key of object to find
+     * @return an iterator pointing to the object, if object isn't found then return `end()`
+     *
+     * # Complexity
+     * - Average \f$ O(1) \f$
+     * - Worst \f$ O(n) \f$
+     */
+    iterator find(Key const& key) {
+        return iterator(*this, lookup(key));
+    }
+
+    /**
+     * @brief Finds an element in the hashtable. See `find(Key key)`.
+     *
+     * @param key key of object
+     * @return a const iterator pointing to the object, if object isn't found then return cend()
+     */
+    const_iterator find(Key const& key) const {
+        return const_iterator(*this, lookup(key));
+    }
+
+    /**
+     * @brief Erases an object by its key
+     *
+     * It the specified key isn't found then it has no effect
+     * @param key key of object
+     */
+    void erase(Key const& key) {
+        size_t i = lookup(key);
+        if (i == bucket_count())
+            return;
+
+        // shift the following entries of the run back by one slot
+        slots_[i].~hash_entry_type();
+        size_t j = (i + 1) & mask_;
+        while (distances_[j] > 1)
+        {
+            new (&slots_[i]) hash_entry_type(std::move(slots_[j]));
+            slots_[j].~hash_entry_type();
+            distances_[i] = static_cast<uint32_t>(distances_[j] - 1);
+            i = j;
+            j = (j + 1) & mask_;
+        }
+        distances_[i] = 0;
+        count_--;
+    }
+
+    /**
+     * @brief Returns true if the key is found in the hashtable
+     * @param key Key of object
+     * @return `true` if key is found, `false` otherwise
+     */
+    bool contains_key(Key const& key) const {
+        return lookup(key) != bucket_count();
+    }
+
+    /// Removes every object, keeping the slots
+    void clear() {
+        for (size_t i = 0; i < bucket_count(); i++)
+            if (distances_[i])
+            {
+                slots_[i].~hash_entry_type();
+                distances_[i] = 0;
+            }
+        count_ = 0;
+    }
+
+    /// Makes room for the specified number of objects without growing
+    void reserve(size_t count) {
+        size_t buckets = min_bucket_count;
+        while (buckets * max_load_eighths < count * 8)
+            buckets *= 2;
+
+        if (buckets > bucket_count())
+            rehash(buckets);
+    }
+
+    /**
+     * @brief  Returns the number of slots in the hashtable
+     * @return Number of slots in hashtable
+     */
+    size_t bucket_count() const {
+        return slots_ ? mask_ + 1 : 0;
+    }
+
+    /**
+     * @brief Returns an iterator to the first object of the hashtable
+     *
+     * If the hashtable is empty, then it will return `end()`.
+     *
+     * @return Iterator pointing to the beginning of hashtable
+     */
+    iterator begin() {
+        return iterator(*this, next(0));
+    }
+
+    /// Returns an iterator past the last object of the hashtable
+    iterator end() {
+        return iterator(*this, bucket_count());
+    }
+
+    /// Returns a const iterator to the first object of the hashtable. See `begin()`.
+    const_iterator cbegin() const {
+        return const_iterator(*this, next(0));
+    }
+
+    /// Returns a const iterator past the last object of the hashtable. See `end()`.
+    const_iterator cend() const {
+        return const_iterator(*this, bucket_count());
+    }
+
+    /**
+     * @brief Returns a reference to the object with the specified key
+     * @param key Key of object
+     * @return Reference to hashtable object
+     * @throws std::out_of_range if the key isn't in the hashtable
+     */
+    T& at(Key const& key) {
+        size_t i = lookup(key);
+        if (i == bucket_count())
+            throw std::out_of_range("flat_hashtable::at");
+        return slots_[i].second;
+    }
+
+    /**
+     * @brief Returns a const reference to the object with the specified key
+     * @param key Key of object
+     * @return Const reference to object
+     * @throws std::out_of_range if the key isn't in the hashtable
+     */
+    const T& at(Key const& key) const {
+        size_t i = lookup(key);
+        if (i == bucket_count())
+            throw std::out_of_range("flat_hashtable::at");
+        return slots_[i].second;
+    }
+
+    /// Returns a reference to the object with the specified key. See `at()`.
+    T& operator[](Key const& key) {
+        return at(key);
+    }
+
+    /// Returns a const reference to the object with the specified key. See `at()`.
+    const T& operator[](Key const& key) const {
+        return at(key);
+    }
+
+    /**
+     * @brief Returns the object count in the hashtable
+     * @return Count of objects in hashtable
+     */
+    size_t count() const {
+        return count_;
+    }
+
+    /// Returns a copy of the allocator of the slots
+    allocator_type get_allocator() const {
+        return alloc_;
+    }
+
+    /**
+     * @brief Returns the load factor of the hashtable
+     *
+     * This value is calculated as follows:
+     * \f$ n/k \f$
+     *
+     * Where:
+     * $n$ is the number of objects in the hashtable
+     * $k$ is the number of slots in the hashtable
+     *
+     * @return Load factor of hashtable
+     */
+    double load_factor() const {
+        return bucket_count() == 0 ? 0.0 : static_cast<double>(count_) / bucket_count();
+    }
+
+private:
+    /// Returns the home slot of a key. The hash is scrambled, so keys with a poor hash like pointers spread well.
+    size_t home(Key const& key) const {
+        uint64_t hash = static_cast<uint64_t>(h_(key)) * 0x9E3779B97F4A7C15ull; // Fibonacci hashing
+        return static_cast<size_t>(hash >> 32) & mask_;
+    }
+
+    /// Returns the slot of the key, or `bucket_count()` if it isn't in the hashtable
+    size_t lookup(Key const& key) const {
+        if (count_ == 0)
+            return bucket_count();
+
+        size_t i = home(key);
+        for (size_t distance = 1; distances_[i] >= distance; distance++)
+        {
+            if (distances_[i] == distance && equal_to_(slots_[i].first, key))
+                return i;
+            i = (i + 1) & mask_;
+        }
+        return bucket_count();
+    }
+
+    /// Places an entry whose key isn't in the hashtable, which must have a free slot. Returns its slot.
+    size_t place(hash_entry_type&& entry) {
+        size_t i = home(entry.first);
+        size_t placed = bucket_count();
+        size_t distance = 1;
+        hash_entry_type carried(std::move(entry));
+
+        while (distances_[i] != 0)
+        {
+            if (distances_[i] < distance) // take the place of the richer entry and carry it on
+            {
+                exchange(slots_[i], carried);
+                size_t richer = distances_[i];
+                distances_[i] = static_cast<uint32_t>(distance);
+                distance = richer;
+                if (placed == bucket_count())
+                    placed = i;
+            }
+
+            i = (i + 1) & mask_;
+            distance++;
+        }
+
+        new (&slots_[i]) hash_entry_type(std::move(carried));
+        distances_[i] = static_cast<uint32_t>(distance);
+        count_++;
+        return placed == bucket_count() ? i : placed;
+    }
+
+    /// Swaps two entries. Entries are only ever constructed, so keys without an assignment operator can be used.
+    static void exchange(hash_entry_type& a, hash_entry_type& b) {
+        hash_entry_type tmp(std::move(a));
+        a.~hash_entry_type();
+        new (&a) hash_entry_type(std::move(b));
+        b.~hash_entry_type();
+        new (&b) hash_entry_type(std::move(tmp));
+    }
+
+    /// Moves every entry to a new array of slots
+    void rehash(size_t buckets) {
+        hash_entry_type* old_slots = slots_;
+        uint32_t* old_distances = distances_;
+        size_t old_buckets = bucket_count();
+
+        allocateSlots(buckets);
+        for (size_t i = 0; i < old_buckets; i++)
+            if (old_distances[i])
+            {
+                place(std::move(old_slots[i]));
+                old_slots[i].~hash_entry_type();
+            }
+
+        if (old_slots)
+            deallocateSlots(old_slots, old_distances, old_buckets);
+    }
+
+    /// Returns the first occupied slot from i, or `bucket_count()`
+    size_t next(size_t i) const {
+        while (i < bucket_count() && distances_[i] == 0)
+            i++;
+        return i;
+    }
+
+    /// Copies the entries of another hashtable into this empty one
+    void copyFrom(self_type const& table) {
+        if (table.bucket_count() == 0)
+            return;
+
+        allocateSlots(table.bucket_count());
+        for (size_t i = 0; i < bucket_count(); i++)
+            if (table.distances_[i])
+            {
+                new (&slots_[i]) hash_entry_type(table.slots_[i]);
+                distances_[i] = table.distances_[i];
+            }
+        count_ = table.count_;
+    }
+
+    /// Destroys every entry and releases the slots
+    void destroy() {
+        clear();
+        if (slots_)
+            deallocateSlots(slots_, distances_, bucket_count());
+
+        slots_ = nullptr;
+        distances_ = nullptr;
+        mask_ = 0;
+    }
+
+    typedef std::allocator_traits<allocator_type> traits_type;
+    typedef typename traits_type::template rebind_alloc<uint32_t> distance_allocator_type;
+    typedef std::allocator_traits<distance_allocator_type> distance_traits_type;
+
+    /// Replaces the slots by the specified number of free slots, without releasing the old ones
+    void allocateSlots(size_t buckets) {
+        distance_allocator_type distance_alloc(alloc_);
+        slots_ = traits_type::allocate(alloc_, buckets);
+        distances_ = distance_traits_type::allocate(distance_alloc, buckets);
+        std::fill(distances_, distances_ + buckets, 0);
+        mask_ = buckets - 1;
+        count_ = 0;
+    }
+
+    /// Releases slots whose entries have been destroyed
+    void deallocateSlots(hash_entry_type* slots, uint32_t* distances, size_t buckets) {
+        distance_allocator_type distance_alloc(alloc_);
+        traits_type::deallocate(alloc_, slots, buckets);
+        distance_traits_type::deallocate(distance_alloc, distances, buckets);
+    }
+
+    // VARIABLES
+private:
+    /// Entries, only the slots whose distance isn't 0 hold one
+    hash_entry_type* slots_;
+
+    /// Distance of the entry of each slot from its home slot, plus one. 0 for a free slot.
+    uint32_t* distances_;
+
+    /// Number of slots minus one
+    size_t mask_;
+
+    /// Number of inserted elements
+    size_t count_;
+
+    /// Hasher
+    Hasher h_;
+
+    /// Key comparator
+    KeyEqual equal_to_;
+
+    /// Allocator of the slots
+    allocator_type alloc_;
+};
+
+template <class Key, class T, class Hasher, class KeyEqual, class Allocator>
+const size_t flat_hashtable<Key,T,Hasher,KeyEqual,Allocator>::max_load_eighths;
+
+template <class Key, class T, class Hasher, class KeyEqual, class Allocator>
+const size_t flat_hashtable<Key,T,Hasher,KeyEqual,Allocator>::min_bucket_count;
+
+#endif //MYREGEX_FLATHASHTABLE_H
@@ -37,6 +37,7 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <utility>
 
 // - - - - - - - - CLASS DEFINITION  - - - - - - - - //
 /** @class hashtable
@@ -329,8 +330,9 @@ public:
         for (bucket_iterator it = b->begin(); it != b->end(); it++)
             if (equal_to_(key, it->first))
             {
-                b->erase(it); // erase entry
+                b->erase(it); // erase entry, keys are unique and it is no longer valid
                 count_--;
+                return;
             }
     }
 
@@ -570,12 +572,53 @@ public:
     hashtable(const hashtable& table) {
         bucket_count_ = table.bucket_count_;
         count_ = table.count_;
-        table_ = index_table(bucket_count_); // invalidate previous data, let the g.c. take care of it
+        table_.reserve(bucket_count_);
 
         for (int i = 0; i < bucket_count_; i++)
             table_.push_back( table.at(i) );
     }
 
+    /**
+     * @brief Moves a hashtable, in \f$ O(1) \f$
+     *
+     * The moved from hashtable has no buckets left, it can only be assigned to or destroyed.
+     *
+     * @param table Hashtable to be moved
+     */
+    hashtable(hashtable&& table)
+            : equal_to_(table.equal_to_),
+              table_(std::move(table.table_)),
+              h_(table.h_),
+              bucket_count_(table.bucket_count_),
+              count_(table.count_)
+    {
+        table.table_.clear();
+        table.bucket_count_ = 0;
+        table.count_ = 0;
+    }
+
+    /**
+     * @brief Overload of the move operator `=`
+     *
+     * See the move constructor for what is left in the right hand side.
+     *
+     * @param rhs Hashtable to be moved
+     * @return Reference to this object
+     */
+    self_type& operator=(self_type&& rhs) {
+        if (this != &rhs)
+        {
+            table_ = std::move(rhs.table_);
+            bucket_count_ = rhs.bucket_count_;
+            count_ = rhs.count_;
+
+            rhs.table_.clear();
+            rhs.bucket_count_ = 0;
+            rhs.count_ = 0;
+        }
+        return *this;
+    }
+
     // VARIABLES
 private:
     /// Key comparator
@@ -0,0 +1,162 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file Image.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the classes ImageWriter and ImageReader.
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#ifndef MYREGEX_IMAGE_H
+#define MYREGEX_IMAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/** @class ImageWriter
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Lays out arrays in a binary image which can be used in place once loaded
+ *
+ * # Description
+ * An image is a flat sequence of bytes in which every array starts at a multiple of `alignment` bytes
+ * from the start of the image. If the image itself is loaded at an address aligned as well (which is
+ * always the case of a file mapped in memory) its arrays can be read right where they lie, with no copy.
+ * Values are written in the byte order of the machine, the readers of an image check it.
+ */
+class ImageWriter {
+public:
+    /// Alignment of the arrays, in bytes
+    static const size_t alignment = 8;
+
+    /// Constructs a writer which appends to an image
+    explicit ImageWriter(std::vector<char> &image)
+            : image_(image)
+    {}
+
+    /// Pads the image with zeroes up to the next multiple of `alignment`
+    void align() {
+        image_.resize((image_.size() + alignment - 1) / alignment * alignment, 0);
+    }
+
+    /// Appends bytes to the image
+    void write(const void* data, size_t size) {
+        const char* bytes = static_cast<const char*>(data);
+        image_.insert(image_.end(), bytes, bytes + size);
+    }
+
+    /// Appends a value to the image
+    template <class T>
+    void write(T const& value) {
+        write(&value, sizeof(T));
+    }
+
+    /// Aligns the image and appends an array to it
+    template <class T>
+    void write_array(const T* data, size_t count) {
+        align();
+        write(data, count * sizeof(T));
+    }
+
+private:
+    std::vector<char> &image_;
+};
+
+/** @class ImageReader
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Reads the arrays of an image made by ImageWriter, in place
+ *
+ * # Description
+ * Every read checks that the bytes asked for lie in the image, and fails by returning `nullptr` or false
+ * otherwise, so a truncated or corrupted image is never read past its end.
+ */
+class ImageReader {
+public:
+    /// Constructs a reader for the image in \f$ [first, last) \f$. first must be aligned to ImageWriter::alignment.
+    ImageReader(const char* first, const char* last)
+            : first_(first),
+              it_(first),
+              last_(last)
+    {}
+
+    /// Skips the padding up to the next multiple of ImageWriter::alignment
+    bool align() {
+        size_t offset = static_cast<size_t>(it_ - first_);
+        size_t padding = (ImageWriter::alignment - offset % ImageWriter::alignment) % ImageWriter::alignment;
+        if (padding > static_cast<size_t>(last_ - it_))
+            return false;
+
+        it_ += padding;
+        return true;
+    }
+
+    /// Returns a pointer to the next size bytes and skips them, or `nullptr` if there aren't as many
+    const char* read(size_t size) {
+        if (size > static_cast<size_t>(last_ - it_))
+            return nullptr;
+
+        const char* data = it_;
+        it_ += size;
+        return data;
+    }
+
+    /// Reads a value, which doesn't need to be aligned
+    template <class T>
+    bool read_value(T &value) {
+        const char* data = read(sizeof(T));
+        if (!data)
+            return false;
+
+        std::memcpy(&value, data, sizeof(T));
+        return true;
+    }
+
+    /// Aligns and returns a pointer to the next array of count values, or `nullptr` if it isn't in the image
+    template <class T>
+    const T* read_array(size_t count) {
+        if (!align() || count > static_cast<size_t>(last_ - it_) / sizeof(T))
+            return nullptr;
+
+        return reinterpret_cast<const T*>(read(count * sizeof(T)));
+    }
+
+    /// Returns a pointer to the next byte to read
+    const char* position() const {
+        return it_;
+    }
+
+private:
+    const char* first_;
+    const char* it_;
+    const char* last_;
+};
+
+#endif //MYREGEX_IMAGE_H
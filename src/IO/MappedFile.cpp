@@ -0,0 +1,161 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file MappedFile.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26
+ *
+ * # Description
+ * This is the .cpp file which contains the implementation for all the methods declared in the header file MappedFile.h
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#include "MappedFile.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MYREGEX_HAS_MMAP 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+        : data_(nullptr),
+          size_(0),
+          open_(false),
+          mapped_(false),
+          fd_(-1)
+{}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(std::string const &path) {
+    close();
+
+#ifdef MYREGEX_HAS_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    // a pipe can't be opened twice, keep the descriptor to read it
+    open_ = true;
+    if (!S_ISREG(info.st_mode))
+    {
+        fd_ = fd;
+        return true;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    if (size > 0)
+    {
+        void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED)
+        {
+            fd_ = fd;
+            return true;
+        }
+
+        // hints only, the mapping works the same if the kernel ignores them
+        madvise(addr, size, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+        madvise(addr, size, MADV_HUGEPAGE);
+#endif
+        data_ = static_cast<const char*>(addr);
+    }
+
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+    size_ = size;
+    mapped_ = true;
+    return true;
+#else
+    (void) path;
+    return false;
+#endif
+}
+
+void MappedFile::close() {
+#ifdef MYREGEX_HAS_MMAP
+    if (data_)
+        munmap(const_cast<char*>(data_), size_);
+    if (fd_ >= 0)
+        ::close(fd_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+    mapped_ = false;
+    fd_ = -1;
+}
+
+bool MappedFile::is_open() const {
+    return open_;
+}
+
+bool MappedFile::is_mapped() const {
+    return mapped_;
+}
+
+bool MappedFile::read(char *buffer, size_t size, size_t &count) {
+    count = 0;
+#ifdef MYREGEX_HAS_MMAP
+    if (fd_ < 0)
+        return false;
+
+    ssize_t result;
+    do
+    {
+        result = ::read(fd_, buffer, size);
+    } while (result < 0 && errno == EINTR);
+
+    if (result < 0)
+        return false;
+
+    count = static_cast<size_t>(result);
+    return true;
+#else
+    (void) buffer;
+    (void) size;
+    return false;
+#endif
+}
+
+const char* MappedFile::data() const {
+    return data_;
+}
+
+size_t MappedFile::size() const {
+    return size_;
+}
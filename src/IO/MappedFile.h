@@ -0,0 +1,106 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file MappedFile.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the class MappedFile.
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#ifndef MYREGEX_MAPPEDFILE_H
+#define MYREGEX_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+/** @class MappedFile
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief A read only file mapped in memory
+ *
+ * # Description
+ * The whole file is mapped with `mmap` and the kernel is told it will be read sequentially, so it reads
+ * ahead aggressively and drops the pages behind. Where the kernel supports it the mapping may also be
+ * backed by huge pages. A file which can't be mapped, like a pipe, is kept open instead and read() reads
+ * it in chunks from the same descriptor: a pipe can't be opened a second time without breaking it. On
+ * systems without `mmap` open() fails and the file has to be read some other way.
+ *
+ * The mapping is released when the object is destroyed.
+ */
+class MappedFile {
+public:
+    /// Constructs an object with no file mapped
+    MappedFile();
+
+    /// Unmaps or closes the file
+    ~MappedFile();
+
+    /**
+     * @brief Opens and maps a file, closing the previous one
+     * @param path Path of the file
+     * @return true if the file was opened, mapped or not (see is_mapped()), false otherwise
+     */
+    bool open(std::string const& path);
+
+    /// Unmaps or closes the file
+    void close();
+
+    /// Returns true if a file is open
+    bool is_open() const;
+
+    /// Returns true if the open file is mapped, data() and size() are then its content
+    bool is_mapped() const;
+
+    /**
+     * @brief Reads the next bytes of an open file which isn't mapped
+     * @param buffer Buffer to read into
+     * @param size Size of the buffer
+     * @param count Set to the number of bytes read, 0 at the end of the file
+     * @return false if the file can't be read
+     */
+    bool read(char* buffer, size_t size, size_t& count);
+
+    /// Returns a pointer to the first byte of the file. May be `nullptr` if the file is empty.
+    const char* data() const;
+
+    /// Returns the size of the file, in bytes
+    size_t size() const;
+
+private:
+    MappedFile(MappedFile const&);
+    MappedFile& operator=(MappedFile const&);
+
+    const char* data_;
+    size_t size_;
+    bool open_;
+    bool mapped_;
+
+    /// Descriptor of an open file which isn't mapped, -1 otherwise
+    int fd_;
+};
+
+#endif //MYREGEX_MAPPEDFILE_H
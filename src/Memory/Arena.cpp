@@ -0,0 +1,95 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file Arena.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26
+ *
+ * # Description
+ * This is the .cpp file which contains the implementation for all the methods declared in the header file Arena.h
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#include <algorithm>
+
+#include "Arena.h"
+
+const size_t Arena::min_block_size;
+const size_t Arena::max_block_size;
+
+Arena::Arena()
+        : capacity_(0),
+          used_(0),
+          reserved_(0),
+          destructors_(nullptr)
+{}
+
+Arena::~Arena() {
+    release();
+}
+
+void Arena::release() {
+    for (Destructor* d = destructors_; d != nullptr; d = d->next)
+        d->destroy(d->object);
+    destructors_ = nullptr;
+
+    for (size_t i = 0; i < blocks_.size(); i++)
+        ::operator delete(blocks_[i]);
+
+    blocks_.clear();
+    capacity_ = 0;
+    used_ = 0;
+    reserved_ = 0;
+}
+
+size_t Arena::bytes_reserved() const {
+    return reserved_;
+}
+
+size_t Arena::block_count() const {
+    return blocks_.size();
+}
+
+void *Arena::allocateBlock(size_t size, size_t alignment) {
+    size_t block_size = blocks_.empty() ? min_block_size : std::min(2 * capacity_, max_block_size);
+    block_size = std::max(block_size, size + alignment); // large allocations get a block of their own
+
+    // operator new aligns to max_align_t, so stricter alignments are made up for with the slack above
+    char* block = static_cast<char*>(::operator new(block_size));
+    blocks_.push_back(block);
+    capacity_ = block_size;
+    reserved_ += block_size;
+
+    size_t offset = static_cast<size_t>(-reinterpret_cast<uintptr_t>(block)) & (alignment - 1);
+    used_ = offset + size;
+    return block + offset;
+}
+
+void Arena::addDestructor(void *object, void (*destroy)(void *)) {
+    Destructor* d = static_cast<Destructor*>(allocate(sizeof(Destructor), alignof(Destructor)));
+    d->destroy = destroy;
+    d->object = object;
+    d->next = destructors_;
+    destructors_ = d;
+}
@@ -0,0 +1,208 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file Arena.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the classes Arena and ArenaAllocator.
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#ifndef MYREGEX_ARENA_H
+#define MYREGEX_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/** @class Arena
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief A monotonic allocator which releases everything it allocated at once
+ *
+ * # Description
+ * Memory is handed out from large blocks by bumping a pointer, so an allocation costs a comparison and an
+ * addition, and is never given back on its own: the blocks are released all together by release() or by the
+ * destructor. The blocks double in size, up to `max_block_size`, so the number of calls to the system
+ * allocator is logarithmic in the memory used.
+ *
+ * Objects made with create() are destroyed, in reverse order of creation, when the arena is released.
+ *
+ * An arena must not be used from two threads at the same time.
+ */
+class Arena {
+public:
+    /// Size of the first block
+    static const size_t min_block_size = 4096;
+
+    /// Size past which blocks stop growing
+    static const size_t max_block_size = 1 << 20;
+
+    /// Constructs an arena which holds no memory
+    Arena();
+
+    /// Releases the memory of the arena
+    ~Arena();
+
+    /**
+     * @brief Allocates memory, which stays valid until the arena is released
+     * @param size Number of bytes
+     * @param alignment Alignment of the memory, a power of two
+     * @return Pointer to the memory
+     */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        if (!blocks_.empty())
+        {
+            char* block = blocks_.back();
+            size_t offset = used_ + (static_cast<size_t>(-reinterpret_cast<uintptr_t>(block + used_)) & (alignment - 1));
+            if (offset + size <= capacity_)
+            {
+                used_ = offset + size;
+                return block + offset;
+            }
+        }
+
+        return allocateBlock(size, alignment);
+    }
+
+    /**
+     * @brief Constructs an object in the arena
+     *
+     * The object is destroyed when the arena is released, unless it is trivially destructible.
+     *
+     * @param args Arguments passed to the constructor
+     * @return Pointer to the object
+     */
+    template <class T, class... Args>
+    T* create(Args&&... args) {
+        T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if (!std::is_trivially_destructible<T>::value)
+            addDestructor(object, &destroy<T>);
+        return object;
+    }
+
+    /// Destroys the objects made with create() and releases every block
+    void release();
+
+    /// Returns the number of bytes of the blocks held
+    size_t bytes_reserved() const;
+
+    /// Returns the number of blocks held
+    size_t block_count() const;
+
+private:
+    Arena(Arena const&);
+    Arena& operator=(Arena const&);
+
+    /// An object to destroy on release
+    struct Destructor {
+        void (*destroy)(void*);
+        void* object;
+        Destructor* next;
+    };
+
+    template <class T>
+    static void destroy(void* object) {
+        static_cast<T*>(object)->~T();
+    }
+
+    /// Starts a new block with room for at least size bytes and allocates them from it
+    void* allocateBlock(size_t size, size_t alignment);
+
+    /// Records an object to destroy on release
+    void addDestructor(void* object, void (*destroy)(void*));
+
+    /// Blocks, the last one is the one memory is allocated from
+    std::vector<char*> blocks_;
+
+    /// Size of the last block
+    size_t capacity_;
+
+    /// Bytes used in the last block
+    size_t used_;
+
+    /// Total size of the blocks
+    size_t reserved_;
+
+    /// Objects to destroy, the last one created first
+    Destructor* destructors_;
+};
+
+/** @class ArenaAllocator
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Standard allocator which allocates from an Arena
+ *
+ * # Description
+ * Lets containers keep their memory in an arena. Deallocating does nothing, the memory comes back when the
+ * arena is released, so the arena must outlive the containers. Copies of an allocator allocate from the same
+ * arena.
+ */
+template <class T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+
+    /// Constructs an allocator which allocates from the arena
+    explicit ArenaAllocator(Arena& arena)
+            : arena_(&arena)
+    {}
+
+    template <class U>
+    ArenaAllocator(ArenaAllocator<U> const& other)
+            : arena_(other.arena())
+    {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) {}
+
+    /// Returns the arena allocated from
+    Arena* arena() const {
+        return arena_;
+    }
+
+private:
+    Arena* arena_;
+};
+
+template <class T, class U>
+bool operator==(ArenaAllocator<T> const& lhs, ArenaAllocator<U> const& rhs) {
+    return lhs.arena() == rhs.arena();
+}
+
+template <class T, class U>
+bool operator!=(ArenaAllocator<T> const& lhs, ArenaAllocator<U> const& rhs) {
+    return !(lhs == rhs);
+}
+
+#endif //MYREGEX_ARENA_H
@@ -0,0 +1,143 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file CharClass.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Implementation file for the class CharClass
+ *
+ */
+//</editor-fold>
+#include "CharClass.h"
+#include "TokenDecls.h"
+#include "RegexErrors.h"
+
+namespace Regex {
+
+    CharClass::CharClass()
+    {}
+
+    CharClass::CharClass(syntax::byte_set const &bytes)
+    {
+        for (unsigned int c = 0; c < 256; c++)
+            if (bytes.contains(c))
+                bytes_.set(c);
+    }
+
+    CharClass CharClass::of(Token const &token) {
+        std::string const& lexeme = token.lexeme();
+
+        if (token.tag() == TAG_DOT)
+            return any();
+
+        if (token.tag() == TAG_CLASS)
+        {
+            if (lexeme.size() < 3 || lexeme[0] != '[' || lexeme[lexeme.size() - 1] != ']')
+                throw ParserError();
+            return CharClass(syntax::bracket(lexeme.data(), 0, lexeme.size()));
+        }
+
+        if (token.tag() == TAG_ESCAPE_SEQUENCE)
+        {
+            size_t i = 0;
+            bool single;
+            return CharClass(syntax::escape(lexeme.data(), i, lexeme.size(), single));
+        }
+
+        if (token.tag() != TAG_CHAR || lexeme.size() != 1)
+            throw ParserError();
+
+        CharClass result;
+        result.add(static_cast<unsigned char>(lexeme[0]));
+        return result;
+    }
+
+    CharClass CharClass::digit() {
+        return CharClass(syntax::digit());
+    }
+
+    CharClass CharClass::word() {
+        return CharClass(syntax::word());
+    }
+
+    CharClass CharClass::space() {
+        return CharClass(syntax::space());
+    }
+
+    CharClass CharClass::any() {
+        return CharClass(syntax::any());
+    }
+
+    void CharClass::add(unsigned char c) {
+        bytes_.set(c);
+    }
+
+    void CharClass::add(unsigned char first, unsigned char last) {
+        for (size_t c = first; c <= last; c++)
+            bytes_.set(c);
+    }
+
+    void CharClass::add(CharClass const &other) {
+        bytes_ |= other.bytes_;
+    }
+
+    void CharClass::negate() {
+        bytes_.flip();
+    }
+
+    bool CharClass::contains(unsigned char c) const {
+        return bytes_.test(c);
+    }
+
+    size_t CharClass::count() const {
+        return bytes_.count();
+    }
+
+    unsigned char CharClass::front() const {
+        size_t c = 0;
+        while (c < bytes_.size() && !bytes_.test(c))
+            c++;
+        return static_cast<unsigned char>(c);
+    }
+
+    std::vector<Automata::ProgramBuilder::range_type> CharClass::ranges() const {
+        std::vector<Automata::ProgramBuilder::range_type> result;
+        size_t c = 0;
+        while (c < bytes_.size())
+        {
+            if (!bytes_.test(c))
+            {
+                c++;
+                continue;
+            }
+
+            size_t first = c;
+            while (c + 1 < bytes_.size() && bytes_.test(c + 1))
+                c++;
+            result.push_back(Automata::ProgramBuilder::range_type(static_cast<unsigned char>(first),
+                                                                    static_cast<unsigned char>(c)));
+            c++;
+        }
+        return result;
+    }
+
+}
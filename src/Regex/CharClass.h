@@ -0,0 +1,132 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file CharClass.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the class CharClass
+ *
+ * # Description
+ * This file contains the set of bytes a single token of a pattern matches.
+ *
+ */
+//</editor-fold>
+#ifndef MYREGEX_CHARCLASS_H
+#define MYREGEX_CHARCLASS_H
+
+#include <bitset>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Syntax.h"
+#include "Token.h"
+#include "../Automata/ProgramBuilder.h"
+
+namespace Regex {
+
+    /**
+     * @class CharClass
+     * @author Carlos Brito (carlos.brito524@gmail.com)
+     * @date 10/14/26.
+     *
+     * @brief Set of bytes matched by a character, an escape sequence, a bracket expression or the dot
+     *
+     * # Description
+     * The parser decodes every token which matches a single byte into a CharClass, and the automaton only
+     * sees its ranges(): `[a-z0-9]` is one state with two transitions instead of an alternation of 36
+     * symbols.
+     *
+     * The escape sequences are:
+     *
+     * - `\d`, `\w` and `\s` for digits, word characters (`[A-Za-z0-9_]`) and whitespace, and `\D`, `\W` and
+     * `\S` for their complements
+     * - `\n`, `\r`, `\t`, `\f`, `\v` and `\xHH` for the control characters and the byte of hexadecimal
+     * value `HH`
+     * - a backslash followed by any other character which isn't a letter or a digit for that character,
+     * like `\*` or `\[`
+     *
+     * A bracket expression is a list of characters, escape sequences and ranges `a-z` whose ends are single
+     * characters, negated if it starts with `^`. A `]` right after the opening bracket (or `[^`) and a `-`
+     * at either end are plain characters.
+     *
+     * The sequences and expressions are decoded by the constexpr functions of Syntax.h, which static_regex
+     * runs at compile time too.
+     */
+    class CharClass {
+    public:
+        /// Constructs an empty class
+        CharClass();
+
+        /// Returns the class matched by a token
+        /**
+         * @param token Token tagged TAG_CHAR, TAG_ESCAPE_SEQUENCE, TAG_CLASS or TAG_DOT
+         * @throws ParserError if the token is malformed, like `[z-a]` or `\q`
+         */
+        static CharClass of(Token const& token);
+
+        /// Class of the digits, `\d`
+        static CharClass digit();
+
+        /// Class of the word characters, `\w`
+        static CharClass word();
+
+        /// Class of the whitespace characters, `\s`
+        static CharClass space();
+
+        /// Class of every byte but the newline, `.`
+        static CharClass any();
+
+        /// Adds a byte to the class
+        void add(unsigned char c);
+
+        /// Adds the bytes from first to last, both included
+        void add(unsigned char first, unsigned char last);
+
+        /// Adds the bytes of another class
+        void add(CharClass const& other);
+
+        /// Replaces the class by its complement
+        void negate();
+
+        /// Returns true if c is in the class
+        bool contains(unsigned char c) const;
+
+        /// Returns the number of bytes of the class
+        size_t count() const;
+
+        /// Returns the smallest byte of the class, which must not be empty
+        unsigned char front() const;
+
+        /// Returns the class as a list of disjoint ranges, in increasing order
+        std::vector<Automata::ProgramBuilder::range_type> ranges() const;
+
+    private:
+        /// Constructs the class of the bytes decoded by syntax::escape() or syntax::bracket()
+        explicit CharClass(syntax::byte_set const& bytes);
+
+        /// Bytes of the class
+        std::bitset<256> bytes_;
+    };
+}
+
+#endif //MYREGEX_CHARCLASS_H
@@ -34,110 +34,54 @@
  */
 //</editor-fold>
 
-#include <iostream>
-#include <vector>
+#include <utility>
+
 #include "Lexer.h"
 #include "TokenDecls.h"
-#include "AutomataDecls.h"
 
 namespace Regex {
 
-    Lexer::Lexer() {
+    Lexer::Lexer()
+            : cursor_(0)
+    {
         source_ = "";
-        addAutomata();
     }
 
     Lexer::Lexer(std::string source)
-            : source_(source)
-    {
-        addAutomata();
-    }
+            : source_(std::move(source)),
+              cursor_(0)
+    {}
 
     Token Lexer::nextToken() {
-
-        if (source_.empty()) // if source is empty then return no token
+        syntax::token token = syntax::next_token(source_.data(), source_.size(), cursor_);
+        if (token.tag == syntax::TOKEN_EOF) // if source is consumed then return no token
             return Token(TAG_EOF, "");
 
-        // set
-        for (typename std::vector<match_pair_type>::iterator it = match_list.begin(); it != match_list.end(); it++)
-            it->first.setString(source_);
-
-
-        if (source_.length() == 1) // if there is only one char then advance and return the tag
-        {
-            advance();
-            std::string lexeme = source_; // the biggest lexeme is the source itself
-            source_ = ""; // consume final char
-            return Token( match(), lexeme );
-        } else
-        {
-            Token::Tag tag; // tag to inspect
-            Token token;
-            Token::Tag token_tag = TAG_NONE; // tag of token
-
-            // This do-while cycle iterates until it can't find a matching pattern
-            // When it ends, it has memorized the last matching pattern (different from class NONE) in token
-            // This means we find the next largest lexeme in the source
-            size_t chars_lexed = 0;
-            do
-            {
-                advance(); // advance all automatas
-                chars_lexed++;
-
-                tag = match(); // get matching tag
-
-                if (tag != TAG_NONE)
-                {
-                    std::string lexeme = source_.substr(0, chars_lexed);
-                    token = Token(tag, lexeme);
-                }
-
-            } while (canAdvance() && chars_lexed < source_.length());
-
-            source_ = source_.erase(0, token.length()); // consume input
-
-            return token;
-        }
-    }
-
-    Token::Tag Lexer::match() {
-        for (typename std::vector<match_pair_type>::iterator it = match_list.begin(); it != match_list.end(); it++)
-        {
-            if ( it->first.accepts() ) // if the automata is at an accepting state
-            {
-                return it->second; // return its associated token tag
-            }
-        }
-        return TAG_NONE;
-    }
-
-    void Lexer::advance() {
-        for (typename std::vector<match_pair_type>::iterator it = match_list.begin(); it != match_list.end(); it++)
-            it->first.advance();
-    }
-
-    // edit this function to add more automata
-    void Lexer::addAutomata() {
-        match_list.push_back( std::make_pair( SPACE_NFA, TAG_SPACE ) );
-        match_list.push_back( std::make_pair( KLEENE_NFA, TAG_KLEENE_STAR ) );
-        match_list.push_back( std::make_pair( ALTERNATION_NFA, TAG_ALTER ) );
-        match_list.push_back( std::make_pair( LPAREN_NFA, TAG_LPAREN ) );
-        match_list.push_back( std::make_pair( RPAREN_NFA, TAG_RPAREN ) );
-        match_list.push_back( std::make_pair( QMARK_NFA, TAG_QMARK ) );
-        match_list.push_back( std::make_pair( KLEENE_PLUS_NFA, TAG_PLUS ) );
-        match_list.push_back( std::make_pair( ASCII_NFA, TAG_CHAR ) );
+        return Token(tagOf(token.tag), source_.substr(token.begin, token.end - token.begin));
     }
 
     void Lexer::setSource(std::string source) {
-        source_ = source;
+        source_ = std::move(source);
+        cursor_ = 0;
     }
 
-    bool Lexer::canAdvance() {
-        for (typename std::vector<match_pair_type>::iterator it = match_list.begin(); it != match_list.end(); it++)
-            if (!it->first.getCurrentStates().empty())
-                return true;
-
-        return false;
+    Token::Tag const& Lexer::tagOf(syntax::token_tag tag) {
+        switch (tag)
+        {
+            case syntax::TOKEN_LPAREN: return TAG_LPAREN;
+            case syntax::TOKEN_RPAREN: return TAG_RPAREN;
+            case syntax::TOKEN_KLEENE: return TAG_KLEENE_STAR;
+            case syntax::TOKEN_ALTER: return TAG_ALTER;
+            case syntax::TOKEN_QMARK: return TAG_QMARK;
+            case syntax::TOKEN_PLUS: return TAG_PLUS;
+            case syntax::TOKEN_CHAR: return TAG_CHAR;
+            case syntax::TOKEN_SPACE: return TAG_SPACE;
+            case syntax::TOKEN_ESCAPE_SEQUENCE: return TAG_ESCAPE_SEQUENCE;
+            case syntax::TOKEN_CLASS: return TAG_CLASS;
+            case syntax::TOKEN_DOT: return TAG_DOT;
+            case syntax::TOKEN_REPEAT: return TAG_REPEAT;
+            default: return TAG_NONE;
+        }
     }
 
-}
\ No newline at end of file
+}
@@ -34,13 +34,11 @@
 #ifndef MYREGEX_LEXER_H
 #define MYREGEX_LEXER_H
 
-#include "../Hashtable/Hashtable.h"
 #include "Token.h"
-#include "../Automata/NFA.h"
+#include "Syntax.h"
 
 #include <string>
 #include <vector>
-#include <functional>
 
 namespace Regex {
 
@@ -48,23 +46,32 @@ namespace Regex {
      *  # Description
      *
      * This lexer is meant to obtain tokens from a regular expression string.
-     * The variable symbol set is a hashtable where all the reserved symbols
-     * (like the alternation token "|") are stored.
+     * Most tokens of the grammar are a single character, so the class of a
+     * token only depends on its character. The reserved symbols (like the
+     * alternation token "|") have their own tags, the rest of the printable
+     * characters are plain characters and anything else is tagged as TAG_NONE,
+     * which the parser rejects. The tokens are cut by syntax::next_token(),
+     * which static_regex runs at compile time too.
      *
-     * Strictly speaking, we should also keep an "alphabet" but we just take it
-     * as everything we can type on a keyboard minus the symbol set.
+     * Two tokens are longer: an escape sequence is a backslash and the character
+     * which follows it (two hexadecimal digits more for `\xHH`), and a bracket
+     * expression like `[^a-z]` runs up to the first unescaped `]` which isn't its
+     * first character. Their lexemes are decoded by CharClass. A backslash at the
+     * end of the source and an unterminated bracket expression are tagged as
+     * TAG_NONE. A bounded repetition `{m}`, `{m,}` or `{m,n}` is a single token
+     * too, the parser reads its bounds, and a brace which doesn't start one is a
+     * plain character.
+     *
+     * The lexer keeps a cursor into the source, so the whole source is lexed
+     * in a single pass without copying it.
      */
     class Lexer {
 
-        typedef typename Automata::NFA automata_type;
-        typedef typename std::pair<automata_type, Token::Tag> match_pair_type;
-
         /// String to parse
         std::string source_;
 
-        /// List of automatas with associated tokens
-        std::vector<match_pair_type> match_list;
-
+        /// Position of the next character to lex
+        size_t cursor_;
 
     public:
 
@@ -86,8 +93,8 @@ namespace Regex {
          *
          * # Description
          *
-         * This method will consume the source input and return the next token
-         * determined by the given patterns in the addAutomata() method.
+         * This method will consume the source input and return the next token.
+         * Returns a token tagged TAG_EOF once the source is consumed.
          * @return Next token lexed
          */
         Token nextToken();
@@ -100,45 +107,8 @@ namespace Regex {
 
     private:
 
-        /**
-         * @brief Returns a tag for the matching pattern
-         *
-         * # Description
-         * This method will return a corresponding tag for a lexeme.
-         *
-         * @return Tag for token
-         */
-        Token::Tag match();
-
-        /**
-         * @brief Method to advance automatas
-         *
-         * # Description
-         * This method basically advances all the automatas.
-         * In other words, it makes all the automatas in the list "go forward".
-         */
-        void advance();
-
-        /**
-         * @brief Method which sets all the automata to be used
-         *
-         * # Description
-         * In this method you should add to match_list all the automata that
-         * will be used for detecting patterns. You should also notice that you
-         * have to add a pair associating an automata with its token tag.
-         */
-        void addAutomata();
-
-
-        /**
-         * @brief Returns true if the automatas can advance to their next states
-         *
-         * In other words, it means that if there is no states left to jump to
-         * then we return false.
-         *
-         * @return True if automatas can advance, else returns false
-         */
-        bool canAdvance();
+        /// Returns the tag of the tokens of a kind, see syntax::next_token()
+        static Token::Tag const& tagOf(syntax::token_tag tag);
     };
 }
 
@@ -0,0 +1,123 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file Literals.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Implementation file for the struct Literals
+ *
+ */
+//</editor-fold>
+#include "Literals.h"
+
+namespace Regex {
+
+    namespace {
+        std::string first_bytes(std::string const& s) {
+            return s.size() <= Literals::max_length ? s : s.substr(0, Literals::max_length);
+        }
+
+        std::string last_bytes(std::string const& s) {
+            return s.size() <= Literals::max_length ? s : s.substr(s.size() - Literals::max_length);
+        }
+
+        std::string const& longest(std::string const& a, std::string const& b) {
+            return b.size() > a.size() ? b : a;
+        }
+    }
+
+    const size_t Literals::max_length;
+
+    Literals::Literals()
+            : exact(false)
+    {}
+
+    Literals Literals::symbol(unsigned char c) {
+        Literals result;
+        result.prefix = std::string(1, static_cast<char>(c));
+        result.suffix = result.prefix;
+        result.required = result.prefix;
+        result.exact = true;
+        return result;
+    }
+
+    Literals Literals::concatenate(Literals const &a, Literals const &b) {
+        Literals result;
+        result.exact = a.exact && b.exact && a.prefix.size() + b.prefix.size() <= max_length;
+        result.prefix = a.exact ? first_bytes(a.prefix + b.prefix) : a.prefix;
+        result.suffix = b.exact ? last_bytes(a.suffix + b.suffix) : b.suffix;
+
+        // the end of a match of a is followed by the start of a match of b
+        result.required = longest(longest(a.required, b.required), first_bytes(a.suffix + b.prefix));
+        result.required = longest(result.required, longest(result.prefix, result.suffix));
+        return result;
+    }
+
+    Literals Literals::alternate(Literals const &a, Literals const &b) {
+        Literals result;
+        result.exact = a.exact && b.exact && a.prefix == b.prefix;
+
+        size_t n = 0;
+        while (n < a.prefix.size() && n < b.prefix.size() && a.prefix[n] == b.prefix[n])
+            n++;
+        result.prefix = a.prefix.substr(0, n);
+
+        n = 0;
+        while (n < a.suffix.size() && n < b.suffix.size() &&
+               a.suffix[a.suffix.size() - 1 - n] == b.suffix[b.suffix.size() - 1 - n])
+            n++;
+        result.suffix = a.suffix.substr(a.suffix.size() - n);
+
+        result.required = longest(result.prefix, result.suffix);
+        if (a.required == b.required)
+            result.required = longest(result.required, a.required);
+        return result;
+    }
+
+    Literals Literals::kleene(Literals const &a) {
+        (void) a;
+        return Literals(); // may match nothing
+    }
+
+    Literals Literals::kleene_plus(Literals const &a) {
+        Literals result = a;
+        result.exact = false;
+        return result;
+    }
+
+    Literals Literals::optional(Literals const &a) {
+        (void) a;
+        return Literals(); // may match nothing
+    }
+
+    Literals Literals::repeat(Literals const &a, size_t min, size_t max) {
+        if (min == 0)
+            return Literals(); // may match nothing
+
+        Literals result = a;
+        for (size_t i = 1; i < min; i++)
+            result = concatenate(result, a);
+
+        result.exact = result.exact && max == min;
+        return result;
+    }
+}
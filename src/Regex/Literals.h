@@ -0,0 +1,96 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file Literals.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the struct Literals
+ *
+ * # Description
+ * This file contains the literal strings the parser extracts from a pattern.
+ *
+ */
+//</editor-fold>
+#ifndef MYREGEX_LITERALS_H
+#define MYREGEX_LITERALS_H
+
+#include <string>
+
+namespace Regex {
+
+    /**
+     * @struct Literals
+     * @author Carlos Brito (carlos.brito524@gmail.com)
+     * @date 10/14/26.
+     *
+     * @brief Literal strings which every match of a pattern contains
+     *
+     * # Description
+     * These are computed alongside the automaton while parsing, with one rule per operation of the grammar.
+     * For example every match of `aaa(a|b)+c*` starts with `aaaa` or `aaab`, so `aaa` is its prefix, and it
+     * has no suffix since `c*` may match nothing.
+     *
+     * The strings are at most max_length bytes long. An empty string means there is no such literal.
+     */
+    struct Literals {
+        /// Maximum length of the literal strings
+        static const size_t max_length = 255;
+
+        /// Every match starts with this string
+        std::string prefix;
+
+        /// Every match ends with this string
+        std::string suffix;
+
+        /// Every match contains this string. The longest one found.
+        std::string required;
+
+        /// Whether the pattern matches exactly one string, which is then the prefix
+        bool exact;
+
+        /// Constructs literals for a pattern which may match the empty string
+        Literals();
+
+        /// Literals of a single symbol
+        static Literals symbol(unsigned char c);
+
+        /// Literals of the concatenation of a and b
+        static Literals concatenate(Literals const& a, Literals const& b);
+
+        /// Literals of the alternation of a and b
+        static Literals alternate(Literals const& a, Literals const& b);
+
+        /// Literals of the kleene closure of a
+        static Literals kleene(Literals const& a);
+
+        /// Literals of the positive closure of a
+        static Literals kleene_plus(Literals const& a);
+
+        /// Literals of a zero or one times
+        static Literals optional(Literals const& a);
+
+        /// Literals of from min to max concatenations of a. Every match starts and ends with min of them.
+        static Literals repeat(Literals const& a, size_t min, size_t max);
+    };
+}
+
+#endif //MYREGEX_LITERALS_H
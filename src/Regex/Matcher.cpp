@@ -0,0 +1,449 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file Matcher.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Implementation file for the class Matcher
+ *
+ */
+//</editor-fold>
+#include <algorithm>
+
+#include "Matcher.h"
+
+namespace Regex {
+
+    const size_t Match::npos;
+
+    Matcher::Matcher()
+            : engine_(ENGINE_LAZY_DFA),
+              dfaMemoryBudget_(Automata::LazyDFA::default_memory_budget),
+              denseState_(Automata::DenseDFA::dead_state),
+              searchReady_(false),
+              capturesReady_(false)
+    {}
+
+    Matcher::Matcher(std::shared_ptr<const Automata::Program> program, Engine engine, size_t dfa_memory_budget,
+                     Literals const &literals, std::shared_ptr<const Automata::DenseDFA> dense,
+                     std::shared_ptr<const Automata::Program> search_program,
+                     std::shared_ptr<Automata::SharedLazyDFA> shared)
+            : program_(program),
+              searchProgram_(search_program ? search_program : program),
+              engine_(engine),
+              dfaMemoryBudget_(dfa_memory_budget),
+              dense_(dense),
+              denseState_(Automata::DenseDFA::dead_state),
+              shared_(shared),
+              searchReady_(false),
+              capturesReady_(false),
+              literals_(literals),
+              prefix_(literals.prefix),
+              required_(literals.required)
+    {
+        build();
+    }
+
+    bool Matcher::match(const char *first, const char *last) {
+        if (engine_ == ENGINE_PIKE_VM)
+            return vm_.match(first, last);
+        if (engine_ == ENGINE_BIT_PARALLEL)
+            return bits_.match(first, last);
+        if (engine_ == ENGINE_SHARED_DFA)
+            return scanner_.match(first, last);
+
+        if (dense_)
+        {
+            MYREGEX_STATS(denseStats_.bytes += last - first; denseStats_.active_states += last - first);
+            return dense_->match(first, last);
+        }
+
+        return dfa_.match(first, last);
+    }
+
+    void Matcher::match_many(std::string_view const *strs, size_t count, unsigned char *results) {
+        if (engine_ == ENGINE_SHARED_DFA)
+        {
+            scanner_.match_many(strs, count, results);
+            return;
+        }
+
+        if (engine_ == ENGINE_PIKE_VM || engine_ == ENGINE_BIT_PARALLEL)
+        {
+            for (size_t i = 0; i < count; i++)
+                results[i] = match(strs[i].data(), strs[i].data() + strs[i].size());
+            return;
+        }
+
+        if (dense_)
+        {
+            MYREGEX_STATS(for (size_t i = 0; i < count; i++) {
+                denseStats_.bytes += strs[i].size();
+                denseStats_.active_states += strs[i].size();
+            });
+            dense_->match_many(strs, count, results);
+            return;
+        }
+
+        dfa_.match_many(strs, count, results);
+    }
+
+    void Matcher::reset() {
+        if (engine_ == ENGINE_PIKE_VM)
+            vm_.reset();
+        else if (engine_ == ENGINE_BIT_PARALLEL)
+            bits_.reset();
+        else if (engine_ == ENGINE_SHARED_DFA)
+            scanner_.reset();
+        else if (engine_ == ENGINE_DENSE_DFA)
+            denseState_ = dense_ ? dense_->start() : Automata::DenseDFA::dead_state;
+        else
+            dfa_.reset();
+    }
+
+    bool Matcher::feed(const char *data, size_t size) {
+        if (engine_ == ENGINE_PIKE_VM)
+            return vm_.feed(data, size);
+        if (engine_ == ENGINE_BIT_PARALLEL)
+            return bits_.feed(data, size);
+        if (engine_ == ENGINE_SHARED_DFA)
+            return scanner_.feed(data, size);
+
+        if (engine_ == ENGINE_DENSE_DFA)
+        {
+            if (dense_)
+            {
+                MYREGEX_STATS(denseStats_.bytes += size; denseStats_.active_states += size);
+                denseState_ = dense_->run(denseState_, data, data + size);
+            }
+            return denseState_ != Automata::DenseDFA::dead_state;
+        }
+
+        return dfa_.feed(data, size);
+    }
+
+    bool Matcher::finish() {
+        if (engine_ == ENGINE_PIKE_VM)
+            return vm_.finish();
+        if (engine_ == ENGINE_BIT_PARALLEL)
+            return bits_.finish();
+        if (engine_ == ENGINE_SHARED_DFA)
+            return scanner_.finish();
+
+        if (engine_ == ENGINE_DENSE_DFA)
+        {
+            bool accepted = dense_ && dense_->isEnd(denseState_);
+            reset();
+            return accepted;
+        }
+
+        return dfa_.finish();
+    }
+
+    bool Matcher::search(const char *first, const char *last, Match &match) {
+        if (!program_)
+            return false;
+
+        if (literals_.exact) // the leftmost occurrence of the literal is the match
+        {
+            const char* found = prefix_.find(first, last);
+            if (!found)
+                return false;
+
+            match.begin = static_cast<size_t>(found - first);
+            match.end = match.begin + prefix_.literal().size();
+            return true;
+        }
+
+        if (required_.literal().size() > prefix_.literal().size() && !required_.find(first, last))
+            return false;
+
+        // no match starts before the first occurrence of the prefix
+        const char* start = first;
+        if (!prefix_.empty())
+        {
+            start = prefix_.find(first, last);
+            if (!start)
+                return false;
+        }
+
+        buildSearch();
+
+        const char* end;
+        if (!forward_.search(start, last, end, prefix_.empty() ? nullptr : &prefix_))
+            return false;
+
+        // a match ends there, so the reverse scan always finds a start
+        const char* begin = end;
+        reverse_.longest_reverse(start, end, begin);
+
+        match.begin = static_cast<size_t>(begin - first);
+        match.end = static_cast<size_t>(end - first);
+        return true;
+    }
+
+    bool Matcher::match(const char *first, const char *last, std::vector<Match> &groups) {
+        groups.clear();
+        if (!program_)
+            return false;
+
+        buildCaptures();
+        if (!onePass_.isOnePass() && !match(first, last))
+            return false;
+
+        return captures(first, last, 0, groups);
+    }
+
+    bool Matcher::search(const char *first, const char *last, std::vector<Match> &groups) {
+        groups.clear();
+
+        Match m;
+        if (!search(first, last, m))
+            return false;
+
+        buildCaptures();
+        return captures(first + m.begin, first + m.end, m.begin, groups);
+    }
+
+    size_t Matcher::group_count() const {
+        if (!program_)
+            return 0;
+        return std::max<size_t>(searchProgram_->group_count(), 1);
+    }
+
+    bool Matcher::captures(const char *first, const char *last, size_t offset, std::vector<Match> &groups) {
+        bool matched = onePass_.isOnePass() ? onePass_.match(first, last, slots_.data())
+                                            : tagged_.match(first, last, slots_.data());
+        if (!matched)
+            return false;
+
+        Match none = {Match::npos, Match::npos};
+        groups.assign(group_count(), none);
+        groups[0].begin = offset;
+        groups[0].end = offset + static_cast<size_t>(last - first);
+
+        // group 0 is the whole match, the other groups are read from their slots, if they have any
+        for (size_t g = 1; g < groups.size() && 2 * g < slots_.size(); g++)
+        {
+            size_t begin = slots_[2 * g];
+            size_t end = slots_[2 * g + 1];
+            if (begin != Automata::Program::no_position && end != Automata::Program::no_position)
+            {
+                groups[g].begin = offset + begin;
+                groups[g].end = offset + end;
+            }
+        }
+        return true;
+    }
+
+    void Matcher::find_all(const char *first, const char *last, std::vector<Match> &matches) {
+        matches.clear();
+
+        size_t size = static_cast<size_t>(last - first);
+        size_t pos = 0;
+        while (pos <= size)
+        {
+            Match m;
+            if (!search(first + pos, last, m))
+                break;
+
+            m.begin += pos;
+            m.end += pos;
+
+            if (m.begin == m.end && !matches.empty() && matches.back().end == m.begin)
+            {
+                pos = m.begin + 1; // empty match right after the previous one
+                continue;
+            }
+
+            matches.push_back(m);
+            pos = m.begin == m.end ? m.end + 1 : m.end;
+        }
+    }
+
+    void Matcher::setEngine(Engine engine) {
+        engine_ = engine;
+        build();
+    }
+
+    Engine Matcher::engine() const {
+        return engine_;
+    }
+
+    Engine Matcher::select_engine(Automata::Program const &program, size_t dfa_memory_budget) {
+        if (program.isDeterministic())
+            return ENGINE_LAZY_DFA;
+
+        // a row of the transition table for each subset of the states
+        size_t row_size = Automata::LazyDFA::alphabet_size * sizeof(Automata::LazyDFA::state_id);
+        if (program.state_count() < 32 && (size_t(1) << program.state_count()) <= dfa_memory_budget / row_size)
+            return ENGINE_LAZY_DFA;
+
+        if (Automata::BitParallelNFA::position_count(program) > Automata::BitParallelNFA::max_positions)
+            return ENGINE_LAZY_DFA;
+
+        return ENGINE_BIT_PARALLEL;
+    }
+
+    size_t Matcher::dfa_memory_budget() const {
+        return dfaMemoryBudget_;
+    }
+
+    Literals const& Matcher::literals() const {
+        return literals_;
+    }
+
+    Automata::Prefilter const& Matcher::required() const {
+        return required_;
+    }
+
+    std::shared_ptr<Automata::SharedLazyDFA> const& Matcher::shared() const {
+        return shared_;
+    }
+
+    Stats Matcher::stats() const {
+        Stats result;
+        result.counters_enabled = Automata::MatchStats::enabled;
+        if (!program_)
+            return result;
+
+        result.nfa_states = program_->state_count();
+        result.nfa_transitions = program_->edge_count();
+        result.nfa_epsilon_transitions = program_->epsilon_count();
+
+        Automata::LazyDFA const* lazy[] = {&dfa_, &forward_, &reverse_};
+        Automata::MatchStats counters = denseStats_;
+        for (size_t i = 0; i < sizeof(lazy) / sizeof(lazy[0]); i++)
+        {
+            result.dfa_states += lazy[i]->state_count();
+            result.dfa_memory += lazy[i]->memory_used();
+            result.dfa_flushes += lazy[i]->flush_count();
+            result.dfa_fallbacks += lazy[i]->fallback_count();
+            counters += lazy[i]->stats();
+        }
+        counters += vm_.stats();
+        counters += bits_.stats();
+        counters += scanner_.stats();
+        result.dfa_memory += bits_.memory_size();
+
+        if (dense_)
+        {
+            result.dfa_states += dense_->state_count();
+            result.dfa_memory += dense_->memory_size();
+        }
+
+        if (shared_)
+        {
+            result.dfa_states += shared_->state_count();
+            result.dfa_memory += shared_->memory_used();
+            result.dfa_flushes += shared_->flush_count();
+            result.dfa_fallbacks += shared_->fallback_count();
+        }
+
+        result.cache_hits = counters.cache_hits;
+        result.cache_misses = counters.cache_misses;
+        result.bytes_scanned = counters.bytes;
+        result.active_states = counters.active_states;
+        return result;
+    }
+
+    void Matcher::resetStats() {
+        denseStats_ = Automata::MatchStats();
+        dfa_.resetStats();
+        forward_.resetStats();
+        reverse_.resetStats();
+        vm_.resetStats();
+        bits_.resetStats();
+        scanner_.resetStats();
+    }
+
+    void Matcher::buildSearch() {
+        if (searchReady_)
+            return;
+
+        std::shared_ptr<const Automata::Program> reversed = std::make_shared<const Automata::Program>(
+                program_->reversed());
+
+        forward_ = Automata::LazyDFA(searchProgram_, dfaMemoryBudget_, Automata::LazyDFA::MODE_UNANCHORED);
+        reverse_ = Automata::LazyDFA(reversed, dfaMemoryBudget_);
+        searchReady_ = true;
+    }
+
+    void Matcher::buildCaptures() {
+        if (capturesReady_)
+            return;
+
+        onePass_ = Automata::OnePassDFA(*searchProgram_);
+        if (!onePass_.isOnePass())
+            tagged_ = Automata::TaggedPikeVM(searchProgram_);
+        slots_.assign(searchProgram_->slot_count(), Automata::Program::no_position);
+        capturesReady_ = true;
+    }
+
+    void Matcher::build() {
+        if (!program_)
+            return;
+
+        if (engine_ == ENGINE_AUTO)
+            engine_ = select_engine(*program_, dfaMemoryBudget_);
+
+        // only the selected engine holds memory
+        if (engine_ != ENGINE_SHARED_DFA)
+        {
+            scanner_ = Automata::SharedLazyDFA::Scanner();
+            shared_.reset();
+        }
+
+        if (engine_ == ENGINE_PIKE_VM)
+        {
+            vm_ = Automata::PikeVM(program_);
+            dfa_ = Automata::LazyDFA();
+            bits_ = Automata::BitParallelNFA();
+        } else if (engine_ == ENGINE_DENSE_DFA)
+        {
+            if (!dense_)
+                dense_ = std::make_shared<const Automata::DenseDFA>(*program_);
+            dfa_ = Automata::LazyDFA();
+            vm_ = Automata::PikeVM();
+            bits_ = Automata::BitParallelNFA();
+            reset();
+        } else if (engine_ == ENGINE_BIT_PARALLEL)
+        {
+            bits_ = Automata::BitParallelNFA(*program_);
+            dfa_ = Automata::LazyDFA();
+            vm_ = Automata::PikeVM();
+        } else if (engine_ == ENGINE_SHARED_DFA)
+        {
+            if (!shared_)
+                shared_ = std::make_shared<Automata::SharedLazyDFA>(program_, dfaMemoryBudget_);
+            scanner_ = Automata::SharedLazyDFA::Scanner(shared_);
+            dfa_ = Automata::LazyDFA();
+            vm_ = Automata::PikeVM();
+            bits_ = Automata::BitParallelNFA();
+        } else
+        {
+            dfa_ = Automata::LazyDFA(program_, dfaMemoryBudget_);
+            vm_ = Automata::PikeVM();
+            bits_ = Automata::BitParallelNFA();
+        }
+    }
+}
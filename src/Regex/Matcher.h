@@ -0,0 +1,361 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file Matcher.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the class Matcher
+ *
+ * # Description
+ * This file contains the class which holds the mutable state needed to match strings against a compiled
+ * pattern.
+ *
+ */
+//</editor-fold>
+#ifndef MYREGEX_MATCHER_H
+#define MYREGEX_MATCHER_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../Automata/Program.h"
+#include "../Automata/LazyDFA.h"
+#include "../Automata/SharedLazyDFA.h"
+#include "../Automata/PikeVM.h"
+#include "../Automata/Prefilter.h"
+#include "../Automata/DenseDFA.h"
+#include "../Automata/BitParallelNFA.h"
+#include "../Automata/OnePassDFA.h"
+#include "../Automata/TaggedPikeVM.h"
+#include "Literals.h"
+#include "Stats.h"
+
+namespace Regex {
+
+    /// Matching engines
+    enum Engine {
+        ENGINE_LAZY_DFA,
+        ENGINE_PIKE_VM,
+
+        /// Minimal DFA built up front, see Automata::DenseDFA
+        ENGINE_DENSE_DFA,
+
+        /// Bit-parallel simulation of the Glushkov automaton, for small patterns. See Automata::BitParallelNFA.
+        ENGINE_BIT_PARALLEL,
+
+        /// Lazy DFA whose state cache is shared with other matchers, see Automata::SharedLazyDFA
+        ENGINE_SHARED_DFA,
+
+        /// One of the above chosen for the pattern, see Matcher::select_engine()
+        ENGINE_AUTO
+    };
+
+    /// A match of a pattern in a string, as the byte offsets \f$ [begin, end) \f$
+    struct Match {
+        /// Offsets of a capture group which took no part in the match
+        static const size_t npos = static_cast<size_t>(-1);
+
+        size_t begin;
+        size_t end;
+    };
+
+    /**
+     * @class Matcher
+     * @author Carlos Brito (carlos.brito524@gmail.com)
+     * @date 10/14/26.
+     *
+     * @brief Per-thread matching state for a compiled pattern
+     *
+     * # Description
+     * A compiled pattern (Automata::Program) is never modified while matching, everything that is (the
+     * state cache of the DFA, the sets of states of the simulation) lives in a Matcher instead. So any
+     * number of matchers may share the same program, and matchers used from different threads don't
+     * need any synchronization. A single matcher must not be used from two threads at the same time.
+     *
+     * # Searching
+     * search() finds the leftmost match of the pattern in a string, and among the matches which start
+     * there the one a backtracking matcher would find first: the left side of an alternation is preferred
+     * and repetitions are greedy. It runs in two passes, whatever the engine:
+     *
+     * - An unanchored DFA scans forward from the start of the string and stops shortly after the end of
+     * the match, see Automata::LazyDFA::search().
+     * - A DFA of the reversed pattern scans backward from the end of the match and finds the leftmost
+     * position where a match ending there starts. No match starts before the leftmost one, so it is the
+     * start of the match.
+     *
+     * Both passes are linear in the length of the string. Their automata are only built the first time
+     * search() is called. The forward pass needs the epsilon transitions of the program in order of
+     * preference, which Automata::Program::simplified() doesn't keep, so it runs the program as parsed when
+     * it is given apart.
+     *
+     * When the Literals of the pattern are given, search() first looks for them with an Automata::Prefilter:
+     * a string which lacks the required literal is rejected without running any automaton, the forward
+     * pass skips ahead to the occurrences of the prefix, and a pattern which is a single literal string is
+     * searched with the prefilter alone.
+     *
+     * # Capture groups
+     * The overloads of match() and search() which take a vector of groups also tell where each group of
+     * the pattern matched, in linear time. The groups are those a backtracking matcher would report, and
+     * a group inside a repetition holds its last occurrence. The search program saves the positions of
+     * the groups (see Automata::ProgramBuilder::capture()) and is run over the match only:
+     *
+     * - If it is one-pass, by an Automata::OnePassDFA, which costs a single lookup per byte.
+     * - Otherwise, by an Automata::TaggedPikeVM. match() first runs the selected engine, which rejects a
+     * string much faster than the simulation does.
+     *
+     * Both are built the first time groups are asked for.
+     */
+    class Matcher {
+    public:
+        /// Constructs a matcher which matches nothing
+        Matcher();
+
+        /**
+         * @brief Constructs a matcher for a compiled pattern
+         * @param program Compiled pattern
+         * @param engine Engine used for matching
+         * @param dfa_memory_budget Memory budget of the DFA state cache
+         * @param literals Literals of the pattern, see Parser::getLiterals()
+         * @param dense Fully built DFA of the pattern, if any. match() then uses it instead of the lazy DFA.
+         * With ENGINE_DENSE_DFA it is built here if not given.
+         * @param search_program The same automaton as program with its epsilon transitions in order of
+         * preference, for the forward pass of search(). If not given, program is used.
+         * @param shared State cache for ENGINE_SHARED_DFA, shared with other matchers. It is made here if not
+         * given, copies of the matcher then share it.
+         * @throws Automata::TooManyStatesError if the DFA is too large for ENGINE_DENSE_DFA, or the pattern
+         * has too many positions for ENGINE_BIT_PARALLEL
+         */
+        Matcher(std::shared_ptr<const Automata::Program> program,
+                Engine engine = ENGINE_LAZY_DFA,
+                size_t dfa_memory_budget = Automata::LazyDFA::default_memory_budget,
+                Literals const& literals = Literals(),
+                std::shared_ptr<const Automata::DenseDFA> dense = std::shared_ptr<const Automata::DenseDFA>(),
+                std::shared_ptr<const Automata::Program> search_program = std::shared_ptr<const Automata::Program>(),
+                std::shared_ptr<Automata::SharedLazyDFA> shared = std::shared_ptr<Automata::SharedLazyDFA>());
+
+        /**
+         * @brief Returns true if the bytes in \f$ [first, last) \f$ match the pattern
+         * @param first Pointer to the first byte
+         * @param last Pointer past the last byte
+         * @return true if string matches pattern, false otherwise
+         */
+        bool match(const char* first, const char* last);
+
+        /**
+         * @brief Matches many strings against the pattern
+         *
+         * Gives the same results as calling match() on each string. The DFA engines run several strings in
+         * lockstep, see Automata::LazyDFA::match_many(), which is faster when the strings are many and short.
+         *
+         * @param strs Strings to match
+         * @param count Number of strings
+         * @param results Set to 1 for each string which matches and 0 for the others, in order
+         */
+        void match_many(std::string_view const* strs, size_t count, unsigned char* results);
+
+        /**
+         * @brief Returns true if the bytes in \f$ [first, last) \f$ match the pattern, and where its groups matched
+         * @param first Pointer to the first byte
+         * @param last Pointer past the last byte
+         * @param groups On a match, set to the offsets from first of the `group_count()` groups of the
+         * pattern, group 0 being the whole string. A group which took no part in the match is at Match::npos.
+         * Cleared otherwise.
+         * @return true if string matches pattern, false otherwise
+         */
+        bool match(const char* first, const char* last, std::vector<Match> &groups);
+
+        /// Starts a new stream, discarding the current one
+        void reset();
+
+        /**
+         * @brief Matches the next chunk of a stream
+         *
+         * The stream is matched as if all of its chunks were concatenated and given to match(), but only the
+         * state of the engine is carried from one chunk to the next, so the memory used is constant whatever
+         * the length of the stream. Neither the chunk nor the previous ones are copied.
+         *
+         * @param data Pointer to the first byte of the chunk
+         * @param size Number of bytes of the chunk
+         * @return false if no continuation of the stream can match anymore
+         */
+        bool feed(const char* data, size_t size);
+
+        /// Returns true if the stream fed so far matches the pattern, and starts a new stream
+        bool finish();
+
+        /**
+         * @brief Finds the leftmost match of the pattern in \f$ [first, last) \f$
+         * @param first Pointer to the first byte
+         * @param last Pointer past the last byte
+         * @param match Set to the offsets of the match from first, if any
+         * @return true if there is a match, false otherwise
+         */
+        bool search(const char* first, const char* last, Match &match);
+
+        /**
+         * @brief Finds every match of the pattern in \f$ [first, last) \f$, from left to right
+         *
+         * Each search starts where the previous match ends, so the matches don't overlap. After an empty
+         * match the next search starts one byte further, and an empty match right where the previous
+         * match ends is skipped.
+         *
+         * @param first Pointer to the first byte
+         * @param last Pointer past the last byte
+         * @param matches Set to the offsets of the matches from first, in increasing order
+         */
+        void find_all(const char* first, const char* last, std::vector<Match> &matches);
+
+        /**
+         * @brief Finds the leftmost match of the pattern in \f$ [first, last) \f$, and where its groups matched
+         * @param first Pointer to the first byte
+         * @param last Pointer past the last byte
+         * @param groups If there is a match, set to the offsets from first of the `group_count()` groups of
+         * the pattern, group 0 being the match found by search(). A group which took no part in the match is
+         * at Match::npos. Cleared otherwise.
+         * @return true if there is a match, false otherwise
+         */
+        bool search(const char* first, const char* last, std::vector<Match> &groups);
+
+        /// Returns the number of capture groups of the pattern, group 0 (the whole match) included
+        size_t group_count() const;
+
+        /// Sets the matching engine. Discards the current stream.
+        /**
+         * @throws Automata::TooManyStatesError if the DFA is too large for ENGINE_DENSE_DFA, or the pattern
+         * has too many positions for ENGINE_BIT_PARALLEL
+         */
+        void setEngine(Engine engine);
+
+        /// Returns the matching engine. ENGINE_AUTO is resolved once the matcher has a pattern.
+        Engine engine() const;
+
+        /**
+         * @brief Returns the engine ENGINE_AUTO stands for with a program
+         *
+         * The lazy DFA is the fastest engine once its cache is warm, and a deterministic program or one
+         * with so few states that every subset of them fits in the cache keeps it warm. Otherwise the DFA
+         * may have exponentially many states, as with patterns like `.*a.{20}`, while the cost of
+         * ENGINE_BIT_PARALLEL doesn't depend on them. So it is chosen if the program has few enough
+         * positions, and ENGINE_LAZY_DFA otherwise.
+         *
+         * @param program Compiled pattern
+         * @param dfa_memory_budget Memory budget of the DFA state cache
+         */
+        static Engine select_engine(Automata::Program const& program,
+                                    size_t dfa_memory_budget = Automata::LazyDFA::default_memory_budget);
+
+        /// Returns the memory budget of the DFA state cache
+        size_t dfa_memory_budget() const;
+
+        /// Returns the literals of the pattern
+        Literals const& literals() const;
+
+        /// Returns the prefilter for the literal every match contains. It is empty if there is none.
+        Automata::Prefilter const& required() const;
+
+        /// Returns the state cache of ENGINE_SHARED_DFA, null with another engine
+        std::shared_ptr<Automata::SharedLazyDFA> const& shared() const;
+
+        /// Returns the statistics of the automata of this matcher, see Stats. The compile time is left at 0.
+        Stats stats() const;
+
+        /// Sets the counters of the hot path back to zero
+        void resetStats();
+
+    private:
+        /// Builds the selected engine
+        void build();
+
+        /// Builds the automata used by search(), if not built yet
+        void buildSearch();
+
+        /// Builds the automaton which finds the groups, if not built yet
+        void buildCaptures();
+
+        /**
+         * @brief Finds the groups of a match of the whole of \f$ [first, last) \f$
+         * @param offset Offset of first, added to the offsets of the groups
+         * @return false if there is no such match
+         */
+        bool captures(const char* first, const char* last, size_t offset, std::vector<Match> &groups);
+
+        std::shared_ptr<const Automata::Program> program_;
+
+        /// Program of the forward pass of search(), in order of preference
+        std::shared_ptr<const Automata::Program> searchProgram_;
+
+        Engine engine_;
+        size_t dfaMemoryBudget_;
+        Automata::LazyDFA dfa_;
+        Automata::PikeVM vm_;
+        Automata::BitParallelNFA bits_;
+
+        /// Fully built DFA, shared read only
+        std::shared_ptr<const Automata::DenseDFA> dense_;
+
+        /// State of the stream of ENGINE_DENSE_DFA
+        Automata::DenseDFA::state_id denseState_;
+
+        /// State cache of ENGINE_SHARED_DFA, shared with other matchers
+        std::shared_ptr<Automata::SharedLazyDFA> shared_;
+
+        /// What this matcher needs to use shared_
+        Automata::SharedLazyDFA::Scanner scanner_;
+
+        /// Counters of the dense DFA, which is shared and can't keep them. Its single state is counted as active.
+        Automata::MatchStats denseStats_;
+
+        /// Finds the end of a match
+        Automata::LazyDFA forward_;
+
+        /// Finds the start of a match
+        Automata::LazyDFA reverse_;
+
+        /// Whether forward_ and reverse_ have been built
+        bool searchReady_;
+
+        /// Finds the groups if the search program is one-pass
+        Automata::OnePassDFA onePass_;
+
+        /// Finds the groups otherwise
+        Automata::TaggedPikeVM tagged_;
+
+        /// Capture slots of the last match
+        std::vector<size_t> slots_;
+
+        /// Whether onePass_ or tagged_ has been built
+        bool capturesReady_;
+
+        /// Literals of the pattern
+        Literals literals_;
+
+        /// Prefilter for the literal every match starts with
+        Automata::Prefilter prefix_;
+
+        /// Prefilter for the literal every match contains
+        Automata::Prefilter required_;
+    };
+}
+
+#endif //MYREGEX_MATCHER_H
@@ -30,26 +30,49 @@
  * - Add the prediction table to the doc
  */
 //</editor-fold>
+#include <utility>
+
 #include <iostream>
 #include "Parser.h"
+#include "CharClass.h"
 #include "TokenDecls.h"
 #include "RegexErrors.h"
+#include "../Automata/AutomataErrors.h"
 
 
 namespace Regex {
-    Parser::Parser() {
-    }
+
+    static_assert(syntax::unbounded == Automata::ProgramBuilder::unbounded,
+                  "syntax::repetition() must give the count of the builder to repetitions without a maximum");
+
+    const size_t Parser::max_repeat;
+    const size_t Parser::default_max_states;
+
+    Parser::Parser(size_t max_states)
+            : builder_(max_states),
+              groupCount_(1)
+    {}
 
     Parser::~Parser() {
 
     }
 
     bool Parser::parse(std::string regex) {
-        lexer_.setSource(regex);
+        builder_.clear();
+        fragmentStack_ = fragment_stack();
+        literalStack_ = literal_stack();
+        tokenList_.clear();
+        groupCount_ = 1;
+        lookahead_ = Token(TAG_NONE, "");
+
+        lexer_.setSource(std::move(regex));
         consume();
 
         E();
 
+        if (lookahead_.tag() != TAG_EOF) // unbalanced right parentheses
+            throw ParserError();
+
         return true;
     }
 
@@ -67,7 +90,7 @@ namespace Regex {
 
     void Parser::E() {
         if (lookahead_.tag() == TAG_LPAREN ||
-            lookahead_.tag() == TAG_CHAR)
+            atSymbol())
         {
             T();
             E_p();
@@ -83,15 +106,21 @@ namespace Regex {
             E();
 
             // ***** Handle alternation ******** //
-            Automata::NFA nfa_1 = automataStack_.top();
-            automataStack_.pop();
+            Automata::ProgramBuilder::Fragment right = fragmentStack_.top();
+            fragmentStack_.pop();
+
+            Automata::ProgramBuilder::Fragment left = fragmentStack_.top();
+            fragmentStack_.pop();
 
-            Automata::NFA nfa_2 = automataStack_.top();
-            automataStack_.pop();
+            fragmentStack_.push(builder_.alternate(left, right));
 
-            Automata::NFA alt = nfa_1.alternate(nfa_2);
+            Literals right_literals = literalStack_.top();
+            literalStack_.pop();
 
-            automataStack_.push(alt);
+            Literals left_literals = literalStack_.top();
+            literalStack_.pop();
+
+            literalStack_.push(Literals::alternate(left_literals, right_literals));
             // ********************************* //
 
         }
@@ -105,7 +134,7 @@ namespace Regex {
 
     void Parser::T() {
         if (lookahead_.tag() == TAG_LPAREN ||
-            lookahead_.tag() == TAG_CHAR)
+            atSymbol())
         {
             F();
             T_p();
@@ -115,20 +144,26 @@ namespace Regex {
 
     void Parser::T_p() {
         if (lookahead_.tag() == TAG_LPAREN ||
-            lookahead_.tag() == TAG_CHAR)
+            atSymbol())
         {
             T();
 
             // ***** Handle concatenation ******** //
-            Automata::NFA nfa_1 = automataStack_.top();
-            automataStack_.pop();
+            Automata::ProgramBuilder::Fragment right = fragmentStack_.top();
+            fragmentStack_.pop();
+
+            Automata::ProgramBuilder::Fragment left = fragmentStack_.top();
+            fragmentStack_.pop();
 
-            Automata::NFA nfa_2 = automataStack_.top();
-            automataStack_.pop();
+            fragmentStack_.push(builder_.concatenate(left, right));
 
-            Automata::NFA concat = nfa_2.concatenate(nfa_1);
+            Literals right_literals = literalStack_.top();
+            literalStack_.pop();
 
-            automataStack_.push(concat);
+            Literals left_literals = literalStack_.top();
+            literalStack_.pop();
+
+            literalStack_.push(Literals::concatenate(left_literals, right_literals));
             // ********************************* //
         }
         else if(lookahead_.tag() == TAG_ALTER ||
@@ -141,7 +176,7 @@ namespace Regex {
     }
 
     void Parser::F() {
-        if (lookahead_.tag() == TAG_LPAREN || lookahead_.tag() == TAG_CHAR)
+        if (lookahead_.tag() == TAG_LPAREN || atSymbol())
         {
             P();
             F_p();
@@ -153,12 +188,14 @@ namespace Regex {
         if (lookahead_.tag() == TAG_KLEENE_STAR)
         {
             // ***** Handle kleene ******** //
-            Automata::NFA nfa = automataStack_.top();
-            automataStack_.pop();
+            Automata::ProgramBuilder::Fragment fragment = fragmentStack_.top();
+            fragmentStack_.pop();
 
-            Automata::NFA kleene = nfa.kleene();
+            fragmentStack_.push(builder_.kleene(fragment));
 
-            automataStack_.push(kleene);
+            Literals literals = literalStack_.top();
+            literalStack_.pop();
+            literalStack_.push(Literals::kleene(literals));
             // ********************************* //
 
             consume();
@@ -166,31 +203,58 @@ namespace Regex {
         else if (lookahead_.tag() == TAG_QMARK)
         {
             // ***** Handle optional ******** //
-//            std::cout << "HANDLE OPT" << std::endl;
-            Automata::NFA nfa = automataStack_.top();
-            automataStack_.pop();
+            Automata::ProgramBuilder::Fragment fragment = fragmentStack_.top();
+            fragmentStack_.pop();
 
-            Automata::NFA optional = nfa.optional();
+            fragmentStack_.push(builder_.optional(fragment));
 
-            automataStack_.push(optional);
+            Literals literals = literalStack_.top();
+            literalStack_.pop();
+            literalStack_.push(Literals::optional(literals));
             // ********************************* //
             consume();
         }
         else if (lookahead_.tag() == TAG_PLUS)
         {
             // ***** Handle kleene plus ******** //
-            Automata::NFA nfa = automataStack_.top();
-            automataStack_.pop();
+            Automata::ProgramBuilder::Fragment fragment = fragmentStack_.top();
+            fragmentStack_.pop();
 
-            Automata::NFA kleene_plus = nfa.kleene_plus();
+            fragmentStack_.push(builder_.kleene_plus(fragment));
 
-            automataStack_.push(kleene_plus);
+            Literals literals = literalStack_.top();
+            literalStack_.pop();
+            literalStack_.push(Literals::kleene_plus(literals));
+            // ********************************* //
+
+            consume();
+        }
+        else if (lookahead_.tag() == TAG_REPEAT)
+        {
+            // ***** Handle bounded repetition ******** //
+            size_t min, max;
+            repetition(lookahead_.lexeme(), min, max);
+
+            Automata::ProgramBuilder::Fragment fragment = fragmentStack_.top();
+            fragmentStack_.pop();
+
+            try
+            {
+                fragmentStack_.push(builder_.repeat(fragment, min, max));
+            } catch (Automata::TooManyStatesError const&)
+            {
+                throw ParserError(); // nested repetitions which would make too large an automaton
+            }
+
+            Literals literals = literalStack_.top();
+            literalStack_.pop();
+            literalStack_.push(Literals::repeat(literals, min, max));
             // ********************************* //
 
             consume();
         }
         else if (lookahead_.tag() == TAG_LPAREN ||
-                lookahead_.tag() == TAG_CHAR ||
+                atSymbol() ||
                 lookahead_.tag() == TAG_ALTER ||
                 lookahead_.tag() == TAG_EOF ||
                 lookahead_.tag() == TAG_RPAREN)
@@ -203,32 +267,62 @@ namespace Regex {
     void Parser::P() {
         if (lookahead_.tag() == TAG_LPAREN)
         {
+            size_t group = groupCount_++;
             consume(); // consume l paren
             E();
-            consume(); // consume r paren
-        } else if (lookahead_.tag() == TAG_CHAR)
-        {
-            // Create NFA and push to stack
-            Automata::NFA nfa("0");
-            nfa.addState("1", true);
-
-            char symbol = lookahead_.lexeme()[0]; // we access the only element
 
-            nfa.addTransition("0", "1", symbol);
+            if (lookahead_.tag() != TAG_RPAREN)
+                throw ParserError();
+            consume(); // consume r paren
 
-            automataStack_.push(nfa);
+            Automata::ProgramBuilder::Fragment fragment = fragmentStack_.top();
+            fragmentStack_.pop();
+            fragmentStack_.push(builder_.capture(fragment, group));
+        } else if (atSymbol())
+        {
+            // Create fragment and push to stack
+            CharClass symbols = CharClass::of(lookahead_);
+
+            if (symbols.count() == 1)
+            {
+                fragmentStack_.push(builder_.symbol(symbols.front()));
+                literalStack_.push(Literals::symbol(symbols.front()));
+            } else
+            {
+                fragmentStack_.push(builder_.ranges(symbols.ranges()));
+                literalStack_.push(Literals()); // no literal string is part of every match
+            }
 
             consume();
         }
         else throw ParserError();
     }
 
+    bool Parser::atSymbol() const {
+        return lookahead_.tag() == TAG_CHAR ||
+               lookahead_.tag() == TAG_ESCAPE_SEQUENCE ||
+               lookahead_.tag() == TAG_CLASS ||
+               lookahead_.tag() == TAG_DOT;
+    }
+
+    void Parser::repetition(std::string const &lexeme, size_t &min, size_t &max) {
+        syntax::repetition(lexeme.c_str(), min, max);
+    }
+
     std::vector<Token> Parser::tokenList() {
         return tokenList_;
     }
 
-    Automata::NFA Parser::getBuiltNFA() {
-        return automataStack_.top();
+    Automata::Program Parser::getProgram() {
+        return builder_.compile(builder_.capture(fragmentStack_.top(), 0), groupCount_);
+    }
+
+    Literals Parser::getLiterals() const {
+        return literalStack_.top();
+    }
+
+    size_t Parser::groupCount() const {
+        return groupCount_;
     }
 }
 
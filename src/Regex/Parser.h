@@ -43,6 +43,8 @@
 #include <stack>
 #include <queue>
 #include "Lexer.h"
+#include "Literals.h"
+#include "../Automata/ProgramBuilder.h"
 
 namespace Regex {
 
@@ -56,7 +58,10 @@ namespace Regex {
      * # Description
      *
      * This class parses the regex specification string in order to check for syntactic correctness and also
-     * builds an equivalent automata while it descends down the parse tree.
+     * builds an equivalent automata while it descends down the parse tree. The automata is built with an
+     * Automata::ProgramBuilder: every rule pushes or combines fragments on a stack, which are small structures
+     * referencing the states of a single pool, so the automata is never copied. A second stack, kept in step
+     * with the first one, holds the Literals of each fragment.
      *
      * # Grammar
      *
@@ -76,10 +81,18 @@ namespace Regex {
      *  factor   = primary '*'
      *           | primary '+'
      *           | primary '?'
+     *           | primary '{' count '}'
+     *           | primary '{' count ',' '}'
+     *           | primary '{' count ',' count '}'
      *           | primary
      *
      *  primary  = '(' exp ')'
-     *           | char
+     *           | symbol
+     *
+     *  symbol   = char
+     *           | escape
+     *           | class
+     *           | '.'
      *
      * ````
      * ## Left factored grammar
@@ -103,10 +116,11 @@ namespace Regex {
      * F' = '*'         { kleene }
      *      | '+'       { positive kleene }
      *      | '?'       { optional }
+     *      | '{m,n}'   { bounded repetition }
      *      | epsilon   { nothing }
      *
      * P = '(' E ')'
-     *      | char
+     *      | symbol
      *
      * ````
      *
@@ -116,15 +130,26 @@ namespace Regex {
      *
      * Anyone reading this (ha! i wish) will find that the methods in the cpp file make use of this table.
      *
+     * Escape sequences and bracket expressions are single tokens, see Lexer. Every symbol is decoded into a
+     * CharClass and becomes one state of the automaton, with a transition per range of bytes. A bounded
+     * repetition is a single token as well, and its counts are at most max_repeat. See
+     * Automata::ProgramBuilder::repeat() for how it is compiled. Nested repetitions multiply, so a pattern whose
+     * repetitions make more states than given to the constructor is rejected.
+     *
+     * # Groups
+     * Every parenthesized expression is a capture group, numbered from 1 in the order of its left
+     * parenthesis, and group 0 is the whole pattern. Each group is compiled with
+     * Automata::ProgramBuilder::capture(), so the program saves where the groups start and end.
+     *
      * # TODO
-     * - Add escape sequence parsing
-     * - Add class parsing
+     * Nothing for the moment.
      *
      */
     class Parser {
 
         typedef typename std::vector<Token> token_list;
-        typedef typename std::stack <Automata::NFA > automata_stack;
+        typedef typename std::stack <Automata::ProgramBuilder::Fragment > fragment_stack;
+        typedef typename std::stack <Literals> literal_stack;
 
         /// Lexer to get the tokens
         Lexer lexer_;
@@ -132,20 +157,34 @@ namespace Regex {
         /// Lookahead token
         Token lookahead_;
 
-        /// Automata which will be built
-        Automata::NFA nfa_;
+        /// Builder which holds the states of the automata
+        Automata::ProgramBuilder builder_;
 
         /// List of tokens parsed
         token_list tokenList_;
 
-        /// Stack of automatas which aids in applying the operations
-        automata_stack automataStack_;
+        /// Stack of fragments which aids in applying the operations
+        fragment_stack fragmentStack_;
+
+        /// Literals of each fragment of fragmentStack_
+        literal_stack literalStack_;
+
+        /// Number of groups parsed, group 0 included
+        size_t groupCount_;
 
     public:
+        /// Largest count of a bounded repetition
+        static const size_t max_repeat = syntax::max_repeat;
+
+        /// Default largest number of states of the automaton once the repetitions are spelled out
+        static const size_t default_max_states = syntax::max_states;
+
         /**
          * @brief Constructor for the parser
+         * @param max_states Largest number of states of the automaton once the repetitions are spelled out, a
+         * pattern whose repetitions would make more is rejected
          */
-        Parser();
+        explicit Parser(size_t max_states = default_max_states);
 
         /**
          * @brief Destructor for the parser
@@ -170,10 +209,23 @@ namespace Regex {
         token_list tokenList();
 
         /**
-         * Gets the associated NFA that accepts the same language as the regex pattern
-         * @return Associated NFA
+         * Gets the compiled automata that accepts the same language as the regex pattern
+         *
+         * This must be called only once after a succesful parse().
+         * @return Associated program
          */
-        Automata::NFA getBuiltNFA();
+        Automata::Program getProgram();
+
+        /**
+         * Gets the literal strings which every match of the pattern contains
+         *
+         * This must be called after a succesful parse().
+         * @return Literals of the pattern
+         */
+        Literals getLiterals() const;
+
+        /// Returns the number of capture groups of the pattern, group 0 (the whole pattern) included
+        size_t groupCount() const;
 
     private:
         /**
@@ -202,6 +254,18 @@ namespace Regex {
 
         /// Grammar rule
         void P();
+
+        /// Returns true if the lookahead matches a single symbol: a character, an escape sequence, a class or the dot
+        bool atSymbol() const;
+
+        /**
+         * @brief Reads the counts of a bounded repetition token
+         * @param lexeme Lexeme of the token, like `{2,5}`
+         * @param min Set to the least number of occurrences
+         * @param max Set to the largest number of occurrences, Automata::ProgramBuilder::unbounded for `{m,}`
+         * @throws ParserError if a count is larger than max_repeat or max is less than min
+         */
+        static void repetition(std::string const& lexeme, size_t& min, size_t& max);
     };
 }
 
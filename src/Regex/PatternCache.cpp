@@ -0,0 +1,156 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file PatternCache.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Implementation file for the class PatternCache
+ *
+ */
+//</editor-fold>
+#include <chrono>
+
+#include "PatternCache.h"
+#include "Parser.h"
+#include "RegexErrors.h"
+
+namespace Regex {
+
+    const size_t PatternCache::default_capacity;
+
+    PatternCache::PatternCache(size_t capacity)
+            : capacity_(capacity),
+              hits_(0),
+              misses_(0),
+              evictions_(0)
+    {
+        rebuildIndex();
+    }
+
+    std::shared_ptr<const CompiledPattern> PatternCache::get(std::string const &pattern) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            index_type::iterator found = index_.find(pattern);
+            if (found != index_.end())
+            {
+                entries_.splice(entries_.begin(), entries_, found->second); // most recently used
+                hits_++;
+                return entries_.front().second;
+            }
+            misses_++;
+        }
+
+        std::shared_ptr<const CompiledPattern> compiled = compile(pattern);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (capacity_ == 0)
+            return compiled;
+
+        index_type::iterator found = index_.find(pattern);
+        if (found != index_.end()) // compiled by another thread meanwhile
+            return found->second->second;
+
+        entries_.push_front(entry_type(pattern, compiled));
+        index_.insert(pattern, entries_.begin());
+        evict();
+        return compiled;
+    }
+
+    void PatternCache::clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+        rebuildIndex();
+    }
+
+    void PatternCache::setCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        capacity_ = capacity;
+        evict();
+        rebuildIndex();
+    }
+
+    size_t PatternCache::capacity() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return capacity_;
+    }
+
+    size_t PatternCache::size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+    size_t PatternCache::hits() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return hits_;
+    }
+
+    size_t PatternCache::misses() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return misses_;
+    }
+
+    size_t PatternCache::evictions() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return evictions_;
+    }
+
+    PatternCache& PatternCache::shared() {
+        static PatternCache cache;
+        return cache;
+    }
+
+    std::shared_ptr<const CompiledPattern> PatternCache::compile(std::string const &pattern) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        Parser parser;
+        try
+        {
+            parser.parse(pattern);
+        } catch (ParserError const&)
+        {
+            throw InvalidRegexError();
+        }
+
+        std::shared_ptr<CompiledPattern> compiled = std::make_shared<CompiledPattern>();
+        compiled->pattern = pattern;
+        compiled->search_program = std::make_shared<const Automata::Program>(parser.getProgram());
+        compiled->program = std::make_shared<const Automata::Program>(compiled->search_program->simplified());
+        compiled->literals = parser.getLiterals();
+        compiled->compile_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return compiled;
+    }
+
+    void PatternCache::evict() {
+        while (entries_.size() > capacity_)
+        {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+            evictions_++;
+        }
+    }
+
+    void PatternCache::rebuildIndex() {
+        index_ = index_type(capacity_ + 1);
+        for (lru_list_type::iterator it = entries_.begin(); it != entries_.end(); it++)
+            index_.insert(it->first, it);
+    }
+}
@@ -0,0 +1,168 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file PatternCache.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the class PatternCache
+ *
+ * # Description
+ * This file contains the cache of compiled patterns shared by every Regex of the process.
+ *
+ */
+//</editor-fold>
+#ifndef MYREGEX_PATTERNCACHE_H
+#define MYREGEX_PATTERNCACHE_H
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "../Automata/Program.h"
+#include "../Automata/DenseDFA.h"
+#include "../Hashtable/FlatHashtable.h"
+#include "Literals.h"
+
+namespace Regex {
+
+    /// A compiled pattern. It is never modified once compiled, and is shared by every Regex of the pattern.
+    struct CompiledPattern {
+        /// Regular expression
+        std::string pattern;
+
+        /// Automaton of the pattern, simplified for matching (see Automata::Program::simplified())
+        std::shared_ptr<const Automata::Program> program;
+
+        /// Automaton of the pattern as parsed, with its epsilon transitions in order of preference. Runs the
+        /// forward pass of Matcher::search().
+        std::shared_ptr<const Automata::Program> search_program;
+
+        /// Literals of the pattern, see Parser::getLiterals()
+        Literals literals;
+
+        /// Fully built DFA of the pattern, if there is one. Patterns are compiled without, see PatternFile.
+        std::shared_ptr<const Automata::DenseDFA> dfa;
+
+        /// Time it took to compile the pattern, in seconds. 0 if it was loaded rather than compiled.
+        double compile_seconds;
+
+        CompiledPattern()
+                : compile_seconds(0)
+        {}
+    };
+
+    /**
+     * @class PatternCache
+     * @author Carlos Brito (carlos.brito524@gmail.com)
+     * @date 10/14/26.
+     *
+     * @brief Thread safe cache of compiled patterns, keyed by the pattern string
+     *
+     * # Description
+     * get() compiles a pattern the first time it is asked for, then returns the same CompiledPattern for as
+     * long as the pattern stays in the cache. The cache holds at most capacity() patterns, when it is full the
+     * least recently used one is evicted. An evicted pattern lives on in the Regex objects still using it.
+     *
+     * Patterns are compiled outside of the lock, so a slow compilation doesn't hold up the other threads. If
+     * two threads miss on the same pattern at once both compile it and the first one to finish is kept.
+     * Invalid patterns are not cached.
+     *
+     * The counters only ever grow, they are meant to be sampled.
+     */
+    class PatternCache {
+    public:
+        /// Capacity of the shared cache
+        static const size_t default_capacity = 512;
+
+        /**
+         * @brief Constructs an empty cache
+         * @param capacity Maximum number of patterns, 0 disables caching
+         */
+        explicit PatternCache(size_t capacity = default_capacity);
+
+        /**
+         * @brief Returns the compiled pattern, compiling it if it isn't in the cache
+         * @param pattern Regular expression
+         * @return Compiled pattern
+         * @throws InvalidRegexError if the pattern is invalid
+         */
+        std::shared_ptr<const CompiledPattern> get(std::string const& pattern);
+
+        /// Removes every pattern from the cache. The counters are kept.
+        void clear();
+
+        /// Sets the maximum number of patterns, evicting the least recently used ones if there are more
+        void setCapacity(size_t capacity);
+
+        /// Returns the maximum number of patterns
+        size_t capacity() const;
+
+        /// Returns the number of patterns in the cache
+        size_t size() const;
+
+        /// Returns the number of calls to get() which found the pattern in the cache
+        size_t hits() const;
+
+        /// Returns the number of calls to get() which compiled the pattern
+        size_t misses() const;
+
+        /// Returns the number of patterns evicted to make room for others
+        size_t evictions() const;
+
+        /// Returns the cache used by every Regex of the process
+        static PatternCache& shared();
+
+        /// Compiles a pattern without looking at any cache
+        static std::shared_ptr<const CompiledPattern> compile(std::string const& pattern);
+
+    private:
+        PatternCache(PatternCache const&);
+        PatternCache& operator=(PatternCache const&);
+
+        typedef std::pair<std::string, std::shared_ptr<const CompiledPattern> > entry_type;
+
+        /// Entries from the most to the least recently used
+        typedef std::list<entry_type> lru_list_type;
+
+        typedef flat_hashtable<std::string, lru_list_type::iterator> index_type;
+
+        /// Evicts the least recently used entries until there are at most capacity_. Needs the lock.
+        void evict();
+
+        /// Rebuilds the index with a number of buckets fit for capacity_. Needs the lock.
+        void rebuildIndex();
+
+        mutable std::mutex mutex_;
+        size_t capacity_;
+        lru_list_type entries_;
+        index_type index_;
+
+        size_t hits_;
+        size_t misses_;
+        size_t evictions_;
+    };
+}
+
+#endif //MYREGEX_PATTERNCACHE_H
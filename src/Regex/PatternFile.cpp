@@ -0,0 +1,213 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file PatternFile.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Implementation file for the class PatternFile
+ *
+ */
+//</editor-fold>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "PatternFile.h"
+#include "RegexErrors.h"
+#include "../Automata/AutomataErrors.h"
+#include "../IO/Image.h"
+#include "../IO/MappedFile.h"
+
+namespace Regex {
+
+    namespace {
+        const char file_magic[8] = {'M', 'Y', 'R', 'X', 'S', 'E', 'T', 0};
+        const uint32_t byte_order_mark = 0x01020304;
+
+        /// Reads a string of size bytes
+        bool read_string(ImageReader &reader, uint32_t size, std::string &str) {
+            const char* data = reader.read(size);
+            if (!data)
+                return false;
+
+            str.assign(data, size);
+            return true;
+        }
+    }
+
+    const uint32_t PatternFile::version;
+
+    void PatternFile::save(std::string const &path, std::vector<std::shared_ptr<const CompiledPattern> > const &patterns,
+                           size_t dfa_max_states) {
+        std::vector<char> image;
+        ImageWriter writer(image);
+
+        writer.write(file_magic, sizeof(file_magic));
+        writer.write(version);
+        writer.write(byte_order_mark);
+        writer.write(static_cast<uint32_t>(patterns.size()));
+        writer.write(static_cast<uint32_t>(0));
+
+        for (size_t i = 0; i < patterns.size(); i++)
+        {
+            CompiledPattern const& compiled = *patterns[i];
+
+            std::shared_ptr<const Automata::DenseDFA> dfa = compiled.dfa;
+            if (!dfa && dfa_max_states > 0)
+            {
+                try
+                {
+                    dfa = std::make_shared<const Automata::DenseDFA>(*compiled.program, dfa_max_states);
+                } catch (Automata::TooManyStatesError const&)
+                {
+                    // the pattern is saved without, it is matched with the lazy DFA
+                }
+            }
+
+            Literals const& literals = compiled.literals;
+            writer.align();
+            writer.write(static_cast<uint32_t>(compiled.pattern.size()));
+            writer.write(static_cast<uint32_t>(literals.prefix.size()));
+            writer.write(static_cast<uint32_t>(literals.suffix.size()));
+            writer.write(static_cast<uint32_t>(literals.required.size()));
+            writer.write(static_cast<uint8_t>(literals.exact ? 1 : 0));
+            writer.write(static_cast<uint8_t>(dfa ? 1 : 0));
+            writer.write(static_cast<uint16_t>(0));
+            writer.write(compiled.pattern.data(), compiled.pattern.size());
+            writer.write(literals.prefix.data(), literals.prefix.size());
+            writer.write(literals.suffix.data(), literals.suffix.size());
+            writer.write(literals.required.data(), literals.required.size());
+            writer.align();
+
+            compiled.program->save(image);
+            (compiled.search_program ? *compiled.search_program : *compiled.program).save(image);
+            if (dfa)
+                dfa->save(image);
+        }
+
+        std::ofstream out(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!out)
+            throw FileError(path, "write");
+
+        out.write(image.data(), static_cast<std::streamsize>(image.size()));
+        out.close();
+        if (!out)
+            throw FileError(path, "write");
+    }
+
+    std::vector<std::shared_ptr<const CompiledPattern> > PatternFile::load(std::string const &path) {
+        std::shared_ptr<const void> storage;
+        const char* first;
+        const char* last;
+
+        std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+        if (file->open(path) && file->is_mapped())
+        {
+            first = file->data();
+            last = first + file->size();
+            storage = file;
+        } else
+        {
+            // can't be mapped, read it whole. The buffer of a vector is aligned enough for the images.
+            std::shared_ptr<std::vector<char> > buffer = std::make_shared<std::vector<char> >();
+            if (file->is_open()) // a pipe, read from the descriptor which is already open
+            {
+                std::vector<char> chunk(1 << 16);
+                size_t count;
+                do
+                {
+                    if (!file->read(chunk.data(), chunk.size(), count))
+                        throw FileError(path);
+                    buffer->insert(buffer->end(), chunk.begin(), chunk.begin() + count);
+                } while (count > 0);
+            } else
+            {
+                std::ifstream in(path.c_str(), std::ios::in | std::ios::binary);
+                if (!in)
+                    throw FileError(path);
+
+                buffer->assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+                if (in.bad())
+                    throw FileError(path);
+            }
+
+            first = buffer->data();
+            last = first + buffer->size();
+            storage = buffer;
+        }
+
+        ImageReader reader(first, last);
+        const char* magic = reader.read(sizeof(file_magic));
+        if (!magic || std::memcmp(magic, file_magic, sizeof(file_magic)) != 0)
+            throw Automata::InvalidImageError("not a pattern file: " + path);
+
+        uint32_t file_version, byte_order, count, reserved;
+        if (!reader.read_value(file_version) || !reader.read_value(byte_order) || !reader.read_value(count) || !reader.read_value(reserved))
+            throw Automata::InvalidImageError("truncated pattern file header");
+
+        if (file_version != version)
+            throw Automata::InvalidImageError("unsupported pattern file version " + std::to_string(file_version));
+
+        if (byte_order != byte_order_mark)
+            throw Automata::InvalidImageError("pattern file saved on an incompatible machine");
+
+        std::vector<std::shared_ptr<const CompiledPattern> > patterns;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            std::shared_ptr<CompiledPattern> compiled = std::make_shared<CompiledPattern>();
+
+            uint32_t pattern_size, prefix_size, suffix_size, required_size;
+            uint8_t exact, has_dfa;
+            uint16_t padding;
+            if (!reader.align() || !reader.read_value(pattern_size) || !reader.read_value(prefix_size)
+                || !reader.read_value(suffix_size) || !reader.read_value(required_size) || !reader.read_value(exact)
+                || !reader.read_value(has_dfa) || !reader.read_value(padding)
+                || !read_string(reader, pattern_size, compiled->pattern)
+                || !read_string(reader, prefix_size, compiled->literals.prefix)
+                || !read_string(reader, suffix_size, compiled->literals.suffix)
+                || !read_string(reader, required_size, compiled->literals.required)
+                || !reader.align())
+                throw Automata::InvalidImageError("truncated pattern file");
+
+            compiled->literals.exact = exact != 0;
+
+            const char* next;
+            compiled->program = std::make_shared<const Automata::Program>(
+                    Automata::Program::load(reader.position(), last, next, storage));
+            compiled->search_program = std::make_shared<const Automata::Program>(
+                    Automata::Program::load(next, last, next, storage));
+
+            // every group but group 0 takes at least the two parentheses of the pattern
+            if (compiled->search_program->group_count() > compiled->pattern.size() / 2 + 1)
+                throw Automata::InvalidImageError("corrupted program groups");
+
+            if (has_dfa)
+                compiled->dfa = std::make_shared<const Automata::DenseDFA>(
+                        Automata::DenseDFA::load(next, last, next, storage));
+
+            reader = ImageReader(next, last);
+            patterns.push_back(compiled);
+        }
+
+        return patterns;
+    }
+}
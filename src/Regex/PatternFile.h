@@ -0,0 +1,90 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file PatternFile.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the class PatternFile
+ *
+ * # Description
+ * This file contains the binary file format in which sets of compiled patterns are saved.
+ *
+ */
+//</editor-fold>
+#ifndef MYREGEX_PATTERNFILE_H
+#define MYREGEX_PATTERNFILE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "PatternCache.h"
+
+namespace Regex {
+
+    /**
+     * @class PatternFile
+     * @author Carlos Brito (carlos.brito524@gmail.com)
+     * @date 10/14/26.
+     *
+     * @brief Saves compiled patterns to a file and loads them back without compiling them again
+     *
+     * # Description
+     * A set of patterns can be compiled once, offline, and saved with save(). load() maps the file in
+     * memory (see MappedFile) and every Automata::Program and Automata::DenseDFA it returns reads its
+     * arrays right where they lie in the mapping, see Automata::Program::load(). So loading only costs
+     * checking the file, and the pages of a pattern are only read from disk once it is used. The mapping
+     * stays open for as long as any of the patterns is in use.
+     *
+     * The file starts with a versioned header, then holds for each pattern its string and literals, the
+     * images of its program and of its search program (see CompiledPattern) and optionally the image of its
+     * DFA. Files are only portable between machines with the same byte order.
+     */
+    class PatternFile {
+    public:
+        /// Version of the file format
+        static const uint32_t version = 2;
+
+        /**
+         * @brief Saves compiled patterns to a file, replacing it
+         * @param path Path of the file
+         * @param patterns Compiled patterns, see PatternCache::compile()
+         * @param dfa_max_states If not 0, a Automata::DenseDFA is saved for each pattern which doesn't have one,
+         * provided it has at most this many states
+         * @throws FileError if the file can't be written
+         */
+        static void save(std::string const& path, std::vector<std::shared_ptr<const CompiledPattern> > const& patterns,
+                         size_t dfa_max_states = 0);
+
+        /**
+         * @brief Loads the compiled patterns of a file made by save()
+         * @param path Path of the file
+         * @return Compiled patterns, in the order they were saved
+         * @throws FileError if the file can't be read
+         * @throws Automata::InvalidImageError if it isn't a valid pattern file
+         */
+        static std::vector<std::shared_ptr<const CompiledPattern> > load(std::string const& path);
+    };
+}
+
+#endif //MYREGEX_PATTERNFILE_H
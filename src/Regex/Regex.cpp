@@ -30,48 +30,358 @@
  *
  */
 //</editor-fold>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <utility>
 #include "Regex.h"
 #include "RegexErrors.h"
+#include "../Automata/AutomataErrors.h"
+#include "../IO/MappedFile.h"
 
 namespace Regex {
 
-    Regex::Regex(std::string pattern) {
-        pattern_ = pattern;
+    const size_t Regex::parallel_chunk_size;
+    const size_t Regex::match_batch_size;
+    const size_t Regex::parallel_min_part;
+    const size_t Regex::file_chunk_size;
+    const size_t Regex::prefilter_probe_lines;
+
+    Regex::Regex(std::string pattern, size_t dfa_memory_budget)
+            : pattern_(std::move(pattern)),
+              matcher_(std::shared_ptr<const Automata::Program>(), ENGINE_LAZY_DFA, dfa_memory_budget),
+              engine_(ENGINE_AUTO),
+              denseTooLarge_(false),
+              workers_(std::make_shared<WorkerMatchers>())
+    {
 
         try
         {
             compile();
-        } catch (InvalidRegexError e)
+        } catch (InvalidRegexError const&)
         {
-            std::cout << "Invalid regular expression with pattern: " + pattern;
-            throw e;
+            std::cout << "Invalid regular expression with pattern: " + pattern_;
+            throw;
         }
 
     }
 
+    Regex::Regex(std::shared_ptr<const CompiledPattern> compiled, size_t dfa_memory_budget)
+            : pattern_(compiled->pattern),
+              compiled_(compiled),
+              matcher_(std::shared_ptr<const Automata::Program>(), ENGINE_LAZY_DFA, dfa_memory_budget),
+              engine_(ENGINE_AUTO),
+              denseTooLarge_(false),
+              workers_(std::make_shared<WorkerMatchers>())
+    {
+        bind(engine_);
+    }
+
     void Regex::compile() {
+        compiled_ = PatternCache::shared().get(pattern_);
+        dense_.reset();
+        denseTooLarge_ = false;
+        bind(engine_);
+    }
+
+    void Regex::bind(Engine engine) {
+        matcher_ = Matcher(compiled_->program, engine, matcher_.dfa_memory_budget(), compiled_->literals,
+                           denseDFA(engine), compiled_->search_program);
+        workers_ = std::make_shared<WorkerMatchers>(); // the old matchers run the old pattern or engine
+    }
+
+    std::shared_ptr<const Automata::DenseDFA> Regex::denseDFA(Engine engine) {
+        if (compiled_->dfa)
+            return compiled_->dfa;
+
+        if (engine != ENGINE_DENSE_DFA)
+            return std::shared_ptr<const Automata::DenseDFA>();
+
+        if (!dense_)
+            dense_ = std::make_shared<const Automata::DenseDFA>(*compiled_->program);
+
+        return dense_;
+    }
+
+    bool Regex::match(std::string_view str) {
+        return matcher_.match(str.data(), str.data() + str.size());
+    }
+
+    bool Regex::match(std::string_view str, std::vector<Match> &groups) {
+        return matcher_.match(str.data(), str.data() + str.size(), groups);
+    }
+
+    size_t Regex::group_count() const {
+        return matcher_.group_count();
+    }
+
+    std::vector<bool> Regex::match_many(std::vector<std::string> const &strs) {
+        return match_many(strs.begin(), strs.end());
+    }
+
+    std::vector<bool> Regex::match_many_parallel(std::vector<std::string> const &strs, ThreadPool &pool) const {
+        return match_many_parallel(strs.begin(), strs.end(), pool);
+    }
+
+    bool Regex::feed(const char *data, size_t size) {
+        return matcher_.feed(data, size);
+    }
+
+    bool Regex::finish() {
+        return matcher_.finish();
+    }
+
+    void Regex::reset() {
+        matcher_.reset();
+    }
+
+    std::vector<size_t> Regex::scan_file(std::string const &path) {
+        std::vector<size_t> offsets;
+        size_t offset = 0;      // offset of the current chunk in the file
+        size_t line_start = 0;  // offset of the current line in the file
+        bool alive = true;      // whether the current line may still match
+        bool at_line_start = true;
+        Automata::Prefilter const& required = matcher_.required();
+        bool prefilter = !required.empty();
+        size_t prefilter_checks = 0;
+        size_t prefilter_skips = 0;
+
+        matcher_.reset();
+        readFile(path, [&](const char* data, size_t size) {
+            const char* it = data;
+            const char* end = data + size;
+            while (it != end)
+            {
+                if (at_line_start && prefilter)
+                {
+                    // no line before the one of the next occurrence of the literal can match, skip them
+                    const char* found = required.find(it, end);
+                    const char* line = found ? found : end;
+                    if (!found || std::memchr(it, '\n', found - it))
+                    {
+                        while (line != it && line[-1] != '\n')
+                            --line;
+
+                        line_start = offset + (line - data);
+                        it = line;
+                        prefilter_skips++;
+                    }
+
+                    // almost every line has the literal, looking for it only slows the scan down
+                    if (++prefilter_checks == prefilter_probe_lines && prefilter_skips < prefilter_probe_lines / 8)
+                        prefilter = false;
+
+                    if (it == end)
+                        break;
+                }
+
+                at_line_start = false;
+                const char* nl = static_cast<const char*>(std::memchr(it, '\n', end - it));
+                const char* stop = nl ? nl : end;
+
+                if (alive)
+                    alive = matcher_.feed(it, stop - it);
+
+                if (!nl)
+                    break;
+
+                if (matcher_.finish() && alive)
+                    offsets.push_back(line_start);
+
+                alive = true;
+                at_line_start = true;
+                line_start = offset + (nl + 1 - data);
+                it = nl + 1;
+            }
+
+            offset += size;
+            return true;
+        });
+
+        // last line, with no newline at the end
+        if (line_start < offset && !at_line_start && matcher_.finish() && alive)
+            offsets.push_back(line_start);
+
+        matcher_.reset();
+        return offsets;
+    }
+
+    bool Regex::match_file(std::string const &path) {
+        MappedFile file;
+        file.open(path);
+        return matchFile(file, path);
+    }
+
+    bool Regex::matchFile(MappedFile &file, std::string const &path) {
+        bool alive = true;
+
+        matcher_.reset();
+        readFile(file, path, [&](const char* data, size_t size) {
+            alive = matcher_.feed(data, size);
+            return alive;
+        });
+
+        return matcher_.finish() && alive;
+    }
+
+    bool Regex::match_parallel(std::string_view str, ThreadPool &pool) {
+        size_t part_count = std::min(pool.thread_count(), str.size() / parallel_min_part);
+        if (!compiled_ || part_count < 2 || denseTooLarge_)
+            return match(str);
+
+        std::shared_ptr<const Automata::DenseDFA> dfa;
         try
         {
-            parser.parse(pattern_);
-        } catch (ParserError e)
+            dfa = denseDFA(ENGINE_DENSE_DFA);
+        } catch (Automata::TooManyStatesError const&)
+        {
+            denseTooLarge_ = true; // don't try again for every string
+            return match(str);
+        }
+
+        // the first part starts in the initial state, the others in any state
+        size_t part_size = (str.size() + part_count - 1) / part_count;
+        std::vector<std::vector<Automata::DenseDFA::state_id> > reached(part_count);
+        Automata::DenseDFA::state_id s = dfa->start();
+        pool.parallel_for(part_count, [&](size_t, size_t part) {
+            const char* first = str.data() + part * part_size;
+            const char* last = str.data() + std::min(str.size(), (part + 1) * part_size);
+            if (part == 0)
+                s = dfa->run(s, first, last);
+            else
+                dfa->run_all(first, last, reached[part]);
+        });
+
+        for (size_t part = 1; part < part_count && s != Automata::DenseDFA::dead_state; part++)
+            s = reached[part][dfa->state_index(s)];
+
+        return dfa->isEnd(s);
+    }
+
+    bool Regex::match_file_parallel(std::string const &path, ThreadPool &pool) {
+        MappedFile file;
+        if (!file.open(path) || !file.is_mapped())
+            return matchFile(file, path); // read from the same descriptor, a pipe can't be opened twice
+
+        return match_parallel(std::string_view(file.data(), file.size()), pool);
+    }
+
+    void Regex::readFile(std::string const &path, std::function<bool(const char *, size_t)> const &fn) {
+        MappedFile file;
+        file.open(path);
+        readFile(file, path, fn);
+    }
+
+    void Regex::readFile(MappedFile &file, std::string const &path,
+                         std::function<bool(const char *, size_t)> const &fn) {
+        if (file.is_mapped())
+        {
+            fn(file.data(), file.size());
+            return;
+        }
+
+        std::vector<char> buffer(file_chunk_size);
+        if (file.is_open())
+        {
+            size_t count;
+            do
+            {
+                if (!file.read(buffer.data(), buffer.size(), count))
+                    throw FileError(path);
+            } while (count > 0 && fn(buffer.data(), count));
+            return;
+        }
+
+        // no mmap on this system
+        std::ifstream in(path.c_str(), std::ios::in | std::ios::binary);
+        if (!in)
+            throw FileError(path);
+
+        while (in)
         {
-            throw InvalidRegexError();
+            in.read(buffer.data(), buffer.size());
+            size_t count = static_cast<size_t>(in.gcount());
+            if (count == 0 || !fn(buffer.data(), count))
+                break;
         }
 
-        nfa_ = parser.getBuiltNFA();
+        if (in.bad())
+            throw FileError(path);
     }
 
-    bool Regex::match(std::string str) {
-        return nfa_.match(str);
+    bool Regex::search(std::string_view str, Match &match) {
+        return matcher_.search(str.data(), str.data() + str.size(), match);
     }
 
-    Regex::Regex() {
+    bool Regex::search(std::string_view str, std::vector<Match> &groups) {
+        return matcher_.search(str.data(), str.data() + str.size(), groups);
+    }
+
+    std::vector<Match> Regex::find_all(std::string_view str) {
+        std::vector<Match> matches;
+        matcher_.find_all(str.data(), str.data() + str.size(), matches);
+        return matches;
+    }
+
+    Stats Regex::stats() const {
+        Stats result = matcher_.stats();
+        result.pattern = pattern_;
+        if (compiled_)
+            result.compile_seconds = compiled_->compile_seconds;
+        return result;
+    }
+
+    void Regex::resetStats() {
+        matcher_.resetStats();
+    }
+
+    Matcher Regex::new_matcher() const {
+        if (!compiled_)
+            return Matcher(std::shared_ptr<const Automata::Program>(), matcher_.engine(), matcher_.dfa_memory_budget());
+
+        // dense_ is built by setEngine(), it is there for ENGINE_DENSE_DFA
+        std::shared_ptr<const Automata::DenseDFA> dense = compiled_->dfa;
+        if (!dense && matcher_.engine() == ENGINE_DENSE_DFA)
+            dense = dense_;
+
+        // with ENGINE_SHARED_DFA, every matcher shares the state cache of matcher_
+        return Matcher(compiled_->program, matcher_.engine(), matcher_.dfa_memory_budget(), compiled_->literals, dense,
+                       compiled_->search_program, matcher_.shared());
+    }
+
+    std::shared_ptr<const Automata::Program> Regex::program() const {
+        if (!compiled_)
+            return std::shared_ptr<const Automata::Program>();
+
+        return compiled_->program;
+    }
+
+    Regex::Regex()
+            : engine_(ENGINE_AUTO),
+              denseTooLarge_(false),
+              workers_(std::make_shared<WorkerMatchers>())
+    {
         pattern_ = "";
     }
 
     void Regex::setPattern(std::string pattern) {
-        pattern_ = pattern;
+        pattern_ = std::move(pattern);
         compile();
     }
-}
+
+    void Regex::setEngine(Engine engine) {
+        engine_ = engine;
+        if (!compiled_)
+        {
+            matcher_.setEngine(engine);
+            workers_ = std::make_shared<WorkerMatchers>();
+            return;
+        }
+
+        bind(engine);
+    }
+
+    Engine Regex::engine() const {
+        return engine_;
+    }
+}
\ No newline at end of file
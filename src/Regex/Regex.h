@@ -28,9 +28,21 @@
 #ifndef MYREGEX_REGEX_H
 #define MYREGEX_REGEX_H
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <vector>
 #include "../Automata/NFA.h"
+#include "../Automata/Program.h"
+#include "../Automata/LazyDFA.h"
+#include "../IO/MappedFile.h"
+#include "../Thread/ThreadPool.h"
+#include "Matcher.h"
 #include "Parser.h"
+#include "PatternCache.h"
 
 namespace Regex {
 
@@ -44,25 +56,376 @@ namespace Regex {
      * # Description
      * It parses regular expressions.
      *
+     * The pattern is parsed and compiled into an Automata::Program. By default, matching is done with a lazily
+     * built DFA (see Automata::LazyDFA) whose state cache is bounded by a memory budget which can be given on
+     * construction. The program can also be simulated directly (see Automata::PikeVM), which is slower on
+     * average but never allocates memory and doesn't depend on the state of a cache. A short nondeterministic
+     * pattern is matched by the bit-parallel engine instead (see Automata::BitParallelNFA), which doesn't
+     * suffer when the DFA has too many states to be cached.
+     *
+     * The compiled program is immutable and shared, the state modified while matching lives in a Matcher.
+     * match() and match_many() use the Matcher of the Regex itself, so they must not be called from two
+     * threads at the same time. match_many_parallel() is const and gives each worker thread its own
+     * Matcher, kept from one call to the next, and new_matcher() returns a Matcher for use in any other
+     * thread. Each of these matchers
+     * builds a DFA cache of its own, unless the engine is ENGINE_SHARED_DFA: they then all fill a single
+     * cache, see Automata::SharedLazyDFA.
+     *
+     * Compiled patterns are kept in PatternCache::shared(), so constructing a Regex for a pattern which
+     * was compiled recently only copies a pointer to it.
+     *
      * # TODO
      * Many many things.
      *
      */
     class Regex {
+    private:
         std::string pattern_;
-        Automata::NFA nfa_;
-        Parser parser;
+        std::shared_ptr<const CompiledPattern> compiled_;
+        Matcher matcher_;
+
+        /// Engine set by setEngine(), ENGINE_AUTO is resolved again for every pattern
+        Engine engine_;
+
+        /// Minimal DFA built for ENGINE_DENSE_DFA, if compiled_ has none
+        std::shared_ptr<const Automata::DenseDFA> dense_;
+
+        /// True once dense_ couldn't be built for having too many states, match_parallel() then runs on one thread
+        bool denseTooLarge_;
+
+        /// Matchers of the worker threads of match_many_parallel(), one per worker index
+        struct WorkerMatchers {
+            /// Held for a whole call, the matchers of a worker index are used by one thread at a time
+            std::mutex mutex;
+
+            /// Created the first time a worker runs a task, empty for the workers which never did
+            std::vector<std::unique_ptr<Matcher> > matchers;
+        };
+
+        /// Matchers of match_many_parallel(), replaced by bind() so they always match the pattern and engine
+        std::shared_ptr<WorkerMatchers> workers_;
 
     public:
+        /// Number of strings matched by a task of match_many_parallel()
+        static const size_t parallel_chunk_size = 256;
+
+        /// Number of strings match_many() hands to the matcher at once, see Matcher::match_many()
+        static const size_t match_batch_size = 64;
+
+        /// Smallest part of a string match_parallel() gives a worker thread
+        static const size_t parallel_min_part = 1 << 20;
+
+        /// Size of the chunks in which a file is read when it can't be mapped in memory
+        static const size_t file_chunk_size = 1 << 16;
+
+        /// scan_file() stops looking for the required literal if it skipped few lines in this many
+        static const size_t prefilter_probe_lines = 256;
+
         Regex();
-        Regex(std::string pattern);
+        Regex(std::string pattern, size_t dfa_memory_budget = Automata::LazyDFA::default_memory_budget);
+
+        /**
+         * @brief Constructs a Regex for a pattern compiled beforehand, for example loaded by PatternFile::load()
+         * @param compiled Compiled pattern, shared
+         * @param dfa_memory_budget Memory budget of the DFA state cache
+         */
+        explicit Regex(std::shared_ptr<const CompiledPattern> compiled,
+                       size_t dfa_memory_budget = Automata::LazyDFA::default_memory_budget);
         void setPattern(std::string pattern);
-        bool match(std::string str);
+        bool match(std::string_view str);
+
+        /**
+         * @brief Returns true if the whole string matches the pattern, and where each group of the pattern matched
+         *
+         * Every parenthesized expression is a group, numbered from 1 in the order of its left parenthesis.
+         * See Matcher for how the groups are found.
+         *
+         * @param str String to match
+         * @param groups Set to the byte offsets of the `group_count()` groups on a match, group 0 being the
+         * whole string. A group which took no part in the match is at Match::npos.
+         * @return true if string matches pattern, false otherwise
+         */
+        bool match(std::string_view str, std::vector<Match> &groups);
+
+        /// Returns the number of capture groups of the pattern, group 0 (the whole match) included
+        size_t group_count() const;
+
+        /**
+         * @brief Sets the matching engine
+         *
+         * ENGINE_DENSE_DFA builds the minimal DFA of the pattern right away, once for this Regex and every
+         * matcher it hands out, unless the pattern was loaded with one. The default is ENGINE_AUTO, see
+         * Matcher::select_engine().
+         *
+         * @throws Automata::TooManyStatesError if the DFA of the pattern is too large for ENGINE_DENSE_DFA
+         */
+        void setEngine(Engine engine);
+
+        /// Returns the engine set by setEngine(), see Matcher::engine() for the one ENGINE_AUTO stands for
+        Engine engine() const;
+
+        /**
+         * @brief Matches every string of a range against the pattern
+         *
+         * The strings are not copied and the matcher is set up once for the whole batch, the scratch
+         * memory of the engine and the result vector are reused from one string to the next. They are
+         * handed to the matcher `match_batch_size` at a time, and the DFA engines run several of them in
+         * lockstep, see Matcher::match_many().
+         *
+         * @param first Iterator to the first string. Its value type must have `data()` and `size()`.
+         * @param last Iterator past the last string
+         * @param results Set to one result per string, in order
+         */
+        template <class InputIt>
+        void match_many(InputIt first, InputIt last, std::vector<bool> &results);
+
+        /**
+         * @brief Matches every string of a range against the pattern. See the overload above.
+         * @return One result per string, in order
+         */
+        template <class InputIt>
+        std::vector<bool> match_many(InputIt first, InputIt last);
+
+        /**
+         * @brief Matches every string of a vector against the pattern. See the overloads above.
+         * @return One result per string, in order
+         */
+        std::vector<bool> match_many(std::vector<std::string> const& strs);
+
+        /**
+         * @brief Matches every string of a range against the pattern, in parallel
+         *
+         * The range is cut into chunks of parallel_chunk_size strings which are the tasks of the pool. Each
+         * worker matches its chunks with its own Matcher, created the first time it runs a chunk, so the
+         * workers only share the compiled program, which is read only. The engine and the DFA memory budget
+         * are the ones of this Regex, the budget applies to each worker.
+         *
+         * The matchers are kept in the Regex until the pattern or the engine changes, so the DFA caches stay
+         * warm from one call to the next. Calls on the same Regex are serialized, as ThreadPool::parallel_for()
+         * serializes the calls on one pool: a matcher is never used by two threads at once.
+         *
+         * @param first Iterator to the first string. Its value type must have `data()` and `size()`.
+         * @param last Iterator past the last string
+         * @param results Set to one result per string, in order
+         * @param pool Pool which runs the workers
+         */
+        template <class RandomIt>
+        void match_many_parallel(RandomIt first, RandomIt last, std::vector<bool> &results,
+                                 ThreadPool &pool = ThreadPool::shared()) const;
+
+        /**
+         * @brief Matches every string of a range against the pattern, in parallel. See the overload above.
+         * @return One result per string, in order
+         */
+        template <class RandomIt>
+        std::vector<bool> match_many_parallel(RandomIt first, RandomIt last,
+                                              ThreadPool &pool = ThreadPool::shared()) const;
+
+        /**
+         * @brief Matches every string of a vector against the pattern, in parallel. See the overloads above.
+         * @return One result per string, in order
+         */
+        std::vector<bool> match_many_parallel(std::vector<std::string> const& strs,
+                                              ThreadPool &pool = ThreadPool::shared()) const;
+
+        /**
+         * @brief Matches the next chunk of a stream. See Matcher::feed().
+         * @return false if no continuation of the stream can match anymore
+         */
+        bool feed(const char* data, size_t size);
+
+        /// Returns true if the stream fed so far matches the pattern, and starts a new stream
+        bool finish();
+
+        /// Starts a new stream, discarding the current one
+        void reset();
+
+        /**
+         * @brief Returns the lines of a file which match the pattern, like grep -x
+         *
+         * The file is mapped in memory (see MappedFile) and every line is fed to the streaming matcher
+         * right where it lies in the mapping, nothing is copied. A line which can't match anymore is skipped
+         * up to the next newline, and if the pattern requires a literal the lines before the next occurrence
+         * of it are skipped altogether. Files which can't be mapped are read in chunks of file_chunk_size bytes,
+         * a line may then span several chunks. Lines are separated by `\n`, which isn't part of the line.
+         *
+         * Uses the stream of this Regex, so any stream in progress is discarded.
+         *
+         * @param path Path of the file
+         * @return Byte offset of the start of every matching line, in increasing order
+         * @throws FileError if the file can't be read
+         */
+        std::vector<size_t> scan_file(std::string const& path);
+
+        /**
+         * @brief Returns true if the whole content of a file matches the pattern
+         *
+         * The file is read as in scan_file(), reading stops as soon as no continuation can match.
+         *
+         * @param path Path of the file
+         * @throws FileError if the file can't be read
+         */
+        bool match_file(std::string const& path);
+
+        /**
+         * @brief Returns true if the whole string matches the pattern, using every worker of a pool
+         *
+         * The string is split into one part per worker and each part is run on the minimal DFA of the pattern
+         * (see Automata::DenseDFA) from every state at once, since only the part before it tells which
+         * state it starts in. Then the state at the end of the string is found by following the states the
+         * parts lead to from left to right, see Automata::DenseDFA::run_all(). If the pattern has too many
+         * states for a DenseDFA, or the string is too short to be worth splitting, it is matched by match().
+         *
+         * The DFA is built by the first call, as for ENGINE_DENSE_DFA, unless the pattern was loaded with one.
+         *
+         * @param str String to match
+         * @param pool Pool which runs the workers
+         */
+        bool match_parallel(std::string_view str, ThreadPool &pool = ThreadPool::shared());
+
+        /**
+         * @brief Returns true if the whole content of a file matches the pattern, using every worker of a pool
+         *
+         * The file is mapped in memory and matched with match_parallel(). A file which can't be mapped, like
+         * a pipe, is read from the same descriptor and matched as by match_file().
+         *
+         * @param path Path of the file
+         * @param pool Pool which runs the workers
+         * @throws FileError if the file can't be read
+         */
+        bool match_file_parallel(std::string const& path, ThreadPool &pool = ThreadPool::shared());
+
+        /**
+         * @brief Finds the leftmost match of the pattern in a string
+         *
+         * See Matcher for which match is found and how.
+         *
+         * @param str String to search
+         * @param match Set to the byte offsets of the match, if any
+         * @return true if there is a match, false otherwise
+         */
+        bool search(std::string_view str, Match &match);
+
+        /**
+         * @brief Finds the leftmost match of the pattern in a string, and where each group of the pattern matched
+         * @param str String to search
+         * @param groups Set to the byte offsets of the `group_count()` groups if there is a match, group 0
+         * being the match search() finds. A group which took no part in the match is at Match::npos.
+         * @return true if there is a match, false otherwise
+         */
+        bool search(std::string_view str, std::vector<Match> &groups);
+
+        /**
+         * @brief Finds every match of the pattern in a string, from left to right. See Matcher::find_all().
+         * @return The byte offsets of the matches, in increasing order
+         */
+        std::vector<Match> find_all(std::string_view str);
+
+        /// Returns a new Matcher for the pattern, with the engine and DFA memory budget of this Regex
+        /**
+         * With ENGINE_SHARED_DFA the new matcher shares the state cache of this Regex.
+         */
+        Matcher new_matcher() const;
+
+        /// Returns the compiled pattern, as simplified for matching
+        std::shared_ptr<const Automata::Program> program() const;
+
+        /**
+         * @brief Returns the statistics of the pattern and of the matching done by this Regex
+         *
+         * Only the matcher of the Regex itself is counted, not the ones of match_many_parallel() or
+         * new_matcher(). The counters of the hot path are zero unless built with MYREGEX_ENABLE_STATS.
+         * `stats().prometheus()` gives them in the Prometheus text format.
+         */
+        Stats stats() const;
+
+        /// Sets the counters of the hot path back to zero
+        void resetStats();
 
     private:
         void compile();
 
+        /// Sets up the matcher for compiled_
+        void bind(Engine engine);
+
+        /// Returns the DFA the matcher should use with an engine, building it if needed
+        std::shared_ptr<const Automata::DenseDFA> denseDFA(Engine engine);
+
+        /// Calls fn on the content of a file, in one or more chunks, until it returns false
+        static void readFile(std::string const& path, std::function<bool(const char*, size_t)> const& fn);
+
+        /// Same as above for a file already opened, mapped or not. A pipe is read from its descriptor.
+        static void readFile(MappedFile& file, std::string const& path,
+                             std::function<bool(const char*, size_t)> const& fn);
+
+        /// match_file() of a file already opened
+        bool matchFile(MappedFile& file, std::string const& path);
+
     };
+
+    template <class InputIt>
+    void Regex::match_many(InputIt first, InputIt last, std::vector<bool> &results) {
+        results.clear();
+
+        std::string_view batch[match_batch_size];
+        unsigned char matched[match_batch_size];
+        while (first != last)
+        {
+            size_t count = 0;
+            for (; first != last && count < match_batch_size; ++first)
+                batch[count++] = std::string_view(first->data(), first->size());
+
+            matcher_.match_many(batch, count, matched);
+            results.insert(results.end(), matched, matched + count);
+        }
+    }
+
+    template <class InputIt>
+    std::vector<bool> Regex::match_many(InputIt first, InputIt last) {
+        std::vector<bool> results;
+        match_many(first, last, results);
+        return results;
+    }
+
+    template <class RandomIt>
+    void Regex::match_many_parallel(RandomIt first, RandomIt last, std::vector<bool> &results,
+                                    ThreadPool &pool) const {
+        size_t n = static_cast<size_t>(last - first);
+
+        // std::vector<bool> packs bits, neighbouring results can't be written from different threads
+        std::vector<unsigned char> matched(n);
+
+        std::lock_guard<std::mutex> lock(workers_->mutex);
+        std::vector<std::unique_ptr<Matcher> > &matchers = workers_->matchers;
+        if (matchers.size() < pool.thread_count())
+            matchers.resize(pool.thread_count());
+
+        pool.parallel_for((n + parallel_chunk_size - 1) / parallel_chunk_size, [&](size_t worker, size_t task) {
+            if (!matchers[worker])
+                matchers[worker].reset(new Matcher(new_matcher()));
+
+            Matcher &matcher = *matchers[worker];
+            size_t begin = task * parallel_chunk_size;
+            size_t end = std::min(n, begin + parallel_chunk_size);
+
+            std::string_view batch[parallel_chunk_size];
+            for (size_t i = begin; i < end; i++)
+            {
+                RandomIt it = first + i;
+                batch[i - begin] = std::string_view(it->data(), it->size());
+            }
+            matcher.match_many(batch, end - begin, &matched[begin]);
+        });
+
+        results.assign(matched.begin(), matched.end());
+    }
+
+    template <class RandomIt>
+    std::vector<bool> Regex::match_many_parallel(RandomIt first, RandomIt last, ThreadPool &pool) const {
+        std::vector<bool> results;
+        match_many_parallel(first, last, results, pool);
+        return results;
+    }
 }
 
 #endif //MYREGEX_REGEX_H
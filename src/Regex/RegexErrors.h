@@ -62,5 +62,24 @@ namespace Regex {
             return ("Mismatched Parentheses in Regex: " + mismatch_string_).c_str();
         }
     };
+
+    class FileError : public std::exception {
+
+        std::string message_;
+
+    public:
+        FileError(std::string path, std::string operation = "read")
+                : message_("Could not " + operation + " file: " + path) {
+        }
+
+        ~FileError() throw() {
+
+        }
+
+        virtual const char* what() const throw()
+        {
+            return message_.c_str();
+        }
+    };
 }
 #endif //MYREGEX_REGEXPERRORS_H
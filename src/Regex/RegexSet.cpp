@@ -0,0 +1,99 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file RegexSet.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Implementation file for the class RegexSet
+ *
+ */
+//</editor-fold>
+#include <algorithm>
+
+#include "RegexSet.h"
+
+namespace Regex {
+
+    RegexSet::RegexSet()
+            : offsets_(1, 1)
+    {}
+
+    RegexSet::RegexSet(std::vector<std::string> const &patterns, size_t dfa_memory_budget) {
+        // compiled apart from the shared cache, a large set would only evict the patterns of the Regex objects
+        std::vector<std::shared_ptr<const CompiledPattern> > compiled;
+        compiled.reserve(patterns.size());
+        for (size_t i = 0; i < patterns.size(); i++)
+            compiled.push_back(PatternCache::compile(patterns[i]));
+
+        build(compiled, dfa_memory_budget);
+    }
+
+    RegexSet::RegexSet(std::vector<std::shared_ptr<const CompiledPattern> > const &patterns,
+                       size_t dfa_memory_budget) {
+        build(patterns, dfa_memory_budget);
+    }
+
+    bool RegexSet::match(const char *first, const char *last, std::vector<size_t> &matches) {
+        matches.clear();
+        if (!program_ || !dfa_.match(first, last, finals_))
+            return false;
+
+        // finals_ is sorted, so are the patterns they belong to
+        for (size_t i = 0; i < finals_.size(); i++)
+        {
+            size_t pattern = static_cast<size_t>(
+                    std::upper_bound(offsets_.begin(), offsets_.end(), finals_[i]) - offsets_.begin()) - 1;
+            if (matches.empty() || matches.back() != pattern)
+                matches.push_back(pattern);
+        }
+        return true;
+    }
+
+    std::vector<size_t> RegexSet::match(std::string_view str) {
+        std::vector<size_t> matches;
+        match(str.data(), str.data() + str.size(), matches);
+        return matches;
+    }
+
+    bool RegexSet::match_any(std::string_view str) {
+        return program_ && dfa_.match(str.data(), str.data() + str.size());
+    }
+
+    size_t RegexSet::size() const {
+        return offsets_.size() - 1;
+    }
+
+    std::shared_ptr<const Automata::Program> RegexSet::program() const {
+        return program_;
+    }
+
+    void RegexSet::build(std::vector<std::shared_ptr<const CompiledPattern> > const &patterns,
+                         size_t dfa_memory_budget) {
+        std::vector<Automata::Program const*> programs;
+        programs.reserve(patterns.size());
+        for (size_t i = 0; i < patterns.size(); i++)
+            programs.push_back(patterns[i]->program.get());
+
+        program_ = std::make_shared<const Automata::Program>(Automata::Program::unite(programs, offsets_));
+        dfa_ = Automata::LazyDFA(program_, dfa_memory_budget);
+    }
+}
@@ -0,0 +1,127 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file RegexSet.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the class RegexSet
+ *
+ * # Description
+ * This file contains the class which matches a string against many patterns at once.
+ *
+ */
+//</editor-fold>
+#ifndef MYREGEX_REGEXSET_H
+#define MYREGEX_REGEXSET_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../Automata/Program.h"
+#include "../Automata/LazyDFA.h"
+#include "PatternCache.h"
+
+namespace Regex {
+
+    /**
+     * @class RegexSet
+     * @author Carlos Brito (carlos.brito524@gmail.com)
+     * @date 10/14/26.
+     *
+     * @brief Matches a string against many patterns in a single pass
+     *
+     * # Description
+     * The programs of the patterns are united into a single one (see Automata::Program::unite()), whose
+     * final states each belong to one pattern. A lazy DFA of the union runs over the string once, and
+     * the final states of the NFA it ends in tell which patterns match. So matching costs about the same
+     * whatever the number of patterns, once the cache of the DFA is warm.
+     *
+     * Patterns are identified by their index in the vector they were given in. As with Regex::match(), a
+     * pattern matches if it matches the whole string.
+     *
+     * match() uses the DFA of the set, so it must not be called from two threads at the same time.
+     */
+    class RegexSet {
+    public:
+        /// Constructs an empty set, which matches nothing
+        RegexSet();
+
+        /**
+         * @brief Compiles the patterns into a set
+         * @param patterns Regular expressions
+         * @param dfa_memory_budget Memory budget of the DFA state cache
+         * @throws InvalidRegexError if a pattern is invalid
+         */
+        explicit RegexSet(std::vector<std::string> const& patterns,
+                          size_t dfa_memory_budget = Automata::LazyDFA::default_memory_budget);
+
+        /**
+         * @brief Makes a set of patterns compiled beforehand, for example loaded by PatternFile::load()
+         * @param patterns Compiled patterns
+         * @param dfa_memory_budget Memory budget of the DFA state cache
+         */
+        explicit RegexSet(std::vector<std::shared_ptr<const CompiledPattern> > const& patterns,
+                          size_t dfa_memory_budget = Automata::LazyDFA::default_memory_budget);
+
+        /**
+         * @brief Finds every pattern which matches a string
+         * @param first Pointer to the first byte
+         * @param last Pointer past the last byte
+         * @param matches Set to the indices of the patterns which match, in increasing order
+         * @return true if any pattern matches, false otherwise
+         */
+        bool match(const char* first, const char* last, std::vector<size_t> &matches);
+
+        /**
+         * @brief Finds every pattern which matches a string. See the overload above.
+         * @return The indices of the patterns which match, in increasing order
+         */
+        std::vector<size_t> match(std::string_view str);
+
+        /// Returns true if any pattern matches the string
+        bool match_any(std::string_view str);
+
+        /// Returns the number of patterns
+        size_t size() const;
+
+        /// Returns the program of the union of the patterns
+        std::shared_ptr<const Automata::Program> program() const;
+
+    private:
+        /// Unites the programs of the patterns
+        void build(std::vector<std::shared_ptr<const CompiledPattern> > const& patterns, size_t dfa_memory_budget);
+
+        std::shared_ptr<const Automata::Program> program_;
+
+        /// Number of the first state of each pattern in program_, plus one past the last state
+        std::vector<Automata::Program::state_id> offsets_;
+
+        Automata::LazyDFA dfa_;
+
+        /// Final NFA states reached by the last match
+        Automata::LazyDFA::nfa_state_set_type finals_;
+    };
+}
+
+#endif //MYREGEX_REGEXSET_H
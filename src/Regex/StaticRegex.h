@@ -0,0 +1,691 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file StaticRegex.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief This header file contains the declarations and definitions of static_regex.
+ *
+ * # Description
+ * static_regex is a pattern known at compile time. It is parsed and turned into a DFA by constant
+ * evaluation, so the tables are part of the binary and a program using it does no work on startup.
+ * Everything lives in this header.
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#ifndef MYREGEX_STATICREGEX_H
+#define MYREGEX_STATICREGEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include "../Automata/AutomataErrors.h"
+#include "RegexErrors.h"
+#include "Syntax.h"
+
+namespace Regex {
+
+    namespace static_detail {
+
+        // the tokens, escape sequences and bracket expressions are read as by the runtime parser
+        using namespace syntax;
+
+        /// Largest number of symbol positions of a pattern, repetitions included
+        static constexpr size_t max_positions = 1024;
+
+        /// Largest number of states of the DFA of a pattern, the dead state included
+        static constexpr size_t max_states = 512;
+
+        /// Index of no node
+        static constexpr size_t no_node = static_cast<size_t>(-1);
+
+        enum node_kind {
+            NODE_SYMBOL,
+            NODE_CONCAT,
+            NODE_ALTER,
+            NODE_KLEENE,
+            NODE_PLUS,
+            NODE_OPTIONAL,
+            NODE_REPEAT
+        };
+
+        /**
+         * @brief A node of the syntax tree of a pattern
+         *
+         * The operands of a concatenation or an alternation are a list which starts at `child` and is
+         * linked by `next`, so that neither a long string nor many alternatives make a deep tree.
+         */
+        struct node {
+            node_kind kind = NODE_SYMBOL;
+            size_t child = no_node;
+            size_t next = no_node;
+            size_t min = 0;
+            size_t max = 0;
+            byte_set symbols;
+        };
+
+        /// The syntax tree of a pattern, with room for Capacity nodes
+        template <size_t Capacity>
+        struct syntax_tree {
+            node nodes[Capacity] = {};
+            size_t count = 0;
+            size_t root = no_node;
+        };
+
+        /// Returns an upper bound of the number of nodes of the tree of a pattern of the given length
+        constexpr size_t node_capacity(size_t size) {
+            return 2 * size + 1;
+        }
+
+        /**
+         * @class parser
+         * @brief Recursive descent parser of a pattern into a syntax_tree
+         *
+         * It accepts the same language as Parser: every token is a symbol, a parenthesized expression
+         * or a postfix operator, and at most one operator follows each operand.
+         */
+        template <size_t Capacity>
+        class parser {
+        public:
+            constexpr parser(const char* pattern, size_t size)
+                    : pattern_(pattern),
+                      size_(size),
+                      cursor_(0),
+                      lookahead_(),
+                      tree_()
+            {
+                consume();
+            }
+
+            /**
+             * @brief Parses the pattern
+             * @throws ParserError if the pattern is malformed
+             */
+            constexpr syntax_tree<Capacity> parse() {
+                tree_.root = E();
+                if (lookahead_.tag != TOKEN_EOF) // unbalanced right parentheses
+                    throw ParserError();
+                return tree_;
+            }
+
+        private:
+            const char* pattern_;
+            size_t size_;
+            size_t cursor_;
+            token lookahead_;
+            syntax_tree<Capacity> tree_;
+
+            constexpr void consume() {
+                do
+                {
+                    lookahead_ = next_token(pattern_, size_, cursor_);
+                } while (lookahead_.tag == TOKEN_SPACE); // ignore whitespace
+            }
+
+            constexpr bool atSymbol() const {
+                return lookahead_.tag == TOKEN_CHAR ||
+                       lookahead_.tag == TOKEN_ESCAPE_SEQUENCE ||
+                       lookahead_.tag == TOKEN_CLASS ||
+                       lookahead_.tag == TOKEN_DOT;
+            }
+
+            constexpr size_t add(node_kind kind, size_t child) {
+                node& n = tree_.nodes[tree_.count];
+                n.kind = kind;
+                n.child = child;
+                return tree_.count++;
+            }
+
+            /// Alternation of terms
+            constexpr size_t E() {
+                size_t first = T();
+                if (lookahead_.tag != TOKEN_ALTER)
+                    return first;
+
+                size_t alternation = add(NODE_ALTER, first);
+                size_t last = first;
+                while (lookahead_.tag == TOKEN_ALTER)
+                {
+                    consume();
+                    last = tree_.nodes[last].next = T();
+                }
+                return alternation;
+            }
+
+            /// Concatenation of factors
+            constexpr size_t T() {
+                size_t first = F();
+                size_t result = first;
+                size_t last = first;
+                while (lookahead_.tag == TOKEN_LPAREN || atSymbol())
+                {
+                    if (result == first)
+                        result = add(NODE_CONCAT, first);
+                    last = tree_.nodes[last].next = F();
+                }
+
+                if (lookahead_.tag != TOKEN_ALTER &&
+                    lookahead_.tag != TOKEN_EOF &&
+                    lookahead_.tag != TOKEN_RPAREN)
+                    throw ParserError();
+                return result;
+            }
+
+            /// A primary expression and its postfix operator if any
+            constexpr size_t F() {
+                size_t primary = P();
+                switch (lookahead_.tag)
+                {
+                    case TOKEN_KLEENE: consume(); return add(NODE_KLEENE, primary);
+                    case TOKEN_PLUS: consume(); return add(NODE_PLUS, primary);
+                    case TOKEN_QMARK: consume(); return add(NODE_OPTIONAL, primary);
+                    case TOKEN_REPEAT:
+                    {
+                        size_t repetition = add(NODE_REPEAT, primary);
+                        repeat(tree_.nodes[repetition]);
+                        consume();
+                        return repetition;
+                    }
+                    default: return primary;
+                }
+            }
+
+            /// Parenthesized expression or symbol
+            constexpr size_t P() {
+                if (lookahead_.tag == TOKEN_LPAREN)
+                {
+                    consume(); // consume l paren
+                    size_t expression = E();
+
+                    if (lookahead_.tag != TOKEN_RPAREN)
+                        throw ParserError();
+                    consume(); // consume r paren
+                    return expression;
+                }
+                if (!atSymbol())
+                    throw ParserError();
+
+                size_t symbol = add(NODE_SYMBOL, no_node);
+                byte_set& symbols = tree_.nodes[symbol].symbols;
+                if (lookahead_.tag == TOKEN_DOT)
+                    symbols = any();
+                else if (lookahead_.tag == TOKEN_CLASS)
+                    symbols = bracket(pattern_, lookahead_.begin, lookahead_.end);
+                else if (lookahead_.tag == TOKEN_ESCAPE_SEQUENCE)
+                {
+                    size_t i = lookahead_.begin;
+                    bool single = true;
+                    symbols = escape(pattern_, i, lookahead_.end, single);
+                }
+                else
+                    symbols.add(static_cast<unsigned char>(pattern_[lookahead_.begin]));
+
+                consume();
+                return symbol;
+            }
+
+            /// Reads the counts of the repetition token into a node
+            constexpr void repeat(node& n) const {
+                repetition(pattern_ + lookahead_.begin, n.min, n.max);
+            }
+        };
+
+        /**
+         * @brief Returns the number of symbol positions of a subtree, each copy of a repeated operand counted
+         * @throws Automata::TooManyStatesError if there are more than max_positions
+         */
+        template <size_t Capacity>
+        constexpr size_t position_count(syntax_tree<Capacity> const& tree, size_t index) {
+            node const& n = tree.nodes[index];
+            size_t result = 0;
+            switch (n.kind)
+            {
+                case NODE_SYMBOL:
+                    result = 1;
+                    break;
+                case NODE_CONCAT:
+                case NODE_ALTER:
+                    for (size_t child = n.child; child != no_node; child = tree.nodes[child].next)
+                        result += position_count(tree, child);
+                    break;
+                case NODE_REPEAT:
+                {
+                    size_t copies = n.max == unbounded ? (n.min > 0 ? n.min : 1) : n.max;
+                    result = copies * position_count(tree, n.child);
+                    break;
+                }
+                default:
+                    result = position_count(tree, n.child);
+                    break;
+            }
+
+            if (result > max_positions)
+                throw Automata::TooManyStatesError(max_positions);
+            return result;
+        }
+
+        /// A set of positions in \f$ [0, Size) \f$
+        template <size_t Size>
+        struct position_set {
+            static constexpr size_t word_count = Size / 64 + 1;
+
+            uint64_t words[word_count] = {};
+
+            constexpr void insert(size_t p) {
+                words[p >> 6] |= uint64_t(1) << (p & 63);
+            }
+
+            constexpr bool contains(size_t p) const {
+                return (words[p >> 6] >> (p & 63)) & 1;
+            }
+
+            constexpr void add(position_set const& other) {
+                for (size_t i = 0; i < word_count; i++)
+                    words[i] |= other.words[i];
+            }
+
+            constexpr bool intersects(position_set const& other) const {
+                for (size_t i = 0; i < word_count; i++)
+                    if (words[i] & other.words[i])
+                        return true;
+                return false;
+            }
+
+            constexpr position_set intersection(position_set const& other) const {
+                position_set result;
+                for (size_t i = 0; i < word_count; i++)
+                    result.words[i] = words[i] & other.words[i];
+                return result;
+            }
+
+            constexpr size_t hash() const {
+                uint64_t result = 0;
+                for (size_t i = 0; i < word_count; i++)
+                    result = (result ^ words[i]) * 0x9E3779B97F4A7C15ull;
+                return static_cast<size_t>(result ^ (result >> 32));
+            }
+
+            constexpr bool operator==(position_set const& other) const {
+                for (size_t i = 0; i < word_count; i++)
+                    if (words[i] != other.words[i])
+                        return false;
+                return true;
+            }
+        };
+
+        /**
+         * @class glushkov
+         * @brief The Glushkov automaton of a syntax tree
+         *
+         * Position 0 is the initial state and every other position is an occurrence of a symbol, so the
+         * automaton has no epsilon transitions. A copy of a repeated operand has positions of its own.
+         */
+        template <size_t Capacity, size_t Size>
+        class glushkov {
+        public:
+            /// Bytes matched by each position
+            byte_set symbols[Size] = {};
+
+            /// Positions which may follow each position
+            position_set<Size> follow[Size] = {};
+
+            /// Positions in which a match may end
+            position_set<Size> accepting;
+
+            constexpr explicit glushkov(syntax_tree<Capacity> const& tree)
+                    : tree_(tree),
+                      count_(1)
+            {
+                fragment root = build(tree.root);
+                follow[0] = root.first;
+                accepting = root.last;
+                if (root.nullable)
+                    accepting.insert(0);
+            }
+
+        private:
+            struct fragment {
+                bool nullable = true;
+                position_set<Size> first;
+                position_set<Size> last;
+            };
+
+            syntax_tree<Capacity> const& tree_;
+            size_t count_;
+
+            constexpr fragment build(size_t index) {
+                node const& n = tree_.nodes[index];
+                fragment result;
+                switch (n.kind)
+                {
+                    case NODE_SYMBOL:
+                    {
+                        size_t p = count_++;
+                        symbols[p] = n.symbols;
+                        result.nullable = false;
+                        result.first.insert(p);
+                        result.last.insert(p);
+                        return result;
+                    }
+                    case NODE_CONCAT:
+                        for (size_t child = n.child; child != no_node; child = tree_.nodes[child].next)
+                            result = concatenate(result, build(child));
+                        return result;
+                    case NODE_ALTER:
+                        result = build(n.child);
+                        for (size_t child = tree_.nodes[n.child].next; child != no_node; child = tree_.nodes[child].next)
+                        {
+                            fragment right = build(child);
+                            result.nullable = result.nullable || right.nullable;
+                            result.first.add(right.first);
+                            result.last.add(right.last);
+                        }
+                        return result;
+                    case NODE_KLEENE:
+                        result = build(n.child);
+                        loop(result);
+                        result.nullable = true;
+                        return result;
+                    case NODE_PLUS:
+                        result = build(n.child);
+                        loop(result);
+                        return result;
+                    case NODE_OPTIONAL:
+                        result = build(n.child);
+                        result.nullable = true;
+                        return result;
+                    case NODE_REPEAT:
+                        return repeat(n);
+                }
+                return result;
+            }
+
+            /// Makes `a{m,n}` as `a` m times followed by `(a(a...)?)?`, and `a{m,}` as `a` m - 1 times and `a+`
+            constexpr fragment repeat(node const& n) {
+                fragment result;
+                if (n.max == unbounded)
+                {
+                    for (size_t i = 1; i < n.min; i++)
+                        result = concatenate(result, build(n.child));
+
+                    fragment last = build(n.child);
+                    loop(last);
+                    if (n.min == 0)
+                        last.nullable = true;
+                    return concatenate(result, last);
+                }
+
+                for (size_t i = 0; i < n.min; i++)
+                    result = concatenate(result, build(n.child));
+
+                fragment optional;
+                for (size_t i = n.min; i < n.max; i++)
+                {
+                    optional = concatenate(build(n.child), optional);
+                    optional.nullable = true;
+                }
+                return concatenate(result, optional);
+            }
+
+            constexpr fragment concatenate(fragment const& left, fragment const& right) {
+                for (size_t p = 0; p < count_; p++)
+                    if (left.last.contains(p))
+                        follow[p].add(right.first);
+
+                fragment result;
+                result.nullable = left.nullable && right.nullable;
+                result.first = left.first;
+                if (left.nullable)
+                    result.first.add(right.first);
+                result.last = right.last;
+                if (right.nullable)
+                    result.last.add(left.last);
+                return result;
+            }
+
+            constexpr void loop(fragment const& a) {
+                for (size_t p = 0; p < count_; p++)
+                    if (a.last.contains(p))
+                        follow[p].add(a.first);
+            }
+        };
+
+        /// Number of states and of byte classes of the DFA of a pattern
+        struct dfa_size {
+            size_t states = 0;
+            size_t classes = 0;
+        };
+
+        /**
+         * @class dense_table
+         * @brief Transition table of the DFA of a static_regex
+         *
+         * Bytes which no position tells apart share a class, and a row has one entry per class. States are
+         * stored as the offset of their row, so a step is a single load. State 0 is the dead state and
+         * state 1 the initial one.
+         */
+        template <size_t States, size_t Classes>
+        struct dense_table {
+            typedef typename std::conditional<States * Classes <= 0x10000, uint16_t, uint32_t>::type state_type;
+
+            static constexpr state_type dead = 0;
+            static constexpr state_type initial = Classes;
+
+            unsigned char classes[256] = {};
+            state_type next[States * Classes] = {};
+            bool accepting[States] = {};
+
+            constexpr bool isAccepting(state_type s) const {
+                return accepting[s / Classes];
+            }
+        };
+
+        /**
+         * @class subset_builder
+         * @brief Subset construction of the DFA of a Glushkov automaton, with room for max_states states
+         */
+        template <size_t Capacity, size_t Size>
+        class subset_builder {
+        public:
+            /**
+             * @brief Builds the DFA of a syntax tree
+             * @throws Automata::TooManyStatesError if the DFA has more than max_states states
+             */
+            constexpr explicit subset_builder(syntax_tree<Capacity> const& tree)
+                    : class_count_(0),
+                      state_count_(2)
+            {
+                glushkov<Capacity, Size> automaton(tree);
+
+                // bytes which are matched by the same positions make a class
+                for (unsigned c = 0; c < 256; c++)
+                {
+                    position_set<Size> positions;
+                    for (size_t p = 1; p < Size; p++)
+                        if (automaton.symbols[p].contains(c))
+                            positions.insert(p);
+
+                    size_t k = 0;
+                    while (k < class_count_ && !(class_positions_[k] == positions))
+                        k++;
+                    if (k == class_count_)
+                        class_positions_[class_count_++] = positions;
+                    classes_[c] = static_cast<unsigned char>(k);
+                }
+
+                // state 0 is the empty set of positions and state 1 the initial position
+                states_[1].insert(0);
+                index_[find(states_[0])] = 1;
+                index_[find(states_[1])] = 2;
+                for (size_t s = 1; s < state_count_; s++)
+                {
+                    accepting_[s] = states_[s].intersects(automaton.accepting);
+
+                    position_set<Size> reachable;
+                    for (size_t p = 0; p < Size; p++)
+                        if (states_[s].contains(p))
+                            reachable.add(automaton.follow[p]);
+
+                    for (size_t k = 0; k < class_count_; k++)
+                    {
+                        position_set<Size> target = reachable.intersection(class_positions_[k]);
+
+                        size_t slot = find(target);
+                        if (index_[slot] == 0)
+                        {
+                            if (state_count_ == max_states)
+                                throw Automata::TooManyStatesError(max_states);
+                            states_[state_count_++] = target;
+                            index_[slot] = static_cast<uint16_t>(state_count_);
+                        }
+                        next_[s][k] = static_cast<uint16_t>(index_[slot] - 1);
+                    }
+                }
+            }
+
+            constexpr dfa_size size() const {
+                return dfa_size{state_count_, class_count_};
+            }
+
+            /// Copies the DFA into a table, whose size must be size()
+            template <size_t States, size_t Classes>
+            constexpr dense_table<States, Classes> table() const {
+                typedef typename dense_table<States, Classes>::state_type state_type;
+
+                dense_table<States, Classes> result;
+                for (size_t c = 0; c < 256; c++)
+                    result.classes[c] = classes_[c];
+
+                for (size_t s = 0; s < States; s++)
+                {
+                    result.accepting[s] = accepting_[s];
+                    for (size_t k = 0; k < Classes; k++)
+                        result.next[s * Classes + k] = static_cast<state_type>(next_[s][k] * Classes);
+                }
+                return result;
+            }
+
+        private:
+            static constexpr size_t index_size = 2 * max_states;
+
+            /// Returns the slot of a set of positions in the index, or the empty slot it would take
+            constexpr size_t find(position_set<Size> const& positions) const {
+                size_t slot = positions.hash() & (index_size - 1);
+                while (index_[slot] != 0 && !(states_[index_[slot] - 1] == positions))
+                    slot = (slot + 1) & (index_size - 1);
+                return slot;
+            }
+
+            unsigned char classes_[256] = {};
+            position_set<Size> class_positions_[256] = {};
+            size_t class_count_;
+
+            position_set<Size> states_[max_states] = {};
+            bool accepting_[max_states] = {};
+            uint16_t next_[max_states][256] = {};
+            size_t state_count_;
+
+            /// Open addressing table of the states by set of positions, a slot holds the state plus one
+            uint16_t index_[index_size] = {};
+        };
+
+        constexpr size_t length(const char* str) {
+            size_t size = 0;
+            while (str[size] != '\0')
+                size++;
+            return size;
+        }
+    }
+
+    /**
+     * @class static_regex
+     * @brief A pattern known at compile time
+     *
+     * # Description
+     * The pattern is parsed and compiled into a DFA by constant evaluation, so its tables are constant data
+     * of the binary: nothing is allocated or built at startup, there is no static initialization order to
+     * worry about, and match() is a loop over a table which the compiler sees whole and may inline. A
+     * malformed pattern, or one whose DFA has more than static_detail::max_states states, doesn't compile.
+     *
+     * The syntax and the meaning of a pattern are those of Regex. A template argument can't be a string
+     * literal in C++17, so the pattern is given as an array of static storage duration:
+     *
+     *     static constexpr char identifier[] = "[a-zA-Z_]\\w*";
+     *     bool ok = static_regex<identifier>::match(str);
+     *
+     * match() is constexpr as well, so it can be used in a `static_assert`.
+     *
+     * @tparam Pattern Null terminated pattern
+     */
+    template <const char* Pattern>
+    class static_regex {
+        static constexpr size_t capacity_ = static_detail::node_capacity(static_detail::length(Pattern));
+
+        static constexpr static_detail::syntax_tree<capacity_> tree_ =
+                static_detail::parser<capacity_>(Pattern, static_detail::length(Pattern)).parse();
+
+        static constexpr size_t positions_ = static_detail::position_count(tree_, tree_.root) + 1;
+
+        static constexpr static_detail::dfa_size size_ =
+                static_detail::subset_builder<capacity_, positions_>(tree_).size();
+
+        typedef static_detail::dense_table<size_.states, size_.classes> table_type;
+
+        static constexpr table_type table_ =
+                static_detail::subset_builder<capacity_, positions_>(tree_).template table<size_.states, size_.classes>();
+
+    public:
+        /// Returns true if the whole string matches the pattern
+        static constexpr bool match(std::string_view str) {
+            typename table_type::state_type s = table_type::initial;
+            for (char c : str)
+            {
+                s = table_.next[s + table_.classes[static_cast<unsigned char>(c)]];
+                if (s == table_type::dead)
+                    return false;
+            }
+            return table_.isAccepting(s);
+        }
+
+        /// Returns the pattern
+        static constexpr const char* pattern() {
+            return Pattern;
+        }
+
+        /// Returns the number of states of the DFA, the dead state included
+        static constexpr size_t state_count() {
+            return size_.states;
+        }
+
+        /// Returns the number of classes of bytes the DFA tells apart
+        static constexpr size_t class_count() {
+            return size_.classes;
+        }
+    };
+}
+
+#endif //MYREGEX_STATICREGEX_H
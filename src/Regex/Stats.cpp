@@ -0,0 +1,114 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file Stats.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Implementation file for the struct Stats
+ *
+ */
+//</editor-fold>
+#include <sstream>
+
+#include "Stats.h"
+
+namespace Regex {
+
+    namespace {
+        /// Escapes a label value of the Prometheus text format
+        std::string escape_label(std::string const& value) {
+            std::string result;
+            result.reserve(value.size());
+            for (size_t i = 0; i < value.size(); i++)
+            {
+                if (value[i] == '\\' || value[i] == '"')
+                    result += '\\';
+                if (value[i] == '\n')
+                    result += "\\n";
+                else
+                    result += value[i];
+            }
+            return result;
+        }
+
+        template <typename T>
+        void write_metric(std::ostringstream& os, std::string const& name, const char* type, const char* help,
+                          std::string const& labels, T value) {
+            os << "# HELP " << name << " " << help << "\n";
+            os << "# TYPE " << name << " " << type << "\n";
+            os << name << labels << " " << value << "\n";
+        }
+    }
+
+    Stats::Stats()
+            : counters_enabled(false),
+              compile_seconds(0),
+              nfa_states(0),
+              nfa_transitions(0),
+              nfa_epsilon_transitions(0),
+              dfa_states(0),
+              dfa_memory(0),
+              dfa_flushes(0),
+              dfa_fallbacks(0),
+              cache_hits(0),
+              cache_misses(0),
+              bytes_scanned(0),
+              active_states(0)
+    {}
+
+    double Stats::average_active_states() const {
+        return bytes_scanned == 0 ? 0.0 : static_cast<double>(active_states) / static_cast<double>(bytes_scanned);
+    }
+
+    std::string Stats::prometheus(std::string const &prefix) const {
+        std::ostringstream os;
+        std::string labels = "{pattern=\"" + escape_label(pattern) + "\"}";
+
+        write_metric(os, prefix + "_compile_seconds", "gauge", "Time it took to compile the pattern.",
+                     labels, compile_seconds);
+        write_metric(os, prefix + "_nfa_states", "gauge", "Number of states of the NFA.", labels, nfa_states);
+        write_metric(os, prefix + "_nfa_transitions", "gauge", "Number of transitions on symbols of the NFA.",
+                     labels, nfa_transitions);
+        write_metric(os, prefix + "_nfa_epsilon_transitions", "gauge", "Number of epsilon transitions of the NFA.",
+                     labels, nfa_epsilon_transitions);
+        write_metric(os, prefix + "_dfa_states", "gauge", "Number of states of the DFA.", labels, dfa_states);
+        write_metric(os, prefix + "_dfa_memory_bytes", "gauge", "Bytes used by the DFA.", labels, dfa_memory);
+        write_metric(os, prefix + "_dfa_flushes_total", "counter", "Flushes of the DFA cache.",
+                     labels, dfa_flushes);
+        write_metric(os, prefix + "_dfa_fallbacks_total", "counter", "Fallbacks to the NFA when the DFA cache thrashed.",
+                     labels, dfa_fallbacks);
+
+        if (counters_enabled)
+        {
+            write_metric(os, prefix + "_dfa_cache_hits_total", "counter", "Transitions found in the DFA cache.",
+                         labels, cache_hits);
+            write_metric(os, prefix + "_dfa_cache_misses_total", "counter", "Transitions computed for the DFA cache.",
+                         labels, cache_misses);
+            write_metric(os, prefix + "_bytes_scanned_total", "counter", "Bytes run through the automata.",
+                         labels, bytes_scanned);
+            write_metric(os, prefix + "_active_states_average", "gauge", "Average number of active NFA states per byte.",
+                         labels, average_active_states());
+        }
+
+        return os.str();
+    }
+}
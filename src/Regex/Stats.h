@@ -0,0 +1,116 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file Stats.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the struct Stats
+ *
+ * # Description
+ * This file contains the statistics a Regex reports about its pattern and about the matching done so far.
+ *
+ */
+//</editor-fold>
+#ifndef MYREGEX_STATS_H
+#define MYREGEX_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Regex {
+
+    /**
+     * @struct Stats
+     * @author Carlos Brito (carlos.brito524@gmail.com)
+     * @date 10/14/26.
+     *
+     * @brief Statistics of a pattern and of the matching done with it
+     *
+     * # Description
+     * The sizes of the automata, the state of the DFA cache and its flushes are always reported. The counters
+     * of the hot path (cache hits and misses, bytes scanned and active states) are only updated if the project
+     * is built with MYREGEX_ENABLE_STATS, see Automata::MatchStats, otherwise they are zero.
+     *
+     * The average number of active states per byte tells how hard the simulation works: it stays close to 1
+     * for a DFA, and a pattern whose lazy DFA has a high average and many misses and flushes is blowing up the
+     * subset construction.
+     */
+    struct Stats {
+        /// Whether the counters of the hot path are updated
+        bool counters_enabled;
+
+        /// Regular expression
+        std::string pattern;
+
+        /// Time it took to compile the pattern, 0 if it was loaded from a PatternFile
+        double compile_seconds;
+
+        /// Number of states of the compiled NFA
+        size_t nfa_states;
+
+        /// Number of transitions on a range of symbols of the compiled NFA
+        size_t nfa_transitions;
+
+        /// Number of epsilon transitions of the compiled NFA
+        size_t nfa_epsilon_transitions;
+
+        /// Number of states of the DFA, currently in the cache of the lazy DFA or of the dense DFA
+        size_t dfa_states;
+
+        /// Bytes used by the DFA
+        size_t dfa_memory;
+
+        /// Number of times the cache of the lazy DFA was flushed
+        size_t dfa_flushes;
+
+        /// Number of times the lazy DFA fell back to simulating the NFA because its cache thrashed
+        size_t dfa_fallbacks;
+
+        /// Transitions found in the cache of the lazy DFA
+        uint64_t cache_hits;
+
+        /// Transitions of the lazy DFA which had to be computed
+        uint64_t cache_misses;
+
+        /// Bytes run through the automata
+        uint64_t bytes_scanned;
+
+        /// Sum over the bytes scanned of the number of NFA states active at that byte
+        uint64_t active_states;
+
+        /// Constructs statistics which are all zero
+        Stats();
+
+        /// Returns the average number of active NFA states per byte scanned
+        double average_active_states() const;
+
+        /// Returns the statistics in the Prometheus text format, labeled with the pattern
+        /**
+         * @param prefix Prefix of the name of every metric
+         * @return One sample per statistic, each preceded by its HELP and TYPE lines
+         */
+        std::string prometheus(std::string const& prefix = "myregex") const;
+    };
+}
+
+#endif //MYREGEX_STATS_H
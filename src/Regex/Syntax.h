@@ -0,0 +1,404 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file Syntax.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief This header file contains the lexical rules of the patterns.
+ *
+ * # Description
+ * How a pattern is cut into tokens, and which bytes an escape sequence or a bracket expression stands for,
+ * written once as constexpr functions. Lexer, CharClass and Parser call them at runtime and static_regex
+ * during constant evaluation, so both accept the same patterns.
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#ifndef MYREGEX_SYNTAX_H
+#define MYREGEX_SYNTAX_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "RegexErrors.h"
+
+namespace Regex {
+
+    namespace syntax {
+
+        /// Largest count of a bounded repetition
+        static constexpr size_t max_repeat = 1000;
+
+        /// Largest number of states of the automaton of a pattern once its repetitions are spelled out
+        /**
+         * Repetitions multiply: every count is at most max_repeat, but `(a{1000}){1000}` would still take a million
+         * states. A pattern whose repetitions make more than max_states states is rejected before they are copied, as
+         * RE2 does with its memory budget, so it costs no more to refuse than to parse.
+         */
+        static constexpr size_t max_states = 1 << 16;
+
+        /// Count of a repetition without an upper bound, like `{m,}`
+        static constexpr size_t unbounded = static_cast<size_t>(-1);
+
+        /// A set of bytes, the symbols matched by a character, an escape sequence, a bracket expression or the dot
+        struct byte_set {
+            uint64_t words[4] = {};
+
+            constexpr void add(unsigned c) {
+                words[c >> 6] |= uint64_t(1) << (c & 63);
+            }
+
+            constexpr void add(unsigned first, unsigned last) {
+                for (unsigned c = first; c <= last; c++)
+                    add(c);
+            }
+
+            constexpr void add(byte_set const& other) {
+                for (size_t i = 0; i < 4; i++)
+                    words[i] |= other.words[i];
+            }
+
+            constexpr void negate() {
+                for (size_t i = 0; i < 4; i++)
+                    words[i] = ~words[i];
+            }
+
+            constexpr bool contains(unsigned c) const {
+                return (words[c >> 6] >> (c & 63)) & 1;
+            }
+
+            /// Returns the smallest byte of the set
+            constexpr unsigned front() const {
+                unsigned c = 0;
+                while (c < 256 && !contains(c))
+                    c++;
+                return c;
+            }
+        };
+
+        constexpr byte_set digit() {
+            byte_set result;
+            result.add('0', '9');
+            return result;
+        }
+
+        constexpr byte_set word() {
+            byte_set result;
+            result.add('a', 'z');
+            result.add('A', 'Z');
+            result.add('0', '9');
+            result.add('_');
+            return result;
+        }
+
+        constexpr byte_set space() {
+            byte_set result;
+            result.add(' ');
+            result.add('\t', '\r'); // \t \n \v \f \r
+            return result;
+        }
+
+        constexpr byte_set any() {
+            byte_set result;
+            result.negate();
+            result.words['\n' >> 6] &= ~(uint64_t(1) << ('\n' & 63));
+            return result;
+        }
+
+        constexpr int hex_value(char c) {
+            if (c >= '0' && c <= '9')
+                return c - '0';
+            if (c >= 'a' && c <= 'f')
+                return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F')
+                return c - 'A' + 10;
+            return -1;
+        }
+
+        constexpr bool is_digit(char c) {
+            return c >= '0' && c <= '9';
+        }
+
+        constexpr bool is_alnum(char c) {
+            return is_digit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        }
+
+        /**
+         * @brief Reads the escape sequence at `pattern[i]`
+         * @param pattern Pattern
+         * @param i Index of the backslash, it is moved past the sequence
+         * @param end End of the token the sequence is part of
+         * @param single Set to `true` if the sequence is a single byte, `false` if it is a class like `\d`
+         * @return Bytes matched by the sequence
+         * @throws ParserError if the sequence is malformed or reserved
+         */
+        constexpr byte_set escape(const char* pattern, size_t& i, size_t end, bool& single) {
+            if (i + 1 >= end || pattern[i] != '\\')
+                throw ParserError();
+
+            char c = pattern[i + 1];
+            i += 2;
+            single = false;
+
+            byte_set result;
+            switch (c)
+            {
+                case 'd': return digit();
+                case 'w': return word();
+                case 's': return space();
+                case 'D': result = digit(); result.negate(); return result;
+                case 'W': result = word(); result.negate(); return result;
+                case 'S': result = space(); result.negate(); return result;
+                default: break;
+            }
+
+            single = true;
+            switch (c)
+            {
+                case 'n': result.add('\n'); return result;
+                case 'r': result.add('\r'); return result;
+                case 't': result.add('\t'); return result;
+                case 'f': result.add('\f'); return result;
+                case 'v': result.add('\v'); return result;
+                case 'x':
+                {
+                    int high = i < end ? hex_value(pattern[i]) : -1;
+                    int low = i + 1 < end ? hex_value(pattern[i + 1]) : -1;
+                    if (high < 0 || low < 0)
+                        throw ParserError();
+
+                    i += 2;
+                    result.add(static_cast<unsigned>(high * 16 + low));
+                    return result;
+                }
+                default: break;
+            }
+
+            if (is_alnum(c)) // reserved for escapes to come
+                throw ParserError();
+
+            result.add(static_cast<unsigned char>(c));
+            return result;
+        }
+
+        /**
+         * @brief Reads the bracket expression `pattern[begin, end)`, a token tagged TOKEN_CLASS
+         * @throws ParserError if the expression is empty or a range is malformed
+         */
+        constexpr byte_set bracket(const char* pattern, size_t begin, size_t end) {
+            size_t i = begin + 1;
+            end--; // the closing bracket
+            bool negated = pattern[i] == '^';
+            if (negated)
+                i++;
+            if (i >= end) // nothing between the brackets
+                throw ParserError();
+
+            byte_set result;
+            while (i < end)
+            {
+                // the first item, a single byte or an escaped class
+                byte_set item;
+                bool single = true;
+                if (pattern[i] == '\\')
+                    item = escape(pattern, i, end + 1, single);
+                else
+                    item.add(static_cast<unsigned char>(pattern[i++]));
+
+                // a range, unless the dash is the last character
+                if (single && i + 1 < end && pattern[i] == '-')
+                {
+                    i++;
+                    byte_set last;
+                    bool last_single = true;
+                    if (pattern[i] == '\\')
+                        last = escape(pattern, i, end + 1, last_single);
+                    else
+                        last.add(static_cast<unsigned char>(pattern[i++]));
+
+                    if (!last_single || last.front() < item.front())
+                        throw ParserError();
+
+                    result.add(item.front(), last.front());
+                    continue;
+                }
+
+                result.add(item);
+            }
+
+            if (negated)
+                result.negate();
+
+            return result;
+        }
+
+        enum token_tag {
+            TOKEN_EOF,
+            TOKEN_NONE,
+            TOKEN_LPAREN,
+            TOKEN_RPAREN,
+            TOKEN_KLEENE,
+            TOKEN_ALTER,
+            TOKEN_QMARK,
+            TOKEN_PLUS,
+            TOKEN_CHAR,
+            TOKEN_SPACE,
+            TOKEN_ESCAPE_SEQUENCE,
+            TOKEN_CLASS,
+            TOKEN_DOT,
+            TOKEN_REPEAT
+        };
+
+        /// A token of a pattern, its lexeme is `pattern[begin, end)`
+        struct token {
+            token_tag tag = TOKEN_NONE;
+            size_t begin = 0;
+            size_t end = 0;
+        };
+
+        /**
+         * @brief Returns the token at `pattern[cursor]` and moves the cursor past it. See Lexer.
+         *
+         * A backslash at the end of the pattern, an unterminated bracket expression and a byte which isn't
+         * printable are tagged TOKEN_NONE.
+         */
+        constexpr token next_token(const char* pattern, size_t size, size_t& cursor) {
+            if (cursor >= size)
+                return token{TOKEN_EOF, size, size};
+
+            size_t begin = cursor;
+            unsigned char c = static_cast<unsigned char>(pattern[cursor++]);
+            switch (c)
+            {
+                case ' ': return token{TOKEN_SPACE, begin, cursor};
+                case '*': return token{TOKEN_KLEENE, begin, cursor};
+                case '|': return token{TOKEN_ALTER, begin, cursor};
+                case '(': return token{TOKEN_LPAREN, begin, cursor};
+                case ')': return token{TOKEN_RPAREN, begin, cursor};
+                case '?': return token{TOKEN_QMARK, begin, cursor};
+                case '+': return token{TOKEN_PLUS, begin, cursor};
+                case '.': return token{TOKEN_DOT, begin, cursor};
+                case '\\':
+                {
+                    if (cursor >= size) // nothing to escape
+                        return token{TOKEN_NONE, begin, size};
+
+                    size_t length = pattern[cursor] == 'x' ? 4 : 2;
+                    if (begin + length > size)
+                    {
+                        cursor = size;
+                        return token{TOKEN_NONE, begin, size};
+                    }
+
+                    cursor = begin + length;
+                    return token{TOKEN_ESCAPE_SEQUENCE, begin, cursor};
+                }
+                case '[':
+                {
+                    size_t it = cursor;
+                    if (it < size && pattern[it] == '^')
+                        it++;
+                    if (it < size && pattern[it] == ']') // a leading bracket is a character
+                        it++;
+
+                    for (; it < size && pattern[it] != ']'; it++)
+                        if (pattern[it] == '\\')
+                            it++;
+
+                    if (it >= size) // unterminated
+                    {
+                        cursor = size;
+                        return token{TOKEN_NONE, begin, size};
+                    }
+
+                    cursor = it + 1;
+                    return token{TOKEN_CLASS, begin, cursor};
+                }
+                case '{':
+                {
+                    size_t it = cursor;
+                    while (it < size && is_digit(pattern[it]))
+                        it++;
+                    bool bounded = it > cursor;
+
+                    if (bounded && it < size && pattern[it] == ',')
+                    {
+                        it++;
+                        while (it < size && is_digit(pattern[it]))
+                            it++;
+                    }
+
+                    if (!bounded || it >= size || pattern[it] != '}')
+                        return token{TOKEN_CHAR, begin, cursor};
+
+                    cursor = it + 1;
+                    return token{TOKEN_REPEAT, begin, cursor};
+                }
+                default: break;
+            }
+
+            if (c >= 33 && c <= 126) // ascii characters from '!' to '~'
+                return token{TOKEN_CHAR, begin, cursor};
+            return token{TOKEN_NONE, begin, cursor};
+        }
+
+        /// Reads the count at `lexeme[it]` and moves it past the count
+        constexpr size_t count(const char* lexeme, size_t& it) {
+            size_t result = 0;
+            for (; is_digit(lexeme[it]); it++)
+            {
+                result = result * 10 + static_cast<size_t>(lexeme[it] - '0');
+                if (result > max_repeat)
+                    throw ParserError();
+            }
+            return result;
+        }
+
+        /**
+         * @brief Reads the counts of a repetition token, which the lexer only makes of the form `{m}`, `{m,}` and `{m,n}`
+         * @param lexeme Lexeme of the token, from its opening brace
+         * @param min Set to the least number of occurrences
+         * @param max Set to the largest number of occurrences, unbounded for `{m,}`
+         * @throws ParserError if a count is larger than max_repeat or max is less than min
+         */
+        constexpr void repetition(const char* lexeme, size_t& min, size_t& max) {
+            size_t it = 1;
+            min = count(lexeme, it);
+            if (lexeme[it] == '}')
+                max = min;
+            else if (lexeme[it + 1] == '}')
+                max = unbounded;
+            else
+            {
+                it++;
+                max = count(lexeme, it);
+            }
+
+            if (max < min)
+                throw ParserError();
+        }
+    }
+}
+
+#endif //MYREGEX_SYNTAX_H
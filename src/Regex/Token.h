@@ -66,8 +66,11 @@ namespace Regex {
 
             /**
              * @brief Empty constructor
+             *
+             * The tag is the "no-tag" one (id 0).
              */
             Tag()
+                    : id_(0)
             {}
 
             /**
@@ -171,7 +174,7 @@ namespace Regex {
          * @brief Returns tag of token
          * @return Token tag
          */
-        Tag tag() const {
+        Tag const& tag() const {
             return tag_;
         }
 
@@ -179,7 +182,7 @@ namespace Regex {
          * @brief Returns associated lexeme of token
          * @return Lexeme
          */
-        std::string lexeme() {
+        std::string const& lexeme() const {
             return lexeme_;
         }
 
@@ -187,7 +190,7 @@ namespace Regex {
          * @brief Returns length of lexeme
          * @return Length of lexeme
          */
-        size_t length() {
+        size_t length() const {
             return length_;
         }
 
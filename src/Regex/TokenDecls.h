@@ -64,7 +64,10 @@ enum {
 
     TOK_CHAR,
     TOK_SPACE,
-    TOK_ESCAPE_SEQUENCE
+    TOK_ESCAPE_SEQUENCE,
+    TOK_CLASS,
+    TOK_DOT,
+    TOK_REPEAT
 };
 
 // Declare token tags
@@ -92,6 +95,15 @@ enum {
     /// Tag for an escape sequence.
     static const Regex::Token::Tag TAG_ESCAPE_SEQUENCE(TOK_ESCAPE_SEQUENCE, "escape sequence");
 
+    /// Tag for a bracket expression like [a-z], the lexeme holds the whole expression.
+    static const Regex::Token::Tag TAG_CLASS(TOK_CLASS, "character class");
+
+    /// Tag for a bounded repetition like {2,5}, the lexeme holds the whole bound.
+    static const Regex::Token::Tag TAG_REPEAT(TOK_REPEAT, "bounded repetition");
+
+    /// Tag for the dot, which matches any character but the newline.
+    static const Regex::Token::Tag TAG_DOT(TOK_DOT, "dot");
+
     /// Tag for a character.
     static const Regex::Token::Tag TAG_CHAR(TOK_CHAR, "character");
 
@@ -42,7 +42,8 @@
 #define MYREGEX_SET_H
 
 #include <functional>
-#include "../Hashtable/Hashtable.h"
+#include <utility>
+#include "../Hashtable/FlatHashtable.h"
 
 /** @class Set
 * # Description
@@ -53,15 +54,19 @@
 * - Union -  \f$ O(n + m) \f$
 * - Intersection - \f$ O(n) \f$
 * - Difference - \f$ O(n) \f$
+*
+* The elements are kept in a `flat_hashtable`, which grows as they are inserted, so the bucket count given on
+* construction is only a hint. Inserting an element invalidates the iterators of the set.
 */
 template <
         class Key,
         class Hasher = std::hash<Key>,
-        class KeyEqual = std::equal_to<Key>
+        class KeyEqual = std::equal_to<Key>,
+        class Allocator = std::allocator<std::pair<Key, bool> >
 >
 class Set {
-    typedef Set<Key, Hasher, KeyEqual> self_type;
-    typedef hashtable<Key, Key&, Hasher, KeyEqual> table_type;
+    typedef Set<Key, Hasher, KeyEqual, Allocator> self_type;
+    typedef flat_hashtable<Key, bool, Hasher, KeyEqual, Allocator> table_type;
     typedef typename table_type::iterator hashtable_iterator;
     typedef typename table_type::const_iterator const_hashtable_iterator;
 
@@ -88,6 +93,7 @@ public:
 
         self_type operator++() { // prefix
             hash_it_++;
+            return *this;
         }
 
         self_type operator++(int dummy) { // postfix
@@ -108,9 +114,9 @@ public:
     public:
         typedef const_iterator self_type;
         typedef int difference_type;
-        typedef Key& reference;
+        typedef Key const& reference;
         typedef Key value_type;
-        typedef Key* pointer;
+        typedef Key const* pointer;
 
         const_iterator(const_hashtable_iterator const& hashtable_it)
                 : hash_it_(hashtable_it)
@@ -118,14 +124,15 @@ public:
 
         self_type operator++() { // prefix
             hash_it_++;
+            return *this;
         }
 
         self_type operator++(int dummy) { // postfix
             self_type it = *this; ++(*this); return it;
         }
 
-        const value_type& operator*() { return hash_it_->first; }
-        const pointer operator->() { return &(hash_it_->first); }
+        reference operator*() { return hash_it_->first; }
+        pointer operator->() { return &(hash_it_->first); }
 
         bool operator==(const self_type& rhs) { return hash_it_ == rhs.hash_it_; }
         bool operator!=(const self_type& rhs) { return !(*this == rhs); }
@@ -140,14 +147,22 @@ public:
     {}
 
     Set (size_t bucket_count)
-            : table_( hashtable<Key,Key&,Hasher,KeyEqual>(bucket_count) )
+            : table_( table_type(bucket_count) )
     {}
-//
+
+    /// Constructs an empty set which allocates its memory with the allocator
+    Set (size_t bucket_count, Allocator const& alloc)
+            : table_( table_type(bucket_count, alloc) )
+    {}
+
     Set(const Set& set)
-    {
-        bucket_count_ = set.bucket_count_;
-        table_ = set.table_;
-    }
+            : table_(set.table_)
+    {}
+
+    /// Moves a set, in \f$ O(1) \f$. The moved from set is left empty.
+    Set(Set&& set)
+            : table_(std::move(set.table_))
+    {}
 
 
     /**
@@ -155,15 +170,15 @@ public:
      * @param element Element to be inserted
      * @return
      */
-    iterator insert( Key element ) {
-        return iterator( table_.insert(element, element) );
+    iterator insert( Key const& element ) {
+        return iterator( table_.insert(element, true) );
     }
 
     /**
      * @brief Removes specified element from set
      * @param element Element to be removed
      */
-    void remove( Key element ) {
+    void remove( Key const& element ) {
         return table_.erase(element);
     }
 
@@ -174,7 +189,7 @@ public:
      *
      * If no element is found then this will return `end()`.
      */
-    iterator find( Key element ) {
+    iterator find( Key const& element ) {
         return iterator( table_.find(element) );
     }
 
@@ -183,7 +198,7 @@ public:
      * @param element Element to find
      * @return Const iterator to found element
      */
-    const_iterator find( Key element ) const {
+    const_iterator find( Key const& element ) const {
         return const_iterator( table_.find(element) );
     }
 
@@ -192,7 +207,7 @@ public:
      * @param element Element in question
      * @return True if element is in set, else false
      */
-    bool contains( Key element ) {
+    bool contains( Key const& element ) const {
         return table_.contains_key(element);
     }
 
@@ -221,7 +236,7 @@ public:
      * @return intersection of both sets
      */
     self_type Intersection( self_type const& S ) {
-        self_type result(this->bucket_count());
+        self_type result(this->bucket_count(), table_.get_allocator());
         for (const_iterator it = S.cbegin(); it != S.cend(); it++)
             if (this->contains(*it))
                 result.insert(*it);
@@ -290,7 +305,7 @@ public:
      * @return Number of elements in set
      */
     size_t count() const {
-        table_.count();
+        return table_.count();
     }
 
     /**
@@ -305,7 +320,7 @@ public:
      * @brief Returns true if the set is empty, false otherwise
      * @return True if the set is empty, else false
      */
-    bool empty() {
+    bool empty() const {
         return count() == 0;
     }
 
@@ -315,18 +330,24 @@ public:
      * @return Reference to new set
      */
     self_type& operator=(const self_type& rhs) {
-        bucket_count_ = rhs.bucket_count_;
         table_ = rhs.table_;
         return *this;
     }
 
+    /**
+     * @brief Overloaded move operator
+     * @param rhs Set to be moved, left empty
+     * @return Reference to this set
+     */
+    self_type& operator=(self_type&& rhs) {
+        table_ = std::move(rhs.table_);
+        return *this;
+    }
+
     // VARIABLES
 private:
-    /// Number of buckets that the set uses to store the elements
-    size_t bucket_count_;
-
-    /// Internal hashtable of the set
-    hashtable<Key, Key&, Hasher, KeyEqual> table_;
+    /// Internal hashtable of the set, only its keys are used
+    table_type table_;
 };
 
 #endif //MYREGEX_SET_H
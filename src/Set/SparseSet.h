@@ -0,0 +1,153 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file SparseSet.h
+ * # Details
+ * Author: Carlos Brito (carlos.brito524@gmail.com)
+ * Date: 10/14/26.
+ *
+ * @brief This header file contains the class declarations and definitions for SparseSet.
+ *
+ * # TODO
+ * Nothing for the moment.
+ *
+ */
+//</editor-fold>
+
+#ifndef MYREGEX_SPARSESET_H
+#define MYREGEX_SPARSESET_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/** @class SparseSet
+* # Description
+* A set of integers in the range \f$ [0, n) \f$ where \f$ n \f$ is fixed on construction, as described in:
+*
+* - Briggs and Torczon, An Efficient Representation for Sparse Sets (1993)
+*
+* The elements are kept in insertion order in a dense array, and a sparse array maps every possible
+* element to its position in the dense one. An element is in the set if its position is valid and the
+* dense array points back to it, so the set can be cleared without touching either array. All of the
+* following are \f$ O(1) \f$ and never allocate memory:
+*
+* - insert
+* - contains
+* - clear
+*
+* Iteration runs over the dense array, so it is \f$ O(m) \f$ where \f$ m \f$ is the number of elements.
+*/
+class SparseSet {
+public:
+    typedef uint32_t value_type;
+    typedef std::vector<value_type>::const_iterator const_iterator;
+
+    SparseSet()
+            : size_(0)
+    {}
+
+    /// Constructs an empty set which may hold the integers in \f$ [0, capacity) \f$
+    explicit SparseSet(size_t capacity)
+            : dense_(capacity, 0),
+              sparse_(capacity, 0),
+              size_(0)
+    {}
+
+    /**
+     * @brief Inserts element into set. Has no effect if it's already in the set.
+     * @param element Element to be inserted, must be less than `capacity()`
+     * @return `true` if the element was inserted, `false` if it was already in the set
+     */
+    bool insert(value_type element) {
+        if (contains(element))
+            return false;
+
+        dense_[size_] = element;
+        sparse_[element] = static_cast<value_type>(size_);
+        size_++;
+        return true;
+    }
+
+    /**
+     * @brief Returns true if element is contained in set, false otherwise
+     * @param element Element in question, must be less than `capacity()`
+     * @return True if element is in set, else false
+     */
+    bool contains(value_type element) const {
+        value_type index = sparse_[element];
+        return index < size_ && dense_[index] == element;
+    }
+
+    /// Removes every element from the set
+    void clear() {
+        size_ = 0;
+    }
+
+    /// Returns the element at the given position in insertion order
+    value_type operator[](size_t index) const {
+        return dense_[index];
+    }
+
+    /// Returns a const iterator to the first inserted element
+    const_iterator cbegin() const {
+        return dense_.begin();
+    }
+
+    /// Returns a const iterator past the last inserted element
+    const_iterator cend() const {
+        return dense_.begin() + size_;
+    }
+
+    /// Returns the number of elements in the set
+    size_t count() const {
+        return size_;
+    }
+
+    /// Returns true if the set is empty, false otherwise
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    /// Returns the number of integers the set can hold
+    size_t capacity() const {
+        return dense_.size();
+    }
+
+    /// Swaps the contents of two sets in \f$ O(1) \f$
+    void swap(SparseSet &rhs) {
+        dense_.swap(rhs.dense_);
+        sparse_.swap(rhs.sparse_);
+        std::swap(size_, rhs.size_);
+    }
+
+private:
+    /// Elements in insertion order
+    std::vector<value_type> dense_;
+
+    /// Position of each element in dense_
+    std::vector<value_type> sparse_;
+
+    /// Number of elements
+    size_t size_;
+};
+
+#endif //MYREGEX_SPARSESET_H
@@ -0,0 +1,206 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file StateBitset.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Implementation file for the class StateBitset
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#include <algorithm>
+#include <utility>
+
+#include "StateBitset.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MYREGEX_X86_SIMD 1
+#include <immintrin.h>
+#define MYREGEX_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace {
+    typedef StateBitset::word_type word_type;
+
+    /// Words of a block, the operations below work on whole blocks
+    const size_t block_words = StateBitset::block_bits / StateBitset::word_bits;
+
+    void orScalar(word_type* dst, word_type const* src, size_t n) {
+        for (size_t i = 0; i < n; i++)
+            dst[i] |= src[i];
+    }
+
+    void andScalar(word_type* dst, word_type const* a, word_type const* b, size_t n) {
+        for (size_t i = 0; i < n; i++)
+            dst[i] = a[i] & b[i];
+    }
+
+    bool testScalar(word_type const* a, word_type const* b, size_t n) {
+        for (size_t i = 0; i < n; i++)
+            if (a[i] & b[i])
+                return true;
+        return false;
+    }
+
+    bool anyScalar(word_type const* a, size_t n) {
+        for (size_t i = 0; i < n; i++)
+            if (a[i])
+                return true;
+        return false;
+    }
+
+#ifdef MYREGEX_X86_SIMD
+    MYREGEX_TARGET("avx2")
+    void orAVX2(word_type* dst, word_type const* src, size_t n) {
+        for (size_t i = 0; i < n; i += block_words)
+        {
+            __m256i* d = reinterpret_cast<__m256i*>(dst + i);
+            __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            _mm256_storeu_si256(d, _mm256_or_si256(_mm256_loadu_si256(d), s));
+        }
+    }
+
+    MYREGEX_TARGET("avx2")
+    void andAVX2(word_type* dst, word_type const* a, word_type const* b, size_t n) {
+        for (size_t i = 0; i < n; i += block_words)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_and_si256(x, y));
+        }
+    }
+
+    MYREGEX_TARGET("avx2")
+    bool testAVX2(word_type const* a, word_type const* b, size_t n) {
+        for (size_t i = 0; i < n; i += block_words)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            if (!_mm256_testz_si256(x, y))
+                return true;
+        }
+        return false;
+    }
+
+    MYREGEX_TARGET("avx2")
+    bool anyAVX2(word_type const* a, size_t n) {
+        for (size_t i = 0; i < n; i += block_words)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            if (!_mm256_testz_si256(x, x))
+                return true;
+        }
+        return false;
+    }
+#else
+    void orAVX2(word_type* dst, word_type const* src, size_t n) {
+        orScalar(dst, src, n);
+    }
+
+    void andAVX2(word_type* dst, word_type const* a, word_type const* b, size_t n) {
+        andScalar(dst, a, b, n);
+    }
+
+    bool testAVX2(word_type const* a, word_type const* b, size_t n) {
+        return testScalar(a, b, n);
+    }
+
+    bool anyAVX2(word_type const* a, size_t n) {
+        return anyScalar(a, n);
+    }
+#endif
+}
+
+const size_t StateBitset::block_bits;
+const size_t StateBitset::word_bits;
+
+StateBitset::StateBitset()
+        : method_(METHOD_SCALAR)
+{}
+
+StateBitset::StateBitset(size_t capacity)
+        : words_((capacity + block_bits - 1) / block_bits * block_words, 0),
+          method_(METHOD_SCALAR)
+{
+#ifdef MYREGEX_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        method_ = METHOD_AVX2;
+#endif
+}
+
+void StateBitset::clear() {
+    std::fill(words_.begin(), words_.end(), 0);
+}
+
+bool StateBitset::empty() const {
+    if (method_ == METHOD_AVX2)
+        return !anyAVX2(words_.data(), words_.size());
+    return !anyScalar(words_.data(), words_.size());
+}
+
+void StateBitset::unite(StateBitset const &rhs) {
+    unite(rhs.data());
+}
+
+void StateBitset::unite(word_type const *rhs) {
+    if (method_ == METHOD_AVX2)
+        orAVX2(words_.data(), rhs, words_.size());
+    else
+        orScalar(words_.data(), rhs, words_.size());
+}
+
+void StateBitset::intersect(StateBitset const &rhs) {
+    assign_intersection(*this, rhs);
+}
+
+void StateBitset::assign_intersection(StateBitset const &a, StateBitset const &b) {
+    assign_intersection(a, b.data());
+}
+
+void StateBitset::assign_intersection(StateBitset const &a, word_type const *b) {
+    if (method_ == METHOD_AVX2)
+        andAVX2(words_.data(), a.data(), b, words_.size());
+    else
+        andScalar(words_.data(), a.data(), b, words_.size());
+}
+
+bool StateBitset::intersects(StateBitset const &rhs) const {
+    if (method_ == METHOD_AVX2)
+        return testAVX2(words_.data(), rhs.data(), words_.size());
+    return testScalar(words_.data(), rhs.data(), words_.size());
+}
+
+size_t StateBitset::count() const {
+    size_t result = 0;
+    for (size_t i = 0; i < words_.size(); i++)
+        result += bit_count(words_[i]);
+    return result;
+}
+
+void StateBitset::swap(StateBitset &rhs) {
+    words_.swap(rhs.words_);
+    std::swap(method_, rhs.method_);
+}
@@ -0,0 +1,164 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file StateBitset.h
+ * # Details
+ * Author: Carlos Brito (carlos.brito524@gmail.com)
+ * Date: 10/14/26.
+ *
+ * @brief This header file contains the class declarations for StateBitset.
+ *
+ * # TODO
+ * Nothing for the moment.
+ *
+ */
+//</editor-fold>
+
+#ifndef MYREGEX_STATEBITSET_H
+#define MYREGEX_STATEBITSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** @class StateBitset
+* # Description
+* A set of integers in the range \f$ [0, n) \f$ where \f$ n \f$ is fixed on construction, kept as one bit per
+* integer. It is meant for the sets of states of small automata, where a whole set fits in a few machine words:
+*
+* - insert, contains - \f$ O(1) \f$
+* - unite, intersect, intersects, empty, clear - \f$ O(n / w) \f$ where \f$ w \f$ is the width of a word
+*
+* The number of bits is rounded up to a multiple of `block_bits`, so the word operations have no tail to
+* handle. They use AVX2 when the processor supports it, with 256 bits per instruction, and 64 bit words
+* otherwise.
+*
+* Every set taking part in an operation must have the same capacity.
+*/
+class StateBitset {
+public:
+    typedef uint64_t word_type;
+
+    /// Number of bits the capacity is rounded up to a multiple of
+    static const size_t block_bits = 256;
+
+    /// Number of bits of a word
+    static const size_t word_bits = 64;
+
+    StateBitset();
+
+    /// Constructs an empty set which may hold the integers in \f$ [0, capacity) \f$
+    explicit StateBitset(size_t capacity);
+
+    /// Inserts element into set. It must be less than `capacity()`
+    void insert(size_t element) {
+        words_[element / word_bits] |= word_type(1) << (element % word_bits);
+    }
+
+    /// Returns true if element is contained in set. It must be less than `capacity()`
+    bool contains(size_t element) const {
+        return (words_[element / word_bits] >> (element % word_bits)) & 1;
+    }
+
+    /// Removes every element from the set
+    void clear();
+
+    /// Returns true if the set is empty, false otherwise
+    bool empty() const;
+
+    /// Adds every element of another set
+    void unite(StateBitset const& rhs);
+
+    /// Adds every element of a set given by its words, see data(). It must have `word_count()` words.
+    void unite(word_type const* rhs);
+
+    /// Removes every element which isn't in another set
+    void intersect(StateBitset const& rhs);
+
+    /// Sets the set to the intersection of two sets, in one pass
+    void assign_intersection(StateBitset const& a, StateBitset const& b);
+
+    /// Sets the set to the intersection of a set and a set given by its words. See unite().
+    void assign_intersection(StateBitset const& a, word_type const* b);
+
+    /// Returns true if the set has an element in common with another set
+    bool intersects(StateBitset const& rhs) const;
+
+    /// Returns the number of elements in the set
+    size_t count() const;
+
+    /// Returns the number of integers the set can hold, a multiple of `block_bits`
+    size_t capacity() const {
+        return words_.size() * word_bits;
+    }
+
+    /// Returns the number of words of the set
+    size_t word_count() const {
+        return words_.size();
+    }
+
+    /// Returns the words of the set. Bit \f$ i \bmod 64 \f$ of word \f$ i / 64 \f$ is set if \f$ i \f$ is in the set.
+    word_type const* data() const {
+        return words_.data();
+    }
+
+    /// Swaps the contents of two sets in \f$ O(1) \f$
+    void swap(StateBitset &rhs);
+
+    /// Returns the index of the lowest bit set in a word, which must not be 0
+    static size_t lowest_bit(word_type word) {
+#if defined(__GNUC__)
+        return static_cast<size_t>(__builtin_ctzll(word));
+#else
+        size_t bit = 0;
+        for (; !(word & 1); word >>= 1)
+            bit++;
+        return bit;
+#endif
+    }
+
+    /// Returns the number of bits set in a word
+    static size_t bit_count(word_type word) {
+#if defined(__GNUC__)
+        return static_cast<size_t>(__builtin_popcountll(word));
+#else
+        size_t count = 0;
+        for (; word != 0; word &= word - 1)
+            count++;
+        return count;
+#endif
+    }
+
+private:
+    /// Word operations
+    enum Method {
+        METHOD_SCALAR,
+        METHOD_AVX2
+    };
+
+    /// One bit per integer
+    std::vector<word_type> words_;
+
+    /// Word operations used
+    Method method_;
+};
+
+#endif //MYREGEX_STATEBITSET_H
@@ -0,0 +1,170 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file ThreadPool.cpp
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26
+ *
+ * # Description
+ * This is the .cpp file which contains the implementation for all the methods declared in the header file ThreadPool.h
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(size_t thread_count)
+        : fn_(nullptr),
+          generation_(0),
+          active_(0),
+          stop_(false)
+{
+    if (thread_count == 0)
+        thread_count = std::thread::hardware_concurrency();
+    if (thread_count == 0)
+        thread_count = 1;
+
+    for (size_t i = 0; i < thread_count; i++)
+        queues_.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+
+    for (size_t i = 0; i < thread_count; i++)
+        threads_.push_back(std::thread(&ThreadPool::run, this, i));
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+
+    for (size_t i = 0; i < threads_.size(); i++)
+        threads_[i].join();
+}
+
+size_t ThreadPool::thread_count() const {
+    return threads_.size();
+}
+
+void ThreadPool::parallel_for(size_t task_count, task_function const &fn) {
+    if (task_count == 0)
+        return;
+
+    std::lock_guard<std::mutex> call(callMutex_);
+
+    // the workers are all idle here, the queues can be filled before waking them up
+    for (size_t task = 0; task < task_count; task++)
+    {
+        WorkQueue &queue = *queues_[task % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(task);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    fn_ = &fn;
+    error_ = std::exception_ptr();
+    active_ = threads_.size();
+    generation_++;
+    wake_.notify_all();
+
+    while (active_ > 0)
+        done_.wait(lock);
+
+    fn_ = nullptr;
+    if (error_)
+    {
+        std::exception_ptr error = error_;
+        error_ = std::exception_ptr();
+        std::rethrow_exception(error);
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::run(size_t worker) {
+    size_t seen = 0;
+    for (;;)
+    {
+        task_function const* fn;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (!stop_ && generation_ == seen)
+                wake_.wait(lock);
+
+            if (stop_)
+                return;
+
+            seen = generation_;
+            fn = fn_;
+        }
+
+        size_t task;
+        while (nextTask(worker, task))
+        {
+            try
+            {
+                (*fn)(worker, task);
+            } catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_)
+                    error_ = std::current_exception();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--active_ == 0)
+            done_.notify_one();
+    }
+}
+
+bool ThreadPool::nextTask(size_t worker, size_t &task) {
+    {
+        WorkQueue &own = *queues_[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+            task = own.tasks.front();
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+
+    // steal from the back, the tasks the owner would have run last
+    for (size_t i = 1; i < queues_.size(); i++)
+    {
+        WorkQueue &victim = *queues_[(worker + i) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = victim.tasks.back();
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,131 @@
+//<editor-fold desc="Preamble">
+/*
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *  Copyright (C) 10/14/26 Carlos Brito
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ */
+//</editor-fold>
+
+//<editor-fold desc="Description">
+/**
+ * @file ThreadPool.h
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief Header file for the class ThreadPool.
+ *
+ * # TODO
+ * Nothing for the moment.
+ */
+//</editor-fold>
+
+#ifndef MYREGEX_THREADPOOL_H
+#define MYREGEX_THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** @class ThreadPool
+ * @author Carlos Brito (carlos.brito524@gmail.com)
+ * @date 10/14/26.
+ *
+ * @brief A fixed set of worker threads which run loops in parallel with work stealing
+ *
+ * # Description
+ * The threads are started once, on construction, and wait for work. parallel_for() deals its tasks out
+ * round robin to per-worker queues. A worker takes tasks from the front of its own queue and, once it is
+ * empty, steals tasks from the back of the queue of the other workers, so a worker which got slow tasks
+ * does not hold up the whole loop.
+ *
+ * parallel_for() may be called from any number of threads at once: the loops take turns, each one
+ * waiting until the previous one is done. A task must not call parallel_for() on its own pool.
+ */
+class ThreadPool {
+public:
+    /// Function run for each task. Takes the index of the worker running it and the index of the task.
+    typedef std::function<void(size_t, size_t)> task_function;
+
+    /**
+     * @brief Starts the worker threads
+     * @param thread_count Number of threads, 0 stands for one per hardware thread
+     */
+    explicit ThreadPool(size_t thread_count = 0);
+
+    /// Stops and joins the worker threads
+    ~ThreadPool();
+
+    /// Returns the number of worker threads. Worker indices are in \f$ [0, thread\_count()) \f$.
+    size_t thread_count() const;
+
+    /**
+     * @brief Runs `fn(worker, task)` for every task in \f$ [0, task\_count) \f$ and waits until all are done
+     *
+     * If a task throws, the loop still runs to completion and the first exception is rethrown here.
+     *
+     * @param task_count Number of tasks
+     * @param fn Function to run for each task
+     */
+    void parallel_for(size_t task_count, task_function const& fn);
+
+    /// Returns a pool shared by the whole process, with one thread per hardware thread
+    static ThreadPool& shared();
+
+private:
+    ThreadPool(ThreadPool const&);
+    ThreadPool& operator=(ThreadPool const&);
+
+    /// Queue of tasks of a worker
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    /// Main loop of a worker thread
+    void run(size_t worker);
+
+    /// Takes a task from the worker's own queue or steals one. Returns false if there is none left.
+    bool nextTask(size_t worker, size_t &task);
+
+    std::vector<std::thread> threads_;
+    std::vector<std::unique_ptr<WorkQueue> > queues_;
+
+    /// Held by parallel_for() for the whole loop, so concurrent callers run their loops one after the other
+    std::mutex callMutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+
+    /// Function of the running loop
+    task_function const* fn_;
+
+    /// Incremented for every loop, so workers can tell a new loop from a spurious wake up
+    size_t generation_;
+
+    /// Number of workers which haven't finished the running loop
+    size_t active_;
+
+    /// First exception thrown by a task of the running loop
+    std::exception_ptr error_;
+
+    bool stop_;
+};
+
+#endif //MYREGEX_THREADPOOL_H